@@ -0,0 +1,494 @@
+#include "concurrent_fast_linked_list.cpp"
+#include "fast_linked_list.cpp"
+#include "indexed_fast_linked_list.cpp"
+#include "unrolled_fast_linked_list.cpp"
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace utils;
+
+
+/**
+ * Returns the number of seconds elapsed since `start`.
+ *
+ * @param start time point to measure from
+ * @return seconds between `start` and now
+ */
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+
+/**
+ * Measures queue-style churn: repeatedly fills a list to `queue_length` elements from the back, then drains it from the front.
+ * Every push and pop is one node allocation or deallocation.
+ *
+ * Prints the number of push/pop operations per second.
+ *
+ * @param label name of the allocation policy being measured
+ * @param queue_length number of elements in the list at its fullest
+ * @param rounds number of fill-and-drain rounds
+ */
+template<template<typename> class NodeAllocator>
+void bench_push_pop(const char* label, int32_t queue_length, int32_t rounds) {
+    fast_linked_list<int32_t, NodeAllocator> list;
+    int64_t checksum = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int32_t r = 0; r < rounds; r++) {
+        for(int32_t i = 0; i < queue_length; i++) {
+            list.push_back(i);
+        }
+        for(int32_t i = 0; i < queue_length; i++) {
+            checksum += list.at(0, false);
+            list.pop_front();
+        }
+    }
+    double elapsed = seconds_since(start);
+
+    double n_operations = 2.0 * queue_length * rounds;
+    cout << label << ": " << (n_operations / elapsed) / 1e6 << " million push/pop per second"
+        << " (checksum " << checksum << ")" << endl;
+}
+
+
+
+/**
+ * Measures a sliding window: keeps `window_length` elements in the list, then pushes to the back and pops from the front `n_operations` times.
+ *
+ * Prints the number of push/pop pairs per second.
+ *
+ * @param label name of the allocation policy being measured
+ * @param window_length number of elements kept in the list
+ * @param n_operations number of push/pop pairs
+ */
+template<template<typename> class NodeAllocator>
+void bench_sliding_window(const char* label, int32_t window_length, int32_t n_operations) {
+    fast_linked_list<int32_t, NodeAllocator> list;
+    for(int32_t i = 0; i < window_length; i++) {
+        list.push_back(i);
+    }
+    int64_t checksum = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int32_t i = 0; i < n_operations; i++) {
+        list.push_back(i);
+        checksum += list.at(0, false);
+        list.pop_front();
+    }
+    double elapsed = seconds_since(start);
+
+    cout << label << ": " << (n_operations / elapsed) / 1e6 << " million push/pop pairs per second"
+        << " (checksum " << checksum << ")" << endl;
+}
+
+
+
+/**
+ * Total number of bytes currently allocated through `counting_allocator`
+ */
+size_t counted_bytes = 0;
+
+/**
+ * Node allocation policy that allocates like `node_new_delete`, but adds the size of every live node to `counted_bytes`.
+ *
+ * @param Node type of node to allocate memory for
+ */
+template<typename Node>
+class counting_allocator {
+public:
+    Node* allocate() {
+        counted_bytes += sizeof(Node);
+        return static_cast<Node*>(::operator new(sizeof(Node)));
+    }
+
+    void deallocate(Node* node) noexcept {
+        counted_bytes -= sizeof(Node);
+        ::operator delete(node);
+    }
+};
+
+
+
+/**
+ * Fills a list with `n_elements` chars, then prints the node memory used per element,
+ * and the average time taken to read a random element with `at`.
+ *
+ * @param label name of the list layout being measured
+ * @param n_elements number of elements to put in the list
+ * @param n_reads number of random reads
+ */
+template<typename List>
+void bench_layout(const char* label, int32_t n_elements, int32_t n_reads) {
+    counted_bytes = 0;
+    List list;
+    for(int32_t i = 0; i < n_elements; i++) {
+        list.push_back((char)i);
+    }
+    double bytes_per_element = (double)counted_bytes / n_elements;
+
+    //simple linear congruential generator, so both layouts read the same indices
+    uint32_t random_state = 12345;
+    int64_t checksum = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int32_t i = 0; i < n_reads; i++) {
+        random_state = random_state * 1664525u + 1013904223u;
+        checksum += list.at((int32_t)(random_state % (uint32_t)n_elements));
+    }
+    double elapsed = seconds_since(start);
+
+    cout << label << ": " << bytes_per_element << " node bytes per element, "
+        << (elapsed / n_reads) * 1e6 << " microseconds per random at()"
+        << " (checksum " << checksum << ")" << endl;
+}
+
+
+
+/**
+ * Fills a list with `n_elements` integers, then prints the average time of `at` when reading every index in order,
+ * and when reading `n_random_reads` random indices.
+ *
+ * @param label name of the list being measured
+ * @param n_elements number of elements to put in the list
+ * @param n_random_reads number of random reads
+ */
+template<typename List>
+void bench_random_access(const char* label, int32_t n_elements, int32_t n_random_reads) {
+    List list;
+    for(int32_t i = 0; i < n_elements; i++) {
+        list.push_back(i);
+    }
+    int64_t checksum = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int32_t i = 0; i < n_elements; i++) {
+        checksum += list.at(i);
+    }
+    double sequential_elapsed = seconds_since(start);
+
+    uint32_t random_state = 12345;
+    start = chrono::steady_clock::now();
+    for(int32_t i = 0; i < n_random_reads; i++) {
+        random_state = random_state * 1664525u + 1013904223u;
+        checksum += list.at((int32_t)(random_state % (uint32_t)n_elements));
+    }
+    double random_elapsed = seconds_since(start);
+
+    cout << label << ": " << (sequential_elapsed / n_elements) * 1e9 << " ns per sequential at(), "
+        << (random_elapsed / n_random_reads) * 1e9 << " ns per random at()"
+        << " (checksum " << checksum << ")" << endl;
+}
+
+
+
+/**
+ * Fills a list with `n_elements` integers, then prints the average time per read for three access patterns over the whole list:
+ * one reader moving forward from the start, two readers taking turns (one from the start, one from the middle) using `at`,
+ * and the same two readers each using their own pinned cursor.
+ *
+ * @param n_elements number of elements to put in the list
+ */
+void bench_interleaved(int32_t n_elements) {
+    fast_linked_list<int32_t> list;
+    for(int32_t i = 0; i < n_elements; i++) {
+        list.push_back(i);
+    }
+    int32_t half = n_elements / 2;
+    int64_t checksum = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int32_t i = 0; i < n_elements; i++) {
+        checksum += list.at(i);
+    }
+    double single_elapsed = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    for(int32_t i = 0; i < half; i++) {
+        checksum += list.at(i);
+        checksum += list.at(half + i);
+    }
+    double interleaved_elapsed = seconds_since(start);
+
+    int32_t first_reader = list.pin_cursor(0);
+    int32_t second_reader = list.pin_cursor(half);
+    start = chrono::steady_clock::now();
+    for(int32_t i = 0; i < half; i++) {
+        checksum += list.at_cursor(first_reader, i);
+        checksum += list.at_cursor(second_reader, half + i);
+    }
+    double pinned_elapsed = seconds_since(start);
+    list.unpin_cursor(first_reader);
+    list.unpin_cursor(second_reader);
+
+    cout << "  one reader: " << (single_elapsed / n_elements) * 1e9 << " ns per read" << endl;
+    cout << "  two interleaved readers with at(): " << (interleaved_elapsed / (2.0 * half)) * 1e9 << " ns per read" << endl;
+    cout << "  two interleaved readers with pinned cursors: " << (pinned_elapsed / (2.0 * half)) * 1e9 << " ns per read"
+        << " (checksum " << checksum << ")" << endl;
+}
+
+
+
+/**
+ * Fills a list with `n_elements` integers, then prints the average time per element of a full traversal
+ * using an `at` loop, a range-for loop, and reverse iterators.
+ *
+ * @param n_elements number of elements to put in the list
+ */
+void bench_traversal(int32_t n_elements) {
+    fast_linked_list<int32_t> list;
+    for(int32_t i = 0; i < n_elements; i++) {
+        list.push_back(i);
+    }
+    int64_t checksum = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int32_t i = 0; i < list.size(); i++) {
+        checksum += list.at(i);
+    }
+    double at_elapsed = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    for(int32_t value : list) {
+        checksum += value;
+    }
+    double iterator_elapsed = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    for(fast_linked_list<int32_t>::reverse_iterator it = list.rbegin(); it != list.rend(); ++it) {
+        checksum += *it;
+    }
+    double reverse_elapsed = seconds_since(start);
+
+    cout << "  at() loop: " << (at_elapsed / n_elements) * 1e9 << " ns per element" << endl;
+    cout << "  range-for: " << (iterator_elapsed / n_elements) * 1e9 << " ns per element" << endl;
+    cout << "  reverse iterators: " << (reverse_elapsed / n_elements) * 1e9 << " ns per element"
+        << " (checksum " << checksum << ")" << endl;
+}
+
+
+
+/**
+ * Builds `n_lists` lists of `list_length` integers, then concatenates them into one list, either by popping and pushing
+ * every element or with `splice_back`. Prints the time per concatenated list for both.
+ *
+ * @param label name of the allocation policy being measured
+ * @param n_lists number of lists to concatenate
+ * @param list_length number of elements in each list
+ */
+template<template<typename> class NodeAllocator>
+void bench_concatenate(const char* label, int32_t n_lists, int32_t list_length) {
+    typedef fast_linked_list<int32_t, NodeAllocator> List;
+    int64_t checksum = 0;
+
+    vector<List> parts(n_lists);
+    for(int32_t p = 0; p < n_lists; p++) {
+        for(int32_t i = 0; i < list_length; i++) {
+            parts[p].push_back(i);
+        }
+    }
+    List merged;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int32_t p = 0; p < n_lists; p++) {
+        while(parts[p].size() > 0) {
+            merged.push_back(parts[p].at(0, false));
+            parts[p].pop_front();
+        }
+    }
+    double push_pop_elapsed = seconds_since(start);
+    checksum += merged.size();
+
+    for(int32_t p = 0; p < n_lists; p++) {
+        for(int32_t i = 0; i < list_length; i++) {
+            parts[p].push_back(i);
+        }
+    }
+    List spliced;
+    start = chrono::steady_clock::now();
+    for(int32_t p = 0; p < n_lists; p++) {
+        spliced.splice_back(parts[p]);
+    }
+    double splice_elapsed = seconds_since(start);
+    checksum += spliced.size();
+
+    cout << label << ": " << (push_pop_elapsed / n_lists) * 1e6 << " microseconds per list with push/pop, "
+        << (splice_elapsed / n_lists) * 1e6 << " microseconds per list with splice_back"
+        << " (checksum " << checksum << ")" << endl;
+}
+
+
+
+/**
+ * Loads `n_elements` integers from a vector into a new list, by calling `push_back` for each element
+ * and with the vector constructor. Prints the fastest of `rounds` loads for both, not counting destruction.
+ *
+ * @param label name of the allocation policy being measured
+ * @param n_elements number of elements to load
+ * @param rounds number of times to load each way
+ */
+template<template<typename> class NodeAllocator>
+void bench_bulk_load(const char* label, int32_t n_elements, int32_t rounds) {
+    vector<int32_t> values(n_elements);
+    for(int32_t i = 0; i < n_elements; i++) {
+        values[i] = i;
+    }
+    int64_t checksum = 0;
+    double push_elapsed = 0;
+    double bulk_elapsed = 0;
+
+    for(int32_t r = 0; r < rounds; r++) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        fast_linked_list<int32_t, NodeAllocator>* pushed = new fast_linked_list<int32_t, NodeAllocator>();
+        for(int32_t i = 0; i < n_elements; i++) {
+            pushed->push_back(values[i]);
+        }
+        double elapsed = seconds_since(start);
+        push_elapsed = (r == 0 || elapsed < push_elapsed) ? elapsed : push_elapsed;
+        checksum += pushed->last_accessed_index();
+        delete pushed;
+
+        start = chrono::steady_clock::now();
+        fast_linked_list<int32_t, NodeAllocator>* loaded = new fast_linked_list<int32_t, NodeAllocator>(values);
+        elapsed = seconds_since(start);
+        bulk_elapsed = (r == 0 || elapsed < bulk_elapsed) ? elapsed : bulk_elapsed;
+        checksum += loaded->last_accessed_index();
+        delete loaded;
+    }
+
+    cout << label << ": " << push_elapsed * 1e3 << " ms with push_back, "
+        << bulk_elapsed * 1e3 << " ms with the vector constructor"
+        << " (checksum " << checksum << ")" << endl;
+}
+
+
+
+/**
+ * Runs `n_threads` threads that each add and remove `n_operations` elements at one end of a shared list,
+ * with even-numbered threads at the back and odd-numbered threads at the front.
+ * The list starts with 1000 elements, so it never gets small enough for the ends to block each other.
+ *
+ * Compares `concurrent_fast_linked_list` with a `fast_linked_list` guarded by one `std::mutex`,
+ * printing the total number of push/pop pairs per second for both.
+ *
+ * @param n_threads number of threads sharing the list
+ * @param n_operations number of push/pop pairs done by each thread
+ */
+void bench_concurrent(int32_t n_threads, int32_t n_operations) {
+    concurrent_fast_linked_list<int32_t> concurrent_list;
+    fast_linked_list<int32_t> locked_list;
+    mutex list_mutex;
+    for(int32_t i = 0; i < 1000; i++) {
+        concurrent_list.push_back(i);
+        locked_list.push_back(i);
+    }
+    vector<thread> threads;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int32_t t = 0; t < n_threads; t++) {
+        threads.push_back(thread([&concurrent_list, t, n_operations]() {
+            int32_t value;
+            for(int32_t i = 0; i < n_operations; i++) {
+                if(t % 2 == 0) {
+                    concurrent_list.push_back(i);
+                    concurrent_list.try_pop_back(value);
+                }
+                else {
+                    concurrent_list.push_front(i);
+                    concurrent_list.try_pop_front(value);
+                }
+            }
+        }));
+    }
+    for(int32_t t = 0; t < n_threads; t++) {
+        threads[t].join();
+    }
+    double concurrent_elapsed = seconds_since(start);
+    threads.clear();
+
+    start = chrono::steady_clock::now();
+    for(int32_t t = 0; t < n_threads; t++) {
+        threads.push_back(thread([&locked_list, &list_mutex, t, n_operations]() {
+            for(int32_t i = 0; i < n_operations; i++) {
+                if(t % 2 == 0) {
+                    {
+                        lock_guard<mutex> lock(list_mutex);
+                        locked_list.push_back(i);
+                    }
+                    lock_guard<mutex> lock(list_mutex);
+                    locked_list.pop_back();
+                }
+                else {
+                    {
+                        lock_guard<mutex> lock(list_mutex);
+                        locked_list.push_front(i);
+                    }
+                    lock_guard<mutex> lock(list_mutex);
+                    locked_list.pop_front();
+                }
+            }
+        }));
+    }
+    for(int32_t t = 0; t < n_threads; t++) {
+        threads[t].join();
+    }
+    double locked_elapsed = seconds_since(start);
+
+    double n_pairs = (double)n_threads * n_operations;
+    cout << "  " << n_threads << " threads: " << (n_pairs / concurrent_elapsed) / 1e6 << " million pairs per second concurrent, "
+        << (n_pairs / locked_elapsed) / 1e6 << " million with one mutex"
+        << " (sizes " << concurrent_list.size() << " " << locked_list.size() << ")" << endl;
+}
+
+
+
+int main() {
+    cout << "Fill and drain, 1M elements x 10 rounds" << endl;
+    bench_push_pop<node_new_delete>("  node_new_delete", 1000000, 10);
+    bench_push_pop<node_pool>("  node_pool", 1000000, 10);
+
+    cout << "Sliding window of 1000 elements, 20M push/pop pairs" << endl;
+    bench_sliding_window<node_new_delete>("  node_new_delete", 1000, 20000000);
+    bench_sliding_window<node_pool>("  node_pool", 1000, 20000000);
+
+    cout << "fast_linked_list<char> vs unrolled_fast_linked_list<char>, 100K elements, 2000 random reads" << endl;
+    bench_layout<fast_linked_list<char, counting_allocator> >("  fast_linked_list", 100000, 2000);
+    bench_layout<unrolled_fast_linked_list<char, 64, counting_allocator> >("  unrolled_fast_linked_list (64 per node)", 100000, 2000);
+
+    //random reads of the normal list take O(n) time each, so it gets far fewer of them
+    cout << "Sequential vs random at(), 1K elements" << endl;
+    bench_random_access<fast_linked_list<int32_t> >("  fast_linked_list", 1000, 100000);
+    bench_random_access<indexed_fast_linked_list<int32_t> >("  indexed_fast_linked_list", 1000, 100000);
+    cout << "Sequential vs random at(), 1M elements" << endl;
+    bench_random_access<fast_linked_list<int32_t> >("  fast_linked_list", 1000000, 200);
+    bench_random_access<indexed_fast_linked_list<int32_t> >("  indexed_fast_linked_list", 1000000, 1000000);
+    cout << "Sequential vs random at(), 10M elements" << endl;
+    bench_random_access<fast_linked_list<int32_t> >("  fast_linked_list", 10000000, 20);
+    bench_random_access<indexed_fast_linked_list<int32_t> >("  indexed_fast_linked_list", 10000000, 1000000);
+
+    cout << "Interleaved readers, 1M elements" << endl;
+    bench_interleaved(1000000);
+
+    cout << "Full traversal, 1M elements" << endl;
+    bench_traversal(1000000);
+
+    cout << "Concatenating 5000 lists of 1000 elements" << endl;
+    bench_concatenate<node_new_delete>("  node_new_delete", 5000, 1000);
+    bench_concatenate<node_pool>("  node_pool", 5000, 1000);
+
+    cout << "Loading 10M elements" << endl;
+    bench_bulk_load<node_new_delete>("  node_new_delete", 10000000, 3);
+    bench_bulk_load<node_pool>("  node_pool", 10000000, 3);
+
+    cout << "Threads pushing and popping at both ends, 1M push/pop pairs per thread" << endl;
+    //at least 2 threads, so both ends are used
+    int32_t max_threads = (thread::hardware_concurrency() > 2) ? (int32_t)thread::hardware_concurrency() : 2;
+    for(int32_t n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+        bench_concurrent(n_threads, 1000000);
+    }
+}
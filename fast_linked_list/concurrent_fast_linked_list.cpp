@@ -0,0 +1,631 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "node_allocator.cpp"
+
+namespace utils {
+
+
+
+
+/**
+ * Thread-safe linked list that supports addition and removal at both the front and the back, and reading and writing by index.
+ *
+ * The front and the back each have their own lock. While the list has at least `MIN_INDEPENDENT_SIZE` elements,
+ * a thread working at the front and a thread working at the back never touch the same node, so they do not block each other.
+ * Smaller lists lock both ends for every change.
+ *
+ * Reading and writing by index locks both ends. Instead of one shared last accessed element, each thread passes in its own `cursor`,
+ * which remembers where that thread last read or wrote. Cursors are forgotten whenever any element is removed.
+ *
+ * Values are returned by copy, since another thread may remove an element right after it is read.
+ *
+ * Both ends share one node allocator behind its own small lock, held only while a node's memory is taken or given back.
+ * Nodes removed at one end are reused by additions at either end, so a list used as a queue (adding at the back, removing at the front)
+ * stops growing its allocator once it reaches its largest size.
+ *
+ * @param T datatype of the stored items
+ * @param NodeAllocator allocation policy for the list's nodes. Default: `node_pool`
+ */
+template<typename T, template<typename> class NodeAllocator = node_pool>
+class concurrent_fast_linked_list {
+
+public:
+    class cursor;
+
+private:
+    /**
+     * Connection to a predecessor (`prev`) and successor (`next`). The list's two sentinels are bare links.
+     */
+    struct Link {
+        Link* prev;
+        Link* next;
+    };
+
+    /**
+     * A node containing data (`data`) and its position key (`key`).
+     *
+     * Keys increase by 1 from each node to the next, so the index of a node is its key minus the first node's key.
+     * A node keeps its key while it is in the list, even when elements are added or removed before it.
+     */
+    struct Node : Link {
+        int64_t key;
+        T data;
+
+        template<typename... Args>
+        explicit Node(int64_t key, Args&&... args) : Link(), key(key), data(std::forward<Args>(args)...) {}
+    };
+
+    /**
+     * Minimum number of elements for the ends to be changed independently.
+     *
+     * Each end has at most one change in progress. Seen from one end, the size can be at most 1 too large (a removal in progress
+     * at the other end), so seeing 3 elements means at least 2 remain, and the two ends' changes touch different nodes.
+     */
+    static const int32_t MIN_INDEPENDENT_SIZE = 3;
+
+
+    /**
+     * Sentinel before the first node. `head.next` is the first node, or `&tail` if the list is empty.
+     */
+    Link head;
+
+    /**
+     * Sentinel after the final node. `tail.prev` is the final node, or `&head` if the list is empty.
+     */
+    Link tail;
+
+    /**
+     * Lock for the front of the list. Always locked before `back_mutex` when both are needed.
+     */
+    std::mutex front_mutex;
+
+    /**
+     * Lock for the back of the list
+     */
+    std::mutex back_mutex;
+
+    /**
+     * Number of elements in the list. Non-negative.
+     */
+    std::atomic<int32_t> n_elements;
+
+    /**
+     * Number of elements ever removed from the front. Guarded by `front_mutex`.
+     */
+    uint64_t front_removals;
+
+    /**
+     * Number of elements ever removed from the back. Guarded by `back_mutex`.
+     */
+    uint64_t back_removals;
+
+    /**
+     * Lock for `node_allocator`. Always locked last, and never held while locking anything else.
+     */
+    std::mutex allocator_mutex;
+
+    /**
+     * Source of memory for every node. Guarded by `allocator_mutex`.
+     */
+    NodeAllocator<Node> node_allocator;
+
+
+
+    /**
+     * Locks the front of the list if `at_front` is true, or else the back.
+     * Also locks the other end if the list is too small for the ends to be changed independently.
+     *
+     * Private helper method.
+     *
+     * @param at_front whether to lock the front instead of the back
+     * @param front_lock unlocked lock for `front_mutex`
+     * @param back_lock unlocked lock for `back_mutex`
+     */
+    void lock_end(bool at_front, std::unique_lock<std::mutex>& front_lock, std::unique_lock<std::mutex>& back_lock);
+
+    /**
+     * Returns the node at index `index`. Both ends must be locked, and `index` must be in range.
+     *
+     * Starts from the closest of the first node, the final node, and `position` (if it is still valid), then saves the node in `position`.
+     *
+     * Private helper method.
+     *
+     * @param index index of the node to find
+     * @param position the calling thread's cursor, or `nullptr` if it has none
+     * @return pointer to the node at `index`
+     */
+    Node* find_node(int32_t index, cursor* position);
+
+    /**
+     * Returns a pointer to a new node with key `key` and value constructed from `args`.
+     * `allocator_mutex` is only held while the memory is taken, not while the value is constructed.
+     *
+     * Private helper method.
+     *
+     * @param key key of the new node
+     * @param args arguments for the new value's constructor
+     * @return pointer to the new node
+     */
+    template<typename... Args>
+    Node* create_node(int64_t key, Args&&... args);
+
+    /**
+     * Destroys `node` and gives its memory back to the allocator.
+     * `allocator_mutex` is only held while the memory is given back, not while the value is destroyed.
+     *
+     * Private helper method.
+     *
+     * @param node node to destroy. Cannot be `nullptr`
+     */
+    void destroy_node(Node* node);
+
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+public:
+
+    /**
+     * A thread's own remembered position in one list, used to speed up reading and writing by index.
+     *
+     * Each thread should use its own cursor. A cursor must not be used by two threads at once.
+     * A new cursor has no position. A cursor only has a position in the list it was last used with,
+     * and loses it when any element is removed from that list.
+     */
+    class cursor {
+        friend class concurrent_fast_linked_list;
+
+    private:
+        const concurrent_fast_linked_list* list;
+        Node* node;
+        uint64_t front_removals;
+        uint64_t back_removals;
+
+    public:
+        /**
+         * Creates a cursor with no position.
+         */
+        cursor() : list(nullptr), node(nullptr), front_removals(0), back_removals(0) {}
+    };
+
+
+
+    /**
+     * Creates an empty Concurrent Fast Linked List.
+     */
+    concurrent_fast_linked_list() : n_elements(0) {
+        head.prev = nullptr;
+        head.next = &tail;
+        tail.prev = &head;
+        tail.next = nullptr;
+
+        front_removals = 0;
+        back_removals = 0;
+    }
+
+    concurrent_fast_linked_list(const concurrent_fast_linked_list&) = delete;
+    concurrent_fast_linked_list& operator=(const concurrent_fast_linked_list&) = delete;
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //METHOD DECLARATIONS
+
+
+    /**
+     * Adds a value constructed from `args` to the end of the list.
+     * @param args arguments for the new value's constructor
+     */
+    template<typename... Args>
+    void emplace_back(Args&&... args);
+
+    /**
+     * Adds a value constructed from `args` to the front of the list.
+     * @param args arguments for the new value's constructor
+     */
+    template<typename... Args>
+    void emplace_front(Args&&... args);
+
+    /**
+     * Adds `new_value` to the end of the list.
+     * @param new_value value to add to the end
+     */
+    void push_back(const T& new_value) {
+        emplace_back(new_value);
+    }
+
+    /**
+     * Moves `new_value` to the end of the list.
+     * @param new_value value to add to the end
+     */
+    void push_back(T&& new_value) {
+        emplace_back(std::move(new_value));
+    }
+
+    /**
+     * Adds `new_value` to the front of the list.
+     * @param new_value value to add to the front
+     */
+    void push_front(const T& new_value) {
+        emplace_front(new_value);
+    }
+
+    /**
+     * Moves `new_value` to the front of the list.
+     * @param new_value value to add to the front
+     */
+    void push_front(T&& new_value) {
+        emplace_front(std::move(new_value));
+    }
+
+    /**
+     * Removes the final element of the list, moving it into `value`.
+     *
+     * Returns `false` without changing `value` if the list is empty.
+     *
+     * @param value set to the removed element
+     * @return whether an element was removed
+     */
+    bool try_pop_back(T& value);
+
+    /**
+     * Removes the first element of the list, moving it into `value`.
+     *
+     * Returns `false` without changing `value` if the list is empty.
+     *
+     * @param value set to the removed element
+     * @return whether an element was removed
+     */
+    bool try_pop_front(T& value);
+
+    /**
+     * Returns a copy of the value at index `index` (0-based indexing).
+     *
+     * The search starts from the closest of the start, the end, and `position`. `position` is then moved to `index`.
+     *
+     * If `index` is negative or at least the list's size, throws `std::out_of_range`.
+     *
+     * @param index index to get value from
+     * @param position the calling thread's cursor
+     * @return copy of the value at the specified index
+     * @throws `std::out_of_range` if `index` is out of the list's bounds
+     */
+    T at(int32_t index, cursor& position);
+
+    /**
+     * Returns a copy of the value at index `index` (0-based indexing), searching from the closest end of the list.
+     *
+     * If `index` is negative or at least the list's size, throws `std::out_of_range`.
+     *
+     * @param index index to get value from
+     * @return copy of the value at the specified index
+     * @throws `std::out_of_range` if `index` is out of the list's bounds
+     */
+    T at(int32_t index);
+
+    /**
+     * Sets the value at index `index` (0-based indexing) to `new_value`.
+     *
+     * The search starts from the closest of the start, the end, and `position`. `position` is then moved to `index`.
+     *
+     * If `index` is negative or at least the list's size, throws `std::out_of_range`.
+     *
+     * @param index index to change in the list
+     * @param new_value value to set
+     * @param position the calling thread's cursor
+     * @throws `std::out_of_range` if `index` is out of the list's bounds
+     */
+    void set(int32_t index, T new_value, cursor& position);
+
+    /**
+     * Sets the value at index `index` (0-based indexing) to `new_value`, searching from the closest end of the list.
+     *
+     * If `index` is negative or at least the list's size, throws `std::out_of_range`.
+     *
+     * @param index index to change in the list
+     * @param new_value value to set
+     * @throws `std::out_of_range` if `index` is out of the list's bounds
+     */
+    void set(int32_t index, T new_value);
+
+    /**
+     * Returns the number of elements in the list. Other threads may change the size right after it is read.
+     *
+     * @return the number of elements in the list
+     */
+    int32_t size() const {
+        return n_elements.load();
+    }
+
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //DESTRUCTOR
+
+
+    /**
+     * Properly destroys a Concurrent Fast Linked List. No other thread may be using the list.
+     */
+    ~concurrent_fast_linked_list() {
+        Link* current = head.next;
+        while(current != &tail) {
+            Link* next = current->next;
+            destroy_node(static_cast<Node*>(current));
+            current = next;
+        }
+    }
+};
+
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+//METHOD DEFINITIONS
+
+
+template<typename T, template<typename> class NodeAllocator>
+void concurrent_fast_linked_list<T, NodeAllocator>::lock_end(bool at_front, std::unique_lock<std::mutex>& front_lock, std::unique_lock<std::mutex>& back_lock) {
+    if(at_front) {
+        front_lock.lock();
+        if(n_elements.load() < MIN_INDEPENDENT_SIZE) {
+            back_lock.lock();
+        }
+    }
+    else {
+        back_lock.lock();
+
+        //the front must be locked first, so let go of the back and lock both in order
+        if(n_elements.load() < MIN_INDEPENDENT_SIZE) {
+            back_lock.unlock();
+            front_lock.lock();
+            back_lock.lock();
+        }
+    }
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+template<typename... Args>
+typename concurrent_fast_linked_list<T, NodeAllocator>::Node* concurrent_fast_linked_list<T, NodeAllocator>::create_node(int64_t key, Args&&... args) {
+    Node* new_node;
+    {
+        std::lock_guard<std::mutex> allocator_lock(allocator_mutex);
+        new_node = node_allocator.allocate();
+    }
+
+    //construct the node in the allocated memory. If the value's constructor throws, give the memory back
+    try {
+        ::new (static_cast<void*>(new_node)) Node(key, std::forward<Args>(args)...);
+    }
+    catch(...) {
+        std::lock_guard<std::mutex> allocator_lock(allocator_mutex);
+        node_allocator.deallocate(new_node);
+        throw;
+    }
+
+    return new_node;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void concurrent_fast_linked_list<T, NodeAllocator>::destroy_node(Node* node) {
+    assert((node != nullptr && "INTERNAL ERROR- Cannot destroy a null node"));
+
+    node->~Node();
+    std::lock_guard<std::mutex> allocator_lock(allocator_mutex);
+    node_allocator.deallocate(node);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+template<typename... Args>
+void concurrent_fast_linked_list<T, NodeAllocator>::emplace_back(Args&&... args) {
+    std::unique_lock<std::mutex> front_lock(front_mutex, std::defer_lock);
+    std::unique_lock<std::mutex> back_lock(back_mutex, std::defer_lock);
+    lock_end(false, front_lock, back_lock);
+
+    Link* last = tail.prev;
+    int64_t key = (last == &head) ? 0 : static_cast<Node*>(last)->key + 1;
+    Node* new_node = create_node(key, std::forward<Args>(args)...);
+
+    new_node->prev = last;
+    new_node->next = &tail;
+    last->next = new_node;
+    tail.prev = new_node;
+
+    n_elements++;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+template<typename... Args>
+void concurrent_fast_linked_list<T, NodeAllocator>::emplace_front(Args&&... args) {
+    std::unique_lock<std::mutex> front_lock(front_mutex, std::defer_lock);
+    std::unique_lock<std::mutex> back_lock(back_mutex, std::defer_lock);
+    lock_end(true, front_lock, back_lock);
+
+    Link* first = head.next;
+    int64_t key = (first == &tail) ? 0 : static_cast<Node*>(first)->key - 1;
+    Node* new_node = create_node(key, std::forward<Args>(args)...);
+
+    new_node->prev = &head;
+    new_node->next = first;
+    first->prev = new_node;
+    head.next = new_node;
+
+    n_elements++;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+bool concurrent_fast_linked_list<T, NodeAllocator>::try_pop_back(T& value) {
+    std::unique_lock<std::mutex> front_lock(front_mutex, std::defer_lock);
+    std::unique_lock<std::mutex> back_lock(back_mutex, std::defer_lock);
+    lock_end(false, front_lock, back_lock);
+
+    if(n_elements.load() == 0) {
+        return false;
+    }
+
+    Node* delete_node = static_cast<Node*>(tail.prev);
+    value = std::move(delete_node->data);
+
+    delete_node->prev->next = &tail;
+    tail.prev = delete_node->prev;
+
+    back_removals++;
+    n_elements--;
+    destroy_node(delete_node);
+    return true;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+bool concurrent_fast_linked_list<T, NodeAllocator>::try_pop_front(T& value) {
+    std::unique_lock<std::mutex> front_lock(front_mutex, std::defer_lock);
+    std::unique_lock<std::mutex> back_lock(back_mutex, std::defer_lock);
+    lock_end(true, front_lock, back_lock);
+
+    if(n_elements.load() == 0) {
+        return false;
+    }
+
+    Node* delete_node = static_cast<Node*>(head.next);
+    value = std::move(delete_node->data);
+
+    head.next = delete_node->next;
+    delete_node->next->prev = &head;
+
+    front_removals++;
+    n_elements--;
+    destroy_node(delete_node);
+    return true;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+typename concurrent_fast_linked_list<T, NodeAllocator>::Node* concurrent_fast_linked_list<T, NodeAllocator>::find_node(int32_t index, cursor* position) {
+    int32_t size = n_elements.load();
+    assert((index >= 0 && index < size && "INTERNAL ERROR- Index out of range"));
+
+    Node* first = static_cast<Node*>(head.next);
+    int64_t target_key = first->key + index;
+
+    //Determine the start node: the closest of the first node, the final node, and the cursor (if no element was removed since it was saved)
+    Node* current = first;
+    int64_t start_distance = index;
+
+    if(size - 1 - index < start_distance) {
+        current = static_cast<Node*>(tail.prev);
+        start_distance = size - 1 - index;
+    }
+
+    if(position != nullptr && position->list == this && position->node != nullptr
+            && position->front_removals == front_removals && position->back_removals == back_removals) {
+        int64_t cursor_distance = (position->node->key > target_key) ? position->node->key - target_key : target_key - position->node->key;
+        if(cursor_distance < start_distance) {
+            current = position->node;
+        }
+    }
+
+    //Walk to the target
+    while(current->key < target_key) {
+        current = static_cast<Node*>(current->next);
+    }
+    while(current->key > target_key) {
+        current = static_cast<Node*>(current->prev);
+    }
+
+    if(position != nullptr) {
+        position->list = this;
+        position->node = current;
+        position->front_removals = front_removals;
+        position->back_removals = back_removals;
+    }
+
+    return current;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+T concurrent_fast_linked_list<T, NodeAllocator>::at(int32_t index, cursor& position) {
+    std::lock_guard<std::mutex> front_lock(front_mutex);
+    std::lock_guard<std::mutex> back_lock(back_mutex);
+
+    if(!(index >= 0 && index < n_elements.load())) {
+        throw std::out_of_range("Element retrieval index must be at least 0 and less than the list's size");
+    }
+
+    return find_node(index, &position)->data;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+T concurrent_fast_linked_list<T, NodeAllocator>::at(int32_t index) {
+    std::lock_guard<std::mutex> front_lock(front_mutex);
+    std::lock_guard<std::mutex> back_lock(back_mutex);
+
+    if(!(index >= 0 && index < n_elements.load())) {
+        throw std::out_of_range("Element retrieval index must be at least 0 and less than the list's size");
+    }
+
+    return find_node(index, nullptr)->data;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void concurrent_fast_linked_list<T, NodeAllocator>::set(int32_t index, T new_value, cursor& position) {
+    std::lock_guard<std::mutex> front_lock(front_mutex);
+    std::lock_guard<std::mutex> back_lock(back_mutex);
+
+    if(!(index >= 0 && index < n_elements.load())) {
+        throw std::out_of_range("Index must be at least 0 and less than the list's size");
+    }
+
+    find_node(index, &position)->data = std::move(new_value);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void concurrent_fast_linked_list<T, NodeAllocator>::set(int32_t index, T new_value) {
+    std::lock_guard<std::mutex> front_lock(front_mutex);
+    std::lock_guard<std::mutex> back_lock(back_mutex);
+
+    if(!(index >= 0 && index < n_elements.load())) {
+        throw std::out_of_range("Index must be at least 0 and less than the list's size");
+    }
+
+    find_node(index, nullptr)->data = std::move(new_value);
+}
+
+
+
+
+}
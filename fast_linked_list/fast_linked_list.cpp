@@ -1,7 +1,17 @@
+#pragma once
+
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <new>
 #include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "node_allocator.cpp"
 
 
 /**
@@ -31,9 +41,16 @@ namespace utils {
  * The previously used element can be changed by reading or writing to a list element that is not the first or last element.
  * If the previously accessed element is removed, the new previous element becomes the one at the start or end of the list.
  * 
+ * The list also remembers a few other recently used positions ("cursors"), so several readers moving through different parts
+ * of the list do not slow each other down. Callers can pin a cursor to keep their own position in the list.
+ * 
+ * Nodes are obtained from an allocation policy owned by the list. The default policy, `node_pool`, takes nodes from contiguous chunks
+ * and reuses the nodes of removed elements. `node_new_delete` allocates every node separately.
+ * 
  * @param T datatype of the stored items
+ * @param NodeAllocator allocation policy for the list's nodes. Default: `node_pool`
  */
-template<typename T>
+template<typename T, template<typename> class NodeAllocator = node_pool>
 class fast_linked_list {
 
 private:
@@ -43,11 +60,16 @@ private:
      * 
      * A node at the start of the list has a `nullptr` predecessor.
      * A node at the end of the list has a `nullptr` successor.
+     * 
+     * New nodes have `nullptr` neighbors, and construct their data in place from the constructor's arguments.
      */
     struct Node {
         Node* prev;
         Node* next;
         T data;
+
+        template<typename... Args>
+        explicit Node(Args&&... args) : prev(nullptr), next(nullptr), data(std::forward<Args>(args)...) {}
     };
 
 
@@ -76,17 +98,201 @@ private:
      */
     int32_t n_elements;
 
+    /**
+     * Source of memory for all nodes in the list
+     */
+    NodeAllocator<Node> node_allocator;
+
+    /**
+     * A remembered position in the list: a node (`node`) and its index (`index`).
+     * 
+     * `node` is `nullptr` if the cursor is unused.
+     * 
+     * Pinned cursors belong to a caller, and only move when the caller uses them or their element is removed.
+     * Unpinned cursors are replaced when unused for the longest time (`last_use` is smallest).
+     */
+    struct Cursor {
+        Node* node;
+        int32_t index;
+        uint32_t last_use;
+        bool pinned;
+    };
+
+    /**
+     * Number of cursors the list remembers, including pinned cursors
+     */
+    static const int32_t N_CURSORS = 8;
+
+    /**
+     * Remembered positions, also used as starting points when searching for an index
+     */
+    Cursor cursors[N_CURSORS];
+
+    /**
+     * Counter increased on each cursor use, used to find the least recently used cursor
+     */
+    uint32_t cursor_clock;
+
+
+
+    /**
+     * Returns a pointer to a new node whose value is constructed from `args`. The new node's predecessor and successor are `nullptr`.
+     * 
+     * Private helper method.
+     * 
+     * @param args arguments for the new value's constructor
+     * @return pointer to the new node
+     */
+    template<typename... Args>
+    Node* create_node(Args&&... args);
+
+    /**
+     * Destroys every node in the list, leaving the list empty. Pinned cursors stay pinned, with no position.
+     * 
+     * Private helper method.
+     */
+    void destroy_all_nodes();
+
+    /**
+     * Takes the nodes, last accessed element, and cursors of `other_list`, leaving `other_list` empty.
+     * This list must have no nodes. The node allocators are not touched.
+     * 
+     * Private helper method.
+     * 
+     * @param other_list list to take the contents of
+     */
+    void take_contents(fast_linked_list& other_list);
+
+    /**
+     * Creates a chain of new nodes holding the values from `first` up to (but not including) `last`,
+     * storing its first node in `head` and its final node in `tail`. The chain is not linked into the list.
+     * 
+     * If the iterators are at least forward iterators, the node allocator is told how many nodes are coming first.
+     * If a value's constructor throws, the nodes created so far are destroyed.
+     * 
+     * Private helper method.
+     * 
+     * @param first iterator to the first value
+     * @param last iterator after the final value
+     * @param head set to the first new node, or `nullptr` if the range is empty
+     * @param tail set to the final new node, or `nullptr` if the range is empty
+     * @param middle if not `nullptr`, set to the node at index (number of nodes / 2) in the chain. Default: `nullptr`
+     * @return number of nodes in the chain
+     */
+    template<typename InputIterator>
+    int32_t create_chain(InputIterator first, InputIterator last, Node*& head, Node*& tail, Node** middle = nullptr);
+
+    /**
+     * Tells the node allocator that the nodes for the range from `first` to `last` are about to be allocated.
+     * 
+     * Private helper method.
+     */
+    template<typename ForwardIterator>
+    void reserve_nodes(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag);
+
+    /**
+     * Does nothing, since the length of a range of input iterators is unknown until it is read.
+     * 
+     * Private helper method.
+     */
+    template<typename InputIterator>
+    void reserve_nodes(InputIterator first, InputIterator last, std::input_iterator_tag);
+
+    /**
+     * Destroys every node in the chain starting at `head` and following `next` pointers.
+     * 
+     * Private helper method.
+     * 
+     * @param head first node of the chain. May be `nullptr`
+     */
+    void destroy_chain(Node* head);
+
+    /**
+     * Links the chain of `n_inserted` nodes from `head` to `tail` into the list, so that `head` ends up at index `index`.
+     * 
+     * The last accessed element stays the same element. If the list was empty, `head` becomes the last accessed element.
+     * The element count, end pointers, and cursors are each updated once.
+     * 
+     * Private helper method.
+     * 
+     * @param index index for `head`. Must be at least 0 and at most the list's size
+     * @param head first node of the chain
+     * @param tail final node of the chain
+     * @param n_inserted number of nodes in the chain. Must be positive
+     */
+    void link_chain(int32_t index, Node* head, Node* tail, int32_t n_inserted);
+
+    /**
+     * Unlinks the nodes from index `first` up to (but not including) index `last`, returning them as a chain
+     * whose first node is returned and whose final node is stored in `tail`. The nodes are not destroyed.
+     * 
+     * If the last accessed element is unlinked, the new last accessed element is the element after the unlinked ones,
+     * or the new end of the list if there is none.
+     * The element count, end pointers, and cursors are each updated once.
+     * 
+     * Private helper method.
+     * 
+     * @param first index of the first node to unlink
+     * @param last index after the final node to unlink. Must be greater than `first`, and at most the list's size
+     * @param tail set to the final unlinked node
+     * @return the first unlinked node
+     */
+    Node* unlink_chain(int32_t first, int32_t last, Node*& tail);
+
+    /**
+     * Destroys `node` and gives its memory back to the node allocator.
+     * 
+     * Private helper method.
+     * 
+     * @param node node to destroy. Cannot be `nullptr`
+     */
+    void destroy_node(Node* node);
 
 
     /**
      * Returns a pointer to the node at list index `index`.
      * 
+     * Starts from the closest of the start, end, last accessed node, and cursors.
+     * If `remembering` is true, the position is then saved in a cursor:
+     * the unpinned cursor the search started from, or else the least recently used unpinned cursor.
+     * 
      * Private helper method.
      * 
      * @param index index to get in the list. Must be on the interval [ 0, `list.size()`-1 ]
+     * @param remembering whether to save the position in a cursor. Default: true
      * @return pointer to the index's node
      */
-    Node* get_list_position(int32_t index) const;
+    Node* get_list_position(int32_t index, bool remembering = true);
+
+    /**
+     * Updates all cursors before the `n_removed` nodes from `first_removed` to `last_removed`, starting at index `first_index`, are removed.
+     * 
+     * Unpinned cursors on a removed node are cleared. Pinned cursors on a removed node move to the node after the removed nodes,
+     * or to the node before them if there is no node after them.
+     * Cursors after the removed nodes move `n_removed` indices earlier.
+     * 
+     * Private helper method.
+     * 
+     * @param first_removed first node about to be removed. Its links must still be intact
+     * @param last_removed final node about to be removed. Its links must still be intact
+     * @param first_index index of `first_removed`
+     * @param n_removed number of nodes about to be removed. Must be positive
+     */
+    void update_cursors_for_removal(Node* first_removed, Node* last_removed, int32_t first_index, int32_t n_removed);
+
+    /**
+     * Updates all cursors for `n_inserted` new nodes added at index `first_index`, the first of which is `first_inserted`.
+     * 
+     * Cursors at or after `first_index` move `n_inserted` indices later.
+     * Pinned cursors with no position (because the list was empty) move to the first new node.
+     * 
+     * Private helper method.
+     * 
+     * @param first_inserted the first new node
+     * @param first_index index of the first new node
+     * @param n_inserted number of new nodes. Must be positive
+     */
+    void update_cursors_for_insertion(Node* first_inserted, int32_t first_index, int32_t n_inserted);
 
 
     /////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -97,6 +303,102 @@ private:
 
 public:
 
+    /**
+     * Bidirectional iterator over the elements of a Fast Linked List, from the start to the end.
+     * 
+     * Each step follows one node pointer. Iterating does not change the last accessed element or any cursors.
+     * 
+     * An iterator stays valid until its element is removed. The end iterator stays valid until the list is destroyed.
+     * 
+     * @param Value `T` for a mutable iterator, or `const T` for a constant iterator
+     */
+    template<typename Value>
+    class list_iterator {
+        friend class fast_linked_list;
+        friend class list_iterator<const T>;
+
+    private:
+        /**
+         * Node of the current element. `nullptr` for the end iterator.
+         */
+        Node* node;
+
+        /**
+         * List being iterated over, used to step back from the end iterator
+         */
+        const fast_linked_list* list;
+
+        list_iterator(Node* node, const fast_linked_list* list) : node(node), list(list) {}
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value* pointer;
+        typedef Value& reference;
+
+        /**
+         * Creates an iterator that does not belong to any list. It can only be assigned to.
+         */
+        list_iterator() : node(nullptr), list(nullptr) {}
+
+        /**
+         * Creates a copy of `other`. Also converts a mutable iterator into a constant iterator.
+         * @param other iterator to copy
+         */
+        list_iterator(const list_iterator<T>& other) : node(other.node), list(other.list) {}
+
+        reference operator*() const {
+            assert((node != nullptr && "INTERNAL ERROR- Cannot dereference the end iterator"));
+            return node->data;
+        }
+
+        pointer operator->() const {
+            assert((node != nullptr && "INTERNAL ERROR- Cannot dereference the end iterator"));
+            return &(node->data);
+        }
+
+        list_iterator& operator++() {
+            assert((node != nullptr && "INTERNAL ERROR- Cannot advance past the end iterator"));
+            node = node->next;
+            return *this;
+        }
+
+        list_iterator operator++(int) {
+            list_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        list_iterator& operator--() {
+            //stepping back from the end iterator goes to the final element
+            node = (node == nullptr) ? list->end_node : node->prev;
+            assert((node != nullptr && "INTERNAL ERROR- Cannot move before the start of the list"));
+            return *this;
+        }
+
+        list_iterator operator--(int) {
+            list_iterator old = *this;
+            --(*this);
+            return old;
+        }
+
+        friend bool operator==(const list_iterator& a, const list_iterator& b) {
+            return a.node == b.node;
+        }
+
+        friend bool operator!=(const list_iterator& a, const list_iterator& b) {
+            return a.node != b.node;
+        }
+    };
+
+    typedef list_iterator<T> iterator;
+    typedef list_iterator<const T> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+
+
     /**
      * Creates an empty Fast Linked List.
      */
@@ -107,10 +409,51 @@ public:
 
         n_elements = 0;
         last_used_index = 0;
+
+        for(int32_t c = 0; c < N_CURSORS; c++) {
+            cursors[c] = Cursor{nullptr, 0, 0, false};
+        }
+        cursor_clock = 0;
     }
 
 
 
+    /**
+     * Creates a Fast Linked List containing copies of the items from `first` up to (but not including) `last`, in order.
+     * 
+     * The nodes are created in one pass and linked as they are created, without any of `push_back`'s bookkeeping.
+     * If the iterators are at least forward iterators, the node allocator is told the number of nodes first,
+     * so `node_pool` goes straight to its largest chunks.
+     * 
+     * The last used index is set to the middle of the list (the number of items divided by 2).
+     * 
+     * @param first iterator to the first item to load the list with
+     * @param last iterator after the final item to load the list with
+     */
+    template<typename InputIterator>
+    fast_linked_list(InputIterator first, InputIterator last) : fast_linked_list() {
+        Node* head;
+        Node* tail;
+        Node* middle;
+
+        int32_t n_created = create_chain(first, last, head, tail, &middle);
+        if(n_created > 0) {
+            link_chain(0, head, tail, n_created);
+            last_used_node = middle;
+            last_used_index = n_created / 2;
+        }
+    }
+
+    /**
+     * Creates a Fast Linked List containing the items in `initial_contents` in order.
+     * 
+     * The last used index is set to `initial_contents.size() / 2`.
+     * 
+     * @param initial_contents list of items to load the list with
+     */
+    fast_linked_list(std::initializer_list<T> initial_contents)
+            : fast_linked_list(initial_contents.begin(), initial_contents.end()) {}
+
     /**
      * Creates a Fast Linked List containing the items in `initial_contents` in order.
      * 
@@ -118,17 +461,19 @@ public:
      * 
      * @param initial_contents std::vector of items to load the list with
      */
-    fast_linked_list(const std::vector<T>& initial_contents) {
-        for(int32_t i = 0; i < (int32_t)initial_contents.size(); i++) {
-            this->push_back(initial_contents[i]);
+    fast_linked_list(const std::vector<T>& initial_contents)
+            : fast_linked_list(initial_contents.begin(), initial_contents.end()) {}
 
-            if(i == initial_contents.size() / 2) {
-                last_used_index = (int32_t)initial_contents.size() / 2;
-                last_used_node = end_node;
-            }
-        }
-        n_elements = initial_contents.size();
-    }
+    /**
+     * Creates a Fast Linked List by moving the items out of `initial_contents`, in order.
+     * 
+     * The items in `initial_contents` are left in a valid but unspecified (moved-from) state.
+     * The last used index is set to `initial_contents.size() / 2`.
+     * 
+     * @param initial_contents std::vector of items to load the list with
+     */
+    fast_linked_list(std::vector<T>&& initial_contents)
+            : fast_linked_list(std::make_move_iterator(initial_contents.begin()), std::make_move_iterator(initial_contents.end())) {}
 
 
 
@@ -154,6 +499,24 @@ public:
         }
     }
 
+
+
+    /**
+     * Moves the contents of `other_list` into a new list, without copying or moving any elements.
+     * 
+     * The last accessed element and all cursors (including pinned cursors) are moved too. `other_list` is left empty.
+     * 
+     * Iterators into `other_list` stay valid and refer to elements of the new list, except for `other_list.end()`.
+     * 
+     * @param other_list list to move into this list
+     */
+    fast_linked_list(fast_linked_list&& other_list) noexcept
+            : fast_linked_list() {
+        //the nodes belong to the other list's allocator, so take the allocator with them
+        node_allocator = std::move(other_list.node_allocator);
+        take_contents(other_list);
+    }
+
     /////////////////////////////////////////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -240,7 +603,20 @@ public:
      * @param new_value value to add to the end
      * 
     */
-    void push_back(T new_value);
+    void push_back(const T& new_value);
+
+    /**
+     * Moves `new_value` to the end of the list.
+     * @param new_value value to add to the end
+     */
+    void push_back(T&& new_value);
+
+    /**
+     * Adds a value constructed in place from `args` to the end of the list.
+     * @param args arguments for the new value's constructor
+     */
+    template<typename... Args>
+    void emplace_back(Args&&... args);
 
     /**
      * Adds `new_value` to the front of the list.
@@ -250,7 +626,26 @@ public:
      * @param new_value value to add to the end
      * 
      */
-    void push_front(T new_value);
+    void push_front(const T& new_value);
+
+    /**
+     * Moves `new_value` to the front of the list.
+     * 
+     * The last accessed index will increase by 1. The last accessed value remains the same.
+     * 
+     * @param new_value value to add to the front
+     */
+    void push_front(T&& new_value);
+
+    /**
+     * Adds a value constructed in place from `args` to the front of the list.
+     * 
+     * The last accessed index will increase by 1. The last accessed value remains the same.
+     * 
+     * @param args arguments for the new value's constructor
+     */
+    template<typename... Args>
+    void emplace_front(Args&&... args);
 
     /**
      * Adds `new_value` at the index of the last accessed element.
@@ -264,7 +659,126 @@ public:
      * @param new_value value to add to the last accessed
      * @throws `std::out_of_range` if the list is empty
      */
-    void push_last_accessed(T new_value);
+    void push_last_accessed(const T& new_value);
+
+    /**
+     * Moves `new_value` to the index of the last accessed element. Otherwise the same as `push_last_accessed(const T&)`.
+     * 
+     * @param new_value value to add to the last accessed
+     * @throws `std::out_of_range` if the list is empty
+     */
+    void push_last_accessed(T&& new_value);
+
+    /**
+     * Adds a value constructed in place from `args` at the index of the last accessed element.
+     * Otherwise the same as `push_last_accessed(const T&)`.
+     * 
+     * If the list is empty, throws `std::out_of_range` without constructing a value.
+     * 
+     * @param args arguments for the new value's constructor
+     * @throws `std::out_of_range` if the list is empty
+     */
+    template<typename... Args>
+    void emplace_last_accessed(Args&&... args);
+
+    /**
+     * Adds copies of the elements from `first` up to (but not including) `last`, in order, starting at index `index`.
+     * 
+     * All elements at or after `index` will have their indices increase by the number of added elements.
+     * The last accessed element remains the same. If the list was empty, the first added element becomes the last accessed element.
+     * 
+     * If `index` is negative or greater than the list's size, throws `std::out_of_range` without adding anything.
+     * 
+     * @param index index for the first added element. Must be at least 0 and at most the list's size
+     * @param first iterator to the first element to add
+     * @param last iterator after the final element to add
+     * @throws `std::out_of_range` if `index` is out of range
+     */
+    template<typename InputIterator>
+    void insert(int32_t index, InputIterator first, InputIterator last);
+
+    /**
+     * Removes the elements from index `first` up to (but not including) index `last`.
+     * 
+     * If the last accessed element is removed, the new last accessed element becomes the element after the removed elements,
+     * or the new end of the list if the removed elements were at the end.
+     * 
+     * If the range is not inside the list, throws `std::out_of_range` without removing anything.
+     * 
+     * @param first index of the first element to remove
+     * @param last index after the final element to remove. Must be at least `first`, and at most the list's size
+     * @throws `std::out_of_range` if the range is not inside the list
+     */
+    void erase(int32_t first, int32_t last);
+
+    /**
+     * Moves all elements of `other_list` into this list, starting at index `index`, leaving `other_list` empty.
+     * 
+     * No elements are copied or moved: the nodes are relinked in O(1) time. With `node_pool`, this list's pool
+     * also takes over `other_list`'s pool, also in O(1) time.
+     * 
+     * The last accessed element remains the same. `other_list`'s pinned cursors stay pinned, with no position.
+     * 
+     * If `index` is out of range, throws `std::out_of_range`. If `other_list` is this list, throws `std::invalid_argument`.
+     * 
+     * @param index index for the first moved element. Must be at least 0 and at most the list's size
+     * @param other_list list to take the elements of
+     * @throws `std::out_of_range` if `index` is out of range
+     * @throws `std::invalid_argument` if `other_list` is this list
+     */
+    void splice(int32_t index, fast_linked_list& other_list);
+
+    /**
+     * Moves the elements of `other_list` from index `first` up to (but not including) index `last` into this list,
+     * starting at index `index`. The moved elements are removed from `other_list`.
+     * 
+     * With `node_new_delete`, the nodes are relinked without copying or moving any elements.
+     * With `node_pool`, the nodes must stay in `other_list`'s pool, so the elements are moved into new nodes instead,
+     * unless the whole of `other_list` is moved.
+     * 
+     * If either list's last accessed element is affected, it changes as in `insert` and `erase`.
+     * 
+     * If `index` or the range is out of range, throws `std::out_of_range`. If `other_list` is this list, throws `std::invalid_argument`.
+     * 
+     * @param index index for the first moved element. Must be at least 0 and at most the list's size
+     * @param other_list list to take the elements from
+     * @param first index of the first element of `other_list` to move
+     * @param last index after the final element of `other_list` to move. Must be at least `first`, and at most `other_list`'s size
+     * @throws `std::out_of_range` if `index` or the range is out of range
+     * @throws `std::invalid_argument` if `other_list` is this list
+     */
+    void splice(int32_t index, fast_linked_list& other_list, int32_t first, int32_t last);
+
+    /**
+     * Moves all elements of `other_list` to the front of this list, leaving `other_list` empty. Equivalent to `splice(0, other_list)`.
+     * 
+     * The last accessed index will increase by the number of moved elements. The last accessed value remains the same.
+     * 
+     * @param other_list list to take the elements of
+     * @throws `std::invalid_argument` if `other_list` is this list
+     */
+    void splice_front(fast_linked_list& other_list);
+
+    /**
+     * Moves all elements of `other_list` to the end of this list, leaving `other_list` empty. Equivalent to `splice(size(), other_list)`.
+     * 
+     * @param other_list list to take the elements of
+     * @throws `std::invalid_argument` if `other_list` is this list
+     */
+    void splice_back(fast_linked_list& other_list);
+
+    /**
+     * Moves all elements of `other_list` to the index of the last accessed element, leaving `other_list` empty.
+     * 
+     * The first moved element becomes the new last accessed element.
+     * 
+     * If this list is empty, throws `std::out_of_range`.
+     * 
+     * @param other_list list to take the elements of
+     * @throws `std::out_of_range` if this list is empty
+     * @throws `std::invalid_argument` if `other_list` is this list
+     */
+    void splice_last_accessed(fast_linked_list& other_list);
 
 
     /**
@@ -291,6 +805,138 @@ public:
     int32_t size(); 
 
 
+    /**
+     * Pins a new cursor at index `index`, returning the cursor's handle.
+     * 
+     * A pinned cursor keeps its position until it is moved with `at_cursor`, or until its element is removed.
+     * If its element is removed, the cursor moves to the next element, or to the new end of the list if the final element was removed.
+     * Reading through a pinned cursor does not change the last accessed element.
+     * 
+     * If `index` is out of range, throws `std::out_of_range`. If all cursors are already pinned, throws `std::length_error`.
+     * 
+     * @param index index to pin the cursor at. Must be at least 0 and less than the list's size
+     * @return handle of the new cursor
+     * @throws `std::out_of_range` if `index` is out of the list's bounds
+     * @throws `std::length_error` if no more cursors can be pinned
+     */
+    int32_t pin_cursor(int32_t index);
+
+    /**
+     * Returns a reference to the value at index `index` (0-based indexing), and moves the pinned cursor `handle` to `index`.
+     * 
+     * The last accessed element is not changed.
+     * 
+     * If `handle` is not a pinned cursor, throws `std::invalid_argument`.
+     * If `index` is negative or at least the list's size, throws `std::out_of_range`.
+     * 
+     * @param handle handle of a pinned cursor
+     * @param index index to get value from
+     * @return value at the specified index
+     * @throws `std::invalid_argument` if `handle` is not a pinned cursor
+     * @throws `std::out_of_range` if `index` is out of the list's bounds
+     */
+    T& at_cursor(int32_t handle, int32_t index);
+
+    /**
+     * Returns the index of the pinned cursor `handle`.
+     * 
+     * If `handle` is not a pinned cursor, throws `std::invalid_argument`. If the list is empty, throws `std::out_of_range`.
+     * 
+     * @param handle handle of a pinned cursor
+     * @return index of the cursor
+     * @throws `std::invalid_argument` if `handle` is not a pinned cursor
+     * @throws `std::out_of_range` if the list is empty
+     */
+    int32_t cursor_index(int32_t handle);
+
+    /**
+     * Releases the pinned cursor `handle`. The handle may be returned by a later call to `pin_cursor`.
+     * 
+     * If `handle` is not a pinned cursor, throws `std::invalid_argument`.
+     * 
+     * @param handle handle of a pinned cursor
+     * @throws `std::invalid_argument` if `handle` is not a pinned cursor
+     */
+    void unpin_cursor(int32_t handle);
+
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //ITERATORS
+
+    /**
+     * @return iterator to the first element, or `end()` if the list is empty
+     */
+    iterator begin() {
+        return iterator(start_node, this);
+    }
+
+    /**
+     * @return constant iterator to the first element, or `end()` if the list is empty
+     */
+    const_iterator begin() const {
+        return const_iterator(start_node, this);
+    }
+
+    /**
+     * @return constant iterator to the first element, or `cend()` if the list is empty
+     */
+    const_iterator cbegin() const {
+        return const_iterator(start_node, this);
+    }
+
+    /**
+     * @return iterator one past the final element
+     */
+    iterator end() {
+        return iterator(nullptr, this);
+    }
+
+    /**
+     * @return constant iterator one past the final element
+     */
+    const_iterator end() const {
+        return const_iterator(nullptr, this);
+    }
+
+    /**
+     * @return constant iterator one past the final element
+     */
+    const_iterator cend() const {
+        return const_iterator(nullptr, this);
+    }
+
+    /**
+     * @return reverse iterator to the final element, or `rend()` if the list is empty
+     */
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @return constant reverse iterator to the final element, or `rend()` if the list is empty
+     */
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    /**
+     * @return reverse iterator one before the first element
+     */
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @return constant reverse iterator one before the first element
+     */
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+
     /////////////////////////////////////////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -365,6 +1011,37 @@ public:
             this->pop_back();
         }
 
+        //the old positions are meaningless now. Pinned cursors move to the start
+        for(int32_t c = 0; c < N_CURSORS; c++) {
+            cursors[c].node = cursors[c].pinned ? start_node : nullptr;
+            cursors[c].index = 0;
+        }
+
+        return *this;
+    }
+
+
+
+    /**
+     * Moves the contents of `other_list` into this list, returning a reference to this list after the modification.
+     * 
+     * This list's old elements are destroyed. No elements of `other_list` are copied or moved.
+     * The last accessed element and all cursors (including pinned cursors) are taken from `other_list`, which is left empty.
+     * 
+     * @param other_list list to move into this list
+     * @return reference to this (modified) list
+     */
+    fast_linked_list& operator=(fast_linked_list&& other_list) noexcept {
+        //self-assignment check
+        if(this == &other_list) {
+            return *this;
+        }
+
+        //the old nodes must go back to the old allocator before it is replaced
+        destroy_all_nodes();
+        node_allocator = std::move(other_list.node_allocator);
+        take_contents(other_list);
+
         return *this;
     }
     
@@ -430,8 +1107,8 @@ public:
      * @param fll list to export
      * @return reference to `output_stream` with `fll` inside
      */
-    template<typename CharT, typename Traits, typename Tp>
-    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const fast_linked_list<Tp>& fll);
+    template<typename CharT, typename Traits, typename Tp, template<typename> class Alloc>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const fast_linked_list<Tp, Alloc>& fll);
     
 
     /////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -445,14 +1122,7 @@ public:
      * Properly destroys a Fast Linked List.
      */
     ~fast_linked_list() {
-        Node* current = start_node;
-        Node* delete_node = start_node;
-
-        while(current != nullptr) {
-            current = current->next;
-            delete delete_node;
-            delete_node = current;
-        }
+        destroy_all_nodes();
     }
 };
 
@@ -465,78 +1135,382 @@ public:
 //METHOD DEFINITIONS
 
 
-template<typename T>
-typename fast_linked_list<T>::Node* fast_linked_list<T>::get_list_position(int32_t index) const {
+template<typename T, template<typename> class NodeAllocator>
+template<typename... Args>
+typename fast_linked_list<T, NodeAllocator>::Node* fast_linked_list<T, NodeAllocator>::create_node(Args&&... args) {
+    Node* new_node = node_allocator.allocate();
+
+    //construct the node in the allocated memory. If the value's constructor throws, give the memory back
+    try {
+        ::new (static_cast<void*>(new_node)) Node(std::forward<Args>(args)...);
+    }
+    catch(...) {
+        node_allocator.deallocate(new_node);
+        throw;
+    }
+
+    return new_node;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::destroy_node(Node* node) {
+    assert((node != nullptr && "INTERNAL ERROR- Cannot destroy a null node"));
+
+    node->~Node();
+    node_allocator.deallocate(node);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::destroy_all_nodes() {
+    Node* current = start_node;
+    Node* delete_node = start_node;
+
+    while(current != nullptr) {
+        current = current->next;
+        destroy_node(delete_node);
+        delete_node = current;
+    }
+
+    start_node = nullptr;
+    end_node = nullptr;
+    last_used_node = nullptr;
+    last_used_index = 0;
+    n_elements = 0;
+
+    for(int32_t c = 0; c < N_CURSORS; c++) {
+        cursors[c].node = nullptr;
+        cursors[c].index = 0;
+    }
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+template<typename InputIterator>
+int32_t fast_linked_list<T, NodeAllocator>::create_chain(InputIterator first, InputIterator last, Node*& head, Node*& tail, Node** middle) {
+    reserve_nodes(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+
+    head = nullptr;
+    tail = nullptr;
+    int32_t n_created = 0;
+    try {
+        for(; first != last; ++first) {
+            Node* new_node = create_node(*first);
+            if(tail == nullptr) {
+                head = new_node;
+                if(middle != nullptr) {
+                    *middle = new_node;
+                }
+            }
+            else {
+                tail->next = new_node;
+                new_node->prev = tail;
+            }
+            tail = new_node;
+            n_created++;
+
+            //the middle index (n_created / 2) goes up by 1 whenever n_created becomes even
+            if(middle != nullptr && n_created % 2 == 0) {
+                *middle = (*middle)->next;
+            }
+        }
+    }
+    catch(...) {
+        destroy_chain(head);
+        throw;
+    }
+
+    return n_created;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+template<typename ForwardIterator>
+void fast_linked_list<T, NodeAllocator>::reserve_nodes(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+    node_allocator.reserve((std::size_t)std::distance(first, last));
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+template<typename InputIterator>
+void fast_linked_list<T, NodeAllocator>::reserve_nodes(InputIterator first, InputIterator last, std::input_iterator_tag) {
+    (void)first;
+    (void)last;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::destroy_chain(Node* head) {
+    while(head != nullptr) {
+        Node* delete_node = head;
+        head = head->next;
+        destroy_node(delete_node);
+    }
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::link_chain(int32_t index, Node* head, Node* tail, int32_t n_inserted) {
+    assert((index >= 0 && index <= n_elements && "INTERNAL ERROR- Chain index out of range"));
+    assert((head != nullptr && tail != nullptr && n_inserted > 0 && "INTERNAL ERROR- Cannot link an empty chain"));
+
+    //no elements: the chain becomes the list
+    if(n_elements == 0) {
+        start_node = head;
+        end_node = tail;
+        last_used_node = head;
+        last_used_index = 0;
+    }
+    //add to the front
+    else if(index == 0) {
+        tail->next = start_node;
+        start_node->prev = tail;
+        start_node = head;
+    }
+    //add to the end
+    else if(index == n_elements) {
+        end_node->next = head;
+        head->prev = end_node;
+        end_node = tail;
+    }
+    //add in the middle, in front of the node currently at `index`
+    else {
+        Node* after = get_list_position(index, false);
+        Node* before = after->prev;
+
+        before->next = head;
+        head->prev = before;
+        tail->next = after;
+        after->prev = tail;
+    }
+
+    //keep the same last accessed element
+    if(n_elements > 0 && index <= last_used_index) {
+        last_used_index += n_inserted;
+    }
+
+    update_cursors_for_insertion(head, index, n_inserted);
+    n_elements += n_inserted;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+typename fast_linked_list<T, NodeAllocator>::Node* fast_linked_list<T, NodeAllocator>::unlink_chain(int32_t first, int32_t last, Node*& tail) {
+    assert((first >= 0 && first < last && last <= n_elements && "INTERNAL ERROR- Unlinked range out of range"));
+    int32_t n_removed = last - first;
+
+    //remembering the first node lets the search for the final node start from it
+    Node* head = get_list_position(first);
+    tail = (last == n_elements) ? end_node : get_list_position(last - 1, false);
+
+    update_cursors_for_removal(head, tail, first, n_removed);
+
+    //last accessed removed: move it to the element after the range, or to the new end
+    if(last_used_index >= first && last_used_index < last) {
+        if(tail->next != nullptr) {
+            last_used_node = tail->next;
+            last_used_index = first;
+        }
+        else {
+            last_used_node = head->prev;
+            last_used_index = (first > 0) ? first - 1 : 0;
+        }
+    }
+    else if(last_used_index >= last) {
+        last_used_index -= n_removed;
+    }
+
+    //unlink the chain from its neighbors
+    if(head->prev != nullptr) {
+        head->prev->next = tail->next;
+    }
+    else {
+        start_node = tail->next;
+    }
+    if(tail->next != nullptr) {
+        tail->next->prev = head->prev;
+    }
+    else {
+        end_node = head->prev;
+    }
+    head->prev = nullptr;
+    tail->next = nullptr;
+
+    n_elements -= n_removed;
+    return head;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::take_contents(fast_linked_list& other_list) {
+    assert((start_node == nullptr && n_elements == 0 && "INTERNAL ERROR- List must be empty before taking another list's contents"));
+
+    start_node = other_list.start_node;
+    end_node = other_list.end_node;
+    last_used_node = other_list.last_used_node;
+    last_used_index = other_list.last_used_index;
+    n_elements = other_list.n_elements;
+    for(int32_t c = 0; c < N_CURSORS; c++) {
+        cursors[c] = other_list.cursors[c];
+    }
+    cursor_clock = other_list.cursor_clock;
+
+    //the other list keeps nothing, including its pinned cursors (their handles now belong to this list)
+    other_list.start_node = nullptr;
+    other_list.end_node = nullptr;
+    other_list.last_used_node = nullptr;
+    other_list.last_used_index = 0;
+    other_list.n_elements = 0;
+    for(int32_t c = 0; c < N_CURSORS; c++) {
+        other_list.cursors[c] = Cursor{nullptr, 0, 0, false};
+    }
+    other_list.cursor_clock = 0;
+}
+
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+typename fast_linked_list<T, NodeAllocator>::Node* fast_linked_list<T, NodeAllocator>::get_list_position(int32_t index, bool remembering) {
     assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
     assert((index >= 0 && index < n_elements && "INTERNAL ERROR- index is out of bounds"));
     assert((last_used_node != nullptr && "INTERNAL ERROR- Last accessed node cannot be null"));
     assert((last_used_index >= 0 && last_used_index < n_elements && "INTERNAL ERROR- Last accessed index is out of list's bounds"));
     
-    //Determine iteration direction, start node, and start index
-    bool iterating_forward = true;
+    //Determine the start node and start index: the closest of the start, end, last accessed, and cursors
     int32_t current_index = 0;
     Node* current_node = start_node;
+    int32_t start_distance = distance(index, 0);
+    int32_t start_cursor = -1;
 
-    //Past last accessed index: compare last accessed index and end
-    if(index > last_used_index) {
-        //closer to last accessed index: iterate forward starting from last accessed
-        if(distance(index, last_used_index) < distance(index, n_elements-1)) { 
-            iterating_forward = true;
-            current_index = last_used_index;
-            current_node = last_used_node;
-        }
-        //closer to end: iterate backward starting from end
-        else {
-            iterating_forward = false;
-            current_index = n_elements-1;
-            current_node = end_node;
+    if(distance(index, n_elements-1) < start_distance) {
+        current_index = n_elements-1;
+        current_node = end_node;
+        start_distance = distance(index, n_elements-1);
+    }
+    if(distance(index, last_used_index) < start_distance) {
+        current_index = last_used_index;
+        current_node = last_used_node;
+        start_distance = distance(index, last_used_index);
+    }
+    //cursors win ties, so a reader's cursor keeps moving along with the reader
+    for(int32_t c = 0; c < N_CURSORS; c++) {
+        if(cursors[c].node != nullptr && distance(index, cursors[c].index) <= start_distance) {
+            assert((cursors[c].index >= 0 && cursors[c].index < n_elements && "INTERNAL ERROR- Cursor index is out of list's bounds"));
+            current_index = cursors[c].index;
+            current_node = cursors[c].node;
+            start_distance = distance(index, cursors[c].index);
+            start_cursor = c;
         }
     }
-    //At or before last accessed: compare start and last accesed
-    else {
-        //closer to last accessed index: iterate backward starting from last accessed
-        if(distance(index, last_used_index) < distance(index, 0)) {
-            iterating_forward = false;
-            current_index = last_used_index;
-            current_node = last_used_node;
+
+    //Move through the list toward the desired index
+    while(current_index < index) {
+        current_node = current_node->next;
+        current_index++;
+    }
+    while(current_index > index) {
+        current_node = current_node->prev;
+        current_index--;
+    }
+
+    if(current_node == nullptr) {
+        //Execution should never get here
+        throw std::runtime_error("INTERNAL ERROR: Overrun");
+    }
+
+    //Remember the position: move the unpinned cursor used to get here, or replace the least recently used unpinned cursor
+    if(remembering) {
+        int32_t save_cursor = -1;
+
+        if(start_cursor >= 0 && !cursors[start_cursor].pinned) {
+            save_cursor = start_cursor;
+        }
+        else if(start_distance > 0) {
+            for(int32_t c = 0; c < N_CURSORS; c++) {
+                if(!cursors[c].pinned && (save_cursor == -1 || cursors[c].node == nullptr
+                        || (cursors[save_cursor].node != nullptr && cursors[c].last_use < cursors[save_cursor].last_use))) {
+                    save_cursor = c;
+                }
+            }
+        }
+
+        if(save_cursor >= 0) {
+            cursors[save_cursor].node = current_node;
+            cursors[save_cursor].index = index;
+            cursors[save_cursor].last_use = ++cursor_clock;
         }
-        //closer to start: iterate forward from the start (already set in initialization)
     }
 
-    // cout << "iteration forward: " << iterating_forward << endl;
-    // cout << "index: " << current_index << endl;
-    // cout << "data: " << current->data << endl;
+    return current_node;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::update_cursors_for_removal(Node* first_removed, Node* last_removed, int32_t first_index, int32_t n_removed) {
+    assert((n_removed > 0 && "INTERNAL ERROR- Must remove at least one node"));
 
-    //Move through the array toward the desired index
-    while(current_node != nullptr) {
-        //Copy the current node's contents when the correct index is reached
-        if(current_index == index) {
-            return current_node;
+    for(int32_t c = 0; c < N_CURSORS; c++) {
+        if(cursors[c].node == nullptr) {
+            continue;
         }
 
-        //Move to the next node and update the index, depending on iteration direction
-        if(iterating_forward) {
-            current_node = current_node->next;
-            current_index++;
+        //cursor on a removed node: pinned cursors move to a neighbor, unpinned cursors are cleared
+        if(cursors[c].index >= first_index && cursors[c].index < first_index + n_removed) {
+            if(!cursors[c].pinned) {
+                cursors[c].node = nullptr;
+            }
+            else if(last_removed->next != nullptr) {
+                cursors[c].node = last_removed->next;
+                cursors[c].index = first_index;
+            }
+            else {
+                cursors[c].node = first_removed->prev;
+                cursors[c].index = first_index - 1;
+            }
         }
-        else {
-            current_node = current_node->prev;
-            current_index--;
+        //cursor after the removed nodes: move earlier
+        else if(cursors[c].index >= first_index + n_removed) {
+            cursors[c].index -= n_removed;
         }
     }
+}
+
 
-    //Execution should never get here
-    if(current_index <= 0) {
-        throw std::runtime_error("INTERNAL ERROR: Underrun");
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::update_cursors_for_insertion(Node* first_inserted, int32_t first_index, int32_t n_inserted) {
+    assert((n_inserted > 0 && "INTERNAL ERROR- Must insert at least one node"));
+
+    for(int32_t c = 0; c < N_CURSORS; c++) {
+        if(cursors[c].node == nullptr) {
+            if(cursors[c].pinned) {
+                cursors[c].node = first_inserted;
+                cursors[c].index = first_index;
+            }
+        }
+        else if(cursors[c].index >= first_index) {
+            cursors[c].index += n_inserted;
+        }
     }
-    throw std::runtime_error("INTERNAL ERROR: Overrun");
 }
 
 
 
 
-template<typename T>
-T& fast_linked_list<T>::at(int32_t index, bool setting_last_accessed) {
+template<typename T, template<typename> class NodeAllocator>
+T& fast_linked_list<T, NodeAllocator>::at(int32_t index, bool setting_last_accessed) {
     //check index range
     if(!(index >= 0 && index < n_elements)) {
         throw std::out_of_range("Element retrieval index must be at least 0 and less than the array's size");
@@ -558,8 +1532,8 @@ T& fast_linked_list<T>::at(int32_t index, bool setting_last_accessed) {
 
 
 
-template<typename T>
-inline int32_t fast_linked_list<T>::last_accessed_index() {
+template<typename T, template<typename> class NodeAllocator>
+inline int32_t fast_linked_list<T, NodeAllocator>::last_accessed_index() {
     //check for empty list
     if(n_elements == 0) {
         throw std::out_of_range("Cannot access the last accessed index of an empty list");
@@ -572,8 +1546,8 @@ inline int32_t fast_linked_list<T>::last_accessed_index() {
 
 
 
-template<typename T>
-inline T& fast_linked_list<T>::last_accessed_element() {
+template<typename T, template<typename> class NodeAllocator>
+inline T& fast_linked_list<T, NodeAllocator>::last_accessed_element() {
     //check for empty list
     if(n_elements == 0) {
         throw std::out_of_range("Cannot access the last used element of an empty list");
@@ -586,17 +1560,19 @@ inline T& fast_linked_list<T>::last_accessed_element() {
 
 
 
-template<typename T>
-void fast_linked_list<T>::pop_back() {
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::pop_back() {
     assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
     if(n_elements == 0) {
         throw std::out_of_range("Cannot remove elements from the back of an empty list");
     }
 
+    update_cursors_for_removal(end_node, end_node, n_elements-1, 1);
+
     if(n_elements == 1) {
         //delete the only node
         Node* delete_node = end_node; 
-        delete delete_node;
+        destroy_node(delete_node);
         
         //set everything to nullptr
         start_node = nullptr;
@@ -606,7 +1582,7 @@ void fast_linked_list<T>::pop_back() {
     else {
         Node* delete_node = end_node; //save the last element
         end_node = end_node->prev; //move the end one element forward
-        delete delete_node; //remove the last element
+        destroy_node(delete_node); //remove the last element
         end_node->next = nullptr; //set the end to nullptr
     }
 
@@ -621,17 +1597,19 @@ void fast_linked_list<T>::pop_back() {
 
 
 
-template<typename T>
-void fast_linked_list<T>::pop_front() {
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::pop_front() {
     assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
     if(n_elements == 0) {
         throw std::out_of_range("Cannot remove elements from the front of an empty list");
     }
+
+    update_cursors_for_removal(start_node, start_node, 0, 1);
     
     if(n_elements == 1) {
         //delete the only node
         Node* delete_node = start_node;
-        delete delete_node;
+        destroy_node(delete_node);
 
         //set everything to nullptr
         start_node = nullptr;
@@ -643,7 +1621,7 @@ void fast_linked_list<T>::pop_front() {
         //make new node
         Node* delete_node = start_node;
         start_node = start_node->next;
-        delete delete_node;
+        destroy_node(delete_node);
         start_node->prev = nullptr;
     }
     
@@ -661,8 +1639,8 @@ void fast_linked_list<T>::pop_front() {
 
 
 
-template<typename T>
-void fast_linked_list<T>::pop_last_accessed() {
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::pop_last_accessed() {
 
     //assertions
     assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
@@ -672,11 +1650,14 @@ void fast_linked_list<T>::pop_last_accessed() {
     if(n_elements == 0) {
         throw std::out_of_range("Cannot remove the last accessed element of an empty list");
     }
+
+    update_cursors_for_removal(last_used_node, last_used_node, last_used_index, 1);
+
     //single element
-    else if(n_elements == 1) {
+    if(n_elements == 1) {
         //delete the only node
         Node* delete_node = start_node;
-        delete delete_node;
+        destroy_node(delete_node);
 
         //set everything to nullptr
         start_node = nullptr;
@@ -689,7 +1670,7 @@ void fast_linked_list<T>::pop_last_accessed() {
         //delete the start node
         Node* delete_node = start_node;
         start_node = start_node->next;
-        delete delete_node;
+        destroy_node(delete_node);
         start_node->prev = nullptr;
 
         //reconfigure last accessed
@@ -700,7 +1681,7 @@ void fast_linked_list<T>::pop_last_accessed() {
     else if(last_used_index == n_elements-1) {
         Node* delete_node = end_node; //save the last element
         end_node = end_node->prev; //move the end one element forward
-        delete delete_node; //remove the last element
+        destroy_node(delete_node); //remove the last element
         end_node->next = nullptr; //set the end to nullptr
 
         //reconfigure last accessed
@@ -718,22 +1699,34 @@ void fast_linked_list<T>::pop_last_accessed() {
 
         //delete the node
         last_used_node = last_used_node->next;
-        delete delete_node;
+        destroy_node(delete_node);
     }
 
     n_elements--;
 }
 
 
-template<typename T>
-void fast_linked_list<T>::push_back(T new_value) {
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::push_back(const T& new_value) {
+    emplace_back(new_value);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::push_back(T&& new_value) {
+    emplace_back(std::move(new_value));
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+template<typename... Args>
+void fast_linked_list<T, NodeAllocator>::emplace_back(Args&&... args) {
     assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
 
     //configure a new node with the desired value
-    Node* new_node = new Node(); 
-    new_node->data = new_value;
-    new_node->prev = nullptr;
-    new_node->next = nullptr;
+    Node* new_node = create_node(std::forward<Args>(args)...);
 
     //no elements in list: make the new node the only node
     if(n_elements == 0) {
@@ -741,6 +1734,8 @@ void fast_linked_list<T>::push_back(T new_value) {
         end_node = new_node;
         last_used_node = start_node;
         last_used_index = 0;
+
+        update_cursors_for_insertion(new_node, 0, 1);
     }
     //elements in list: put the new node at the end
     else {
@@ -755,15 +1750,27 @@ void fast_linked_list<T>::push_back(T new_value) {
 
 
 
-template<typename T>
-void fast_linked_list<T>::push_front(T new_value) {
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::push_front(const T& new_value) {
+    emplace_front(new_value);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::push_front(T&& new_value) {
+    emplace_front(std::move(new_value));
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+template<typename... Args>
+void fast_linked_list<T, NodeAllocator>::emplace_front(Args&&... args) {
     assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
 
     //configure a new node with the desired value
-    Node* new_node = new Node();
-    new_node->data = new_value;
-    new_node->prev = nullptr;
-    new_node->next = nullptr;
+    Node* new_node = create_node(std::forward<Args>(args)...);
 
     //no elements: set first and only node to the new node
     if(n_elements==0) {
@@ -782,13 +1789,30 @@ void fast_linked_list<T>::push_front(T new_value) {
         last_used_index++;
     }
 
+    update_cursors_for_insertion(new_node, 0, 1);
+
     n_elements++;
 }
 
 
 
-template<typename T>
-void fast_linked_list<T>::push_last_accessed(T new_value) {
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::push_last_accessed(const T& new_value) {
+    emplace_last_accessed(new_value);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::push_last_accessed(T&& new_value) {
+    emplace_last_accessed(std::move(new_value));
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+template<typename... Args>
+void fast_linked_list<T, NodeAllocator>::emplace_last_accessed(Args&&... args) {
     assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
 
     //no elements: throw exception
@@ -798,13 +1822,12 @@ void fast_linked_list<T>::push_last_accessed(T new_value) {
     assert((last_used_index>=0 && last_used_index<n_elements && "INTERNAL ERROR- Last accessed index out of range"));
 
     //configure a new node with the desired value
-    Node* new_node = new Node();
-    new_node->data = new_value;
-    new_node->prev = nullptr;
-    new_node->next = nullptr;
+    Node* new_node = create_node(std::forward<Args>(args)...);
 
     //last accessed at start: essentially push front
     if(last_used_index == 0) {
+        update_cursors_for_insertion(new_node, 0, 1);
+
         new_node->next = start_node;
         start_node->prev = new_node;
         start_node = new_node;
@@ -825,6 +1848,8 @@ void fast_linked_list<T>::push_last_accessed(T new_value) {
     }
     //last accessed in middle: add to the last accessed
     else {
+        update_cursors_for_insertion(new_node, last_used_index, 1);
+
         //configure new node
         new_node->next = last_used_node;
         new_node->prev = last_used_node->prev;
@@ -842,8 +1867,121 @@ void fast_linked_list<T>::push_last_accessed(T new_value) {
 
 
 
-template<typename T>
-void fast_linked_list<T>::set(int32_t index, T new_value, bool setting_last_accessed) {
+template<typename T, template<typename> class NodeAllocator>
+template<typename InputIterator>
+void fast_linked_list<T, NodeAllocator>::insert(int32_t index, InputIterator first, InputIterator last) {
+    if(!(index >= 0 && index <= n_elements)) {
+        throw std::out_of_range("Insertion index must be at least 0 and at most the list's size");
+    }
+
+    //Build a chain of new nodes first, so the list is only changed once
+    Node* head;
+    Node* tail;
+    int32_t n_inserted = create_chain(first, last, head, tail);
+
+    if(n_inserted > 0) {
+        link_chain(index, head, tail, n_inserted);
+    }
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::erase(int32_t first, int32_t last) {
+    if(!(first >= 0 && first <= last && last <= n_elements)) {
+        throw std::out_of_range("Erased range must satisfy 0 <= first <= last <= the list's size");
+    }
+    if(first == last) {
+        return;
+    }
+
+    Node* tail;
+    destroy_chain(unlink_chain(first, last, tail));
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::splice(int32_t index, fast_linked_list& other_list) {
+    splice(index, other_list, 0, other_list.n_elements);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::splice(int32_t index, fast_linked_list& other_list, int32_t first, int32_t last) {
+    if(this == &other_list) {
+        throw std::invalid_argument("Cannot splice a list into itself");
+    }
+    if(!(index >= 0 && index <= n_elements)) {
+        throw std::out_of_range("Splice index must be at least 0 and at most the list's size");
+    }
+    if(!(first >= 0 && first <= last && last <= other_list.n_elements)) {
+        throw std::out_of_range("Spliced range must satisfy 0 <= first <= last <= the other list's size");
+    }
+    if(first == last) {
+        return;
+    }
+
+    //Relink the nodes if this list's allocator can take responsibility for them
+    if(NodeAllocator<Node>::SHARED_NODES || (first == 0 && last == other_list.n_elements)) {
+        node_allocator.merge(other_list.node_allocator);
+
+        Node* tail;
+        Node* head = other_list.unlink_chain(first, last, tail);
+        link_chain(index, head, tail, last - first);
+    }
+    //Otherwise move the values into new nodes from this list's allocator
+    else {
+        Node* first_node = other_list.get_list_position(first, false);
+        Node* last_node = (last == other_list.n_elements) ? nullptr : other_list.get_list_position(last, false);
+
+        insert(index, std::make_move_iterator(iterator(first_node, &other_list)), std::make_move_iterator(iterator(last_node, &other_list)));
+        other_list.erase(first, last);
+    }
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::splice_front(fast_linked_list& other_list) {
+    splice(0, other_list);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::splice_back(fast_linked_list& other_list) {
+    splice(n_elements, other_list);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::splice_last_accessed(fast_linked_list& other_list) {
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot splice values in front of the last used element, in an empty list");
+    }
+    if(this == &other_list) {
+        throw std::invalid_argument("Cannot splice a list into itself");
+    }
+    if(other_list.n_elements == 0) {
+        return;
+    }
+
+    //the whole list is relinked, so its first node becomes the new last accessed node
+    int32_t index = last_used_index;
+    Node* first_spliced = other_list.start_node;
+    splice(index, other_list);
+
+    last_used_node = first_spliced;
+    last_used_index = index;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::set(int32_t index, T new_value, bool setting_last_accessed) {
     if(!(index>=0 && index<n_elements)) {
         throw std::out_of_range("Index must be at least 0 and less than the list's size");
     }
@@ -857,21 +1995,94 @@ void fast_linked_list<T>::set(int32_t index, T new_value, bool setting_last_acce
         last_used_index = index;
     }
 
-    //Update the node
-    pos->data = new_value;
+    //Update the node. `new_value` is a copy, so it can be moved from
+    pos->data = std::move(new_value);
 }
 
 
 
-template<typename T>
-inline int32_t fast_linked_list<T>::size() {
+template<typename T, template<typename> class NodeAllocator>
+inline int32_t fast_linked_list<T, NodeAllocator>::size() {
     return n_elements;
 }
 
 
 
-template<typename CharT, typename Traits, typename T>
-std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const fast_linked_list<T>& fll) {
+template<typename T, template<typename> class NodeAllocator>
+int32_t fast_linked_list<T, NodeAllocator>::pin_cursor(int32_t index) {
+    if(!(index >= 0 && index < n_elements)) {
+        throw std::out_of_range("Cursor index must be at least 0 and less than the list's size");
+    }
+
+    //Find an unpinned cursor, preferring an unused one, then the least recently used one
+    int32_t handle = -1;
+    for(int32_t c = 0; c < N_CURSORS; c++) {
+        if(!cursors[c].pinned && (handle == -1 || cursors[c].node == nullptr
+                || (cursors[handle].node != nullptr && cursors[c].last_use < cursors[handle].last_use))) {
+            handle = c;
+        }
+    }
+    if(handle == -1) {
+        throw std::length_error("All cursors are already pinned");
+    }
+
+    cursors[handle].node = get_list_position(index, false);
+    cursors[handle].index = index;
+    cursors[handle].last_use = ++cursor_clock;
+    cursors[handle].pinned = true;
+    return handle;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+T& fast_linked_list<T, NodeAllocator>::at_cursor(int32_t handle, int32_t index) {
+    if(!(handle >= 0 && handle < N_CURSORS && cursors[handle].pinned)) {
+        throw std::invalid_argument("Cursor handle does not belong to a pinned cursor");
+    }
+    if(!(index >= 0 && index < n_elements)) {
+        throw std::out_of_range("Element retrieval index must be at least 0 and less than the array's size");
+    }
+
+    //Get the node, then move the cursor there. The search may start from this cursor
+    Node* position = get_list_position(index, false);
+    cursors[handle].node = position;
+    cursors[handle].index = index;
+    cursors[handle].last_use = ++cursor_clock;
+
+    return position->data;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+int32_t fast_linked_list<T, NodeAllocator>::cursor_index(int32_t handle) {
+    if(!(handle >= 0 && handle < N_CURSORS && cursors[handle].pinned)) {
+        throw std::invalid_argument("Cursor handle does not belong to a pinned cursor");
+    }
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot access a cursor's index in an empty list");
+    }
+    assert((cursors[handle].node != nullptr && "INTERNAL ERROR- Pinned cursor in a non-empty list cannot be null"));
+
+    return cursors[handle].index;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void fast_linked_list<T, NodeAllocator>::unpin_cursor(int32_t handle) {
+    if(!(handle >= 0 && handle < N_CURSORS && cursors[handle].pinned)) {
+        throw std::invalid_argument("Cursor handle does not belong to a pinned cursor");
+    }
+
+    cursors[handle].pinned = false;
+}
+
+
+
+template<typename CharT, typename Traits, typename T, template<typename> class NodeAllocator>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const fast_linked_list<T, NodeAllocator>& fll) {
     assert((fll.n_elements>=0 && "INTERNAL ERROR- Number of elements cannot be negative"));
 
     const CharT open[]  = { CharT('{'), CharT('\0') };
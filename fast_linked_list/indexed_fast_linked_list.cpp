@@ -0,0 +1,1180 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include "fast_linked_list.cpp"
+#include "node_allocator.cpp"
+
+namespace utils {
+
+
+
+
+/**
+ * Fast Linked List with a skip list index built over its nodes, allowing access and insertion at any index in O(log n) expected time.
+ *
+ * Supports the same operations as `fast_linked_list`, with the same last accessed element behavior.
+ * Also supports adding (`insert`) and removing (`erase`) elements at any index.
+ *
+ * Every node is on level 0, a normal doubly linked list. A node is also on levels 1, 2, 3... with probability 1/4, 1/16, 1/64...
+ * Each link above level 0 stores its span (the difference between the indices of the nodes it connects),
+ * so an index search can skip over many nodes at once.
+ *
+ * Indices close to the start, the end, or the last accessed element are still reached by walking through level 0.
+ * Adding and removing at either end only changes the levels of the node being added or removed, so it takes O(1) expected time.
+ *
+ * Nodes come from `NodeAllocator`. The links of nodes above level 0 are allocated separately with `new`.
+ *
+ * @param T datatype of the stored items
+ * @param NodeAllocator allocation policy for the list's nodes. Default: `node_pool`
+ */
+template<typename T, template<typename> class NodeAllocator = node_pool>
+class indexed_fast_linked_list {
+
+private:
+    /**
+     * Maximum number of levels in the index
+     */
+    static const int32_t MAX_LEVELS = 32;
+
+    /**
+     * Maximum distance walked through level 0, from the start, end, or last accessed element, before an index search is used instead
+     */
+    static const int32_t MAX_WALK_DISTANCE = 16;
+
+    struct Node;
+
+    /**
+     * Connection from a node to its neighbors on one level.
+     *
+     * `span` is the index of `next` minus the index of the node owning the link. It is unused if `next` is `nullptr`.
+     */
+    struct Link {
+        Node* prev;
+        Node* next;
+        int32_t span;
+    };
+
+    /**
+     * A node in an indexed fast linked list, containing data (`data`) and its links on each of its `height` levels.
+     *
+     * The level 0 link is stored in the node. Links on levels 1 to `height`-1 are stored in `upper_links`, which is `nullptr` if `height` is 1.
+     *
+     * A node at the start of a level has a `nullptr` predecessor on that level.
+     * A node at the end of a level has a `nullptr` successor on that level.
+     */
+    struct Node {
+        Link base_link;
+        Link* upper_links;
+        int32_t height;
+        T data;
+
+        /**
+         * @param level level of the link. Must be less than `height`
+         * @return reference to the node's link on `level`
+         */
+        Link& link(int32_t level) {
+            return (level == 0) ? base_link : upper_links[level - 1];
+        }
+    };
+
+
+    /**
+     * First node on each level. `nullptr` if the level is empty.
+     *
+     * `head_nodes[0]` is the start of the list.
+     */
+    Node* head_nodes[MAX_LEVELS];
+
+    /**
+     * Final node on each level. `nullptr` if the level is empty.
+     *
+     * `tail_nodes[0]` is the end of the list.
+     */
+    Node* tail_nodes[MAX_LEVELS];
+
+    /**
+     * Position of each level's first node. The node's index is its position minus `origin`.
+     */
+    int64_t head_positions[MAX_LEVELS];
+
+    /**
+     * Position of each level's final node. The node's index is its position minus `origin`.
+     */
+    int64_t tail_positions[MAX_LEVELS];
+
+    /**
+     * Converts the positions of the first and final nodes into indices.
+     *
+     * Adding or removing at the front changes every index by one. Changing `origin` does that without touching each level.
+     */
+    int64_t origin;
+
+    /**
+     * Number of levels that may contain nodes. Between 1 and `MAX_LEVELS`.
+     */
+    int32_t n_levels;
+
+    /**
+     * Pointer to the last node used
+     */
+    Node* last_used_node;
+
+    /**
+     * Index number (0-based indexing) of the last node used
+     */
+    int32_t last_used_index;
+
+    /**
+     * Number of elements in the list. Non-negative.
+     */
+    int32_t n_elements;
+
+    /**
+     * State of the random number generator choosing node heights
+     */
+    uint32_t random_state;
+
+    /**
+     * Source of memory for all nodes in the list
+     */
+    NodeAllocator<Node> node_allocator;
+
+
+
+    /**
+     * Returns a pointer to a new, unlinked node containing `value`, with a randomly chosen height.
+     *
+     * Private helper method.
+     *
+     * @param value value to put in the new node
+     * @return pointer to the new node
+     */
+    Node* create_node(const T& value);
+
+    /**
+     * Destroys `node` and gives its memory back to the node allocator.
+     *
+     * Private helper method.
+     *
+     * @param node node to destroy. Cannot be `nullptr`
+     */
+    void destroy_node(Node* node);
+
+    /**
+     * Returns a pointer to the node at list index `index`, walking from the start, end, or last accessed node if one is close,
+     * and searching the index otherwise.
+     *
+     * Private helper method.
+     *
+     * @param index index to get in the list. Must be on the interval [ 0, `list.size()`-1 ]
+     * @return pointer to the index's node
+     */
+    Node* get_list_position(int32_t index) const;
+
+    /**
+     * For each level, finds the final node with an index less than `index`, storing the node in `predecessors` and its index in `predecessor_indices`.
+     * A level with no such node gets `nullptr` and -1.
+     *
+     * Private helper method.
+     *
+     * @param index index to find the predecessors of. Must be on the interval [ 0, `list.size()` ]
+     * @param predecessors output: predecessor on each level, for the first `n_levels` levels
+     * @param predecessor_indices output: index of each predecessor
+     */
+    void find_predecessors(int32_t index, Node** predecessors, int32_t* predecessor_indices) const;
+
+    /**
+     * Puts a new node containing `value` at index `index`, updating every level. Does not change `n_elements` or the last accessed element.
+     *
+     * Private helper method.
+     *
+     * @param index index of the new node. Must be on the interval [ 0, `list.size()` ]
+     * @param value value to add
+     * @return pointer to the new node
+     */
+    Node* insert_node(int32_t index, const T& value);
+
+    /**
+     * Removes and destroys the node at index `index`, updating every level. Does not change `n_elements` or the last accessed element.
+     *
+     * Private helper method.
+     *
+     * @param index index of the node to remove. Must be on the interval [ 0, `list.size()`-1 ]
+     */
+    void erase_node(int32_t index);
+
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+public:
+
+    /**
+     * Creates an empty Indexed Fast Linked List.
+     */
+    indexed_fast_linked_list() {
+        for(int32_t l = 0; l < MAX_LEVELS; l++) {
+            head_nodes[l] = nullptr;
+            tail_nodes[l] = nullptr;
+            head_positions[l] = 0;
+            tail_positions[l] = 0;
+        }
+        origin = 0;
+        n_levels = 1;
+
+        last_used_node = nullptr;
+        last_used_index = 0;
+        n_elements = 0;
+
+        random_state = 2463534242u;
+    }
+
+
+
+    /**
+     * Creates an Indexed Fast Linked List containing the items in `initial_contents` in order.
+     *
+     * The last used index is set to `initial_contents.size() / 2`.
+     *
+     * @param initial_contents std::vector of items to load the list with
+     */
+    indexed_fast_linked_list(const std::vector<T>& initial_contents) : indexed_fast_linked_list() {
+        for(int32_t i = 0; i < (int32_t)initial_contents.size(); i++) {
+            this->push_back(initial_contents[i]);
+        }
+
+        if(n_elements > 0) {
+            last_used_node = get_list_position(n_elements / 2);
+            last_used_index = n_elements / 2;
+        }
+    }
+
+
+
+    /**
+     * Copies `other_list` into a new list.
+     * @param other_list list to copy into this list
+     */
+    indexed_fast_linked_list(const indexed_fast_linked_list& other_list) : indexed_fast_linked_list() {
+        *this = other_list;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //METHOD DECLARATIONS
+
+
+    /**
+     * Returns a reference to the value at index `index` (0-based indexing).
+     * If `setting_last_accessed` is true, the last accessed value will be set to the one at `index`.
+     *
+     * If `index` is negative or at least the list's size, throws `std::out_of_range`.
+     *
+     * The last accessed value will *not* be changed if the first or last index is retrieved,
+     * regardless of the value of `setting_last_accessed`.
+     *
+     * @param index index to get value from
+     * @param setting_last_accessed whether to change the last accessed value to the one at `index`
+     * @return value at the specified index
+     * @throws `std::out_of_range` if `index` is out of the array's bounds
+     *
+     */
+    T& at(int32_t index, bool setting_last_accessed = true);
+
+    /**
+     * Removes the element at index `index`. All elements after `index` will have their indices decrease by 1.
+     *
+     * If the last accessed element is removed, the new last accessed element becomes the element after the removed element,
+     * or the new end of the list if the removed element was the final element.
+     *
+     * If `index` is negative or at least the list's size, throws `std::out_of_range`.
+     *
+     * @param index index of the element to remove
+     * @throws `std::out_of_range` if `index` is out of the list's bounds
+     */
+    void erase(int32_t index);
+
+    /**
+     * Adds `new_value` at index `index`. All elements at or after `index` will have their indices increase by 1.
+     *
+     * The last accessed element remains the same. If the list was empty, the new element becomes the last accessed element.
+     *
+     * If `index` is negative or greater than the list's size, throws `std::out_of_range`.
+     *
+     * @param index index of the new element. Adding at index `list.size()` adds to the end
+     * @param new_value value to add
+     * @throws `std::out_of_range` if `index` is out of range
+     */
+    void insert(int32_t index, T new_value);
+
+    /**
+     * Returns the index number of the element (0-based indexing) last retrieved or modified.
+     *
+     * If the list is empty, throws a `std::out_of_range`.
+     *
+     * @return index of the element marked for quick access
+     * @throws `std::out_of_range` if the list is empty
+     */
+    int32_t last_accessed_index() const;
+
+    /**
+     * Returns a reference to the element last retrieved or modified.
+     *
+     * If the list is empty, throws `std::out_of_range`.
+     *
+     * @return reference to the previous element retrieved or edited
+     * @throws `std::out_of_range` if the list is empty
+     */
+    T& last_accessed_element();
+
+    /**
+     * Removes the final element of the list.
+     *
+     * If the last accessed value is the final index,
+     * the new last accessed value becomes the new end of the list.
+     *
+     * Throws `std::out_of_range` if the list is empty.
+     *
+     * @throws `std::out_of_range` if the list is empty
+     */
+    void pop_back();
+
+    /**
+     * Removes the first element of the list.
+     *
+     * If the last accessed value is the first index,
+     * the new last accessed value becomes the new front of the list.
+     *
+     * Throws `std::out_of_range` if the list is empty.
+     *
+     * @throws `std::out_of_range` if the list is empty
+     */
+    void pop_front();
+
+    /**
+     * Removes the last accessed element.
+     *
+     * The new last accessed element becomes the element after the removed element.
+     * If the last accessed element is the final element, the new last accessed element becomes
+     * the new end of the list.
+     *
+     * If the list is empty, throws `std::out_of_range`.
+     *
+     * @throws `std::out_of_range` if the list is empty
+     */
+    void pop_last_accessed();
+
+    /**
+     * Adds `new_value` to the end of the list.
+     * @param new_value value to add to the end
+     *
+    */
+    void push_back(T new_value);
+
+    /**
+     * Adds `new_value` to the front of the list.
+     *
+     * The last accessed index will increase by 1. The last accessed value remains the same.
+     *
+     * @param new_value value to add to the end
+     *
+     */
+    void push_front(T new_value);
+
+    /**
+     * Adds `new_value` at the index of the last accessed element.
+     *
+     * All elements at or after the last acccessed element will have their indices increase by 1.
+     *
+     * The newly added element becomes the new last accessed element.
+     *
+     * If the list is empty, throws `std::out_of_range`.
+     *
+     * @param new_value value to add to the last accessed
+     * @throws `std::out_of_range` if the list is empty
+     */
+    void push_last_accessed(T new_value);
+
+
+    /**
+     * Sets the value at index `index` (0-based indexing) to `new_value`.
+     * If `setting_last_accessed` is true, the last accessed index will be set to `index`.
+     *
+     * If `index` is negative or at least the list's size, throws `std::out_of_range`.
+     *
+     * The last accessed value will *not* be changed if the first or last index is set,
+     * regardless of the value of `setting_last_accessed`.
+     *
+     * @param index index to change in the list
+     * @param new_value value to set
+     * @param setting_last_accessed whether to change the last accessed value to the one at `index`. Default: true
+     * @throws `std::out_of_range` if `index` is out of the array's bounds
+     *
+     */
+    void set(int32_t index, T new_value, bool setting_last_accessed = true);
+
+    /**
+     *
+     * @return the number of elements in the list
+     */
+    int32_t size() const;
+
+    /**
+     * Removes all elements from the list.
+     */
+    void clear();
+
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //OPERATOR OVERLOADS
+
+    /**
+     * Copies `other_list` into this Indexed Fast Linked List object, returning a reference to this list after the modification.
+     *
+     * The location of `other_list`'s last accessed value is also copied.
+     *
+     * @param other_list list to copy into this list
+     * @return reference to this (modified) list
+     */
+    indexed_fast_linked_list& operator=(const indexed_fast_linked_list& other_list) {
+        //self-assignment check
+        if(this == &other_list) {
+            return *this;
+        }
+
+        clear();
+
+        for(Node* other_current = other_list.head_nodes[0]; other_current != nullptr; other_current = other_current->base_link.next) {
+            this->push_back(other_current->data);
+
+            //check for last accessed
+            if(other_current == other_list.last_used_node) {
+                last_used_node = tail_nodes[0];
+                last_used_index = n_elements - 1;
+            }
+        }
+
+        return *this;
+    }
+
+
+
+    /**
+     * Returns `true` if this list and `other_list` have the same number of elements,
+     * and each corresponding element is equal.
+     * Returns `false` otherwise.
+     *
+     * @param other_list list to compare to
+     * @return whether the lists are equal (length and elements)
+     */
+    bool operator==(const indexed_fast_linked_list& other_list) const {
+        //check size
+        if(other_list.n_elements != this->n_elements) {
+            return false;
+        }
+
+        Node* current_node = this->head_nodes[0];
+        Node* other_current_node = other_list.head_nodes[0];
+
+        //check each element
+        while(current_node != nullptr) {
+            if(current_node->data != other_current_node->data) {
+                return false;
+            }
+
+            current_node = current_node->base_link.next;
+            other_current_node = other_current_node->base_link.next;
+        }
+
+        return true;
+    }
+
+
+
+    /**
+     * Returns a non-constant reference to the value at index `index` (0-based indexing), and sets the last accessed value to the one at `index`.
+     * If `index` is negative or at least the list's size, throws `out_of_range`.
+     *
+     * The last accessed value will *not* be changed if the first or last index is retrieved.
+     *
+     * Equivalent to `{listName}.at(index, true)`.
+     *
+     * @param index the index to get the value from
+     * @return reference to value at index `index`
+     * @throws `out_of_range` if `index` is out of the array's bounds
+     *
+     */
+    T& operator[](int32_t index) {
+        return at(index, true);
+    }
+
+
+
+    /**
+     * Exports `ifll` to `output_stream`, returning a reference to `output_stream` with `ifll` inside.
+     *
+     * The contents of `ifll` are surrounded in curly braces and separated by commas.
+     *
+     * @param output_stream stream to send the list into
+     * @param ifll list to export
+     * @return reference to `output_stream` with `ifll` inside
+     */
+    template<typename CharT, typename Traits, typename Tp, template<typename> class Alloc>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const indexed_fast_linked_list<Tp, Alloc>& ifll);
+
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //DESTRUCTOR
+
+
+    /**
+     * Properly destroys an Indexed Fast Linked List.
+     */
+    ~indexed_fast_linked_list() {
+        clear();
+    }
+};
+
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+//METHOD DEFINITIONS
+
+
+template<typename T, template<typename> class NodeAllocator>
+typename indexed_fast_linked_list<T, NodeAllocator>::Node* indexed_fast_linked_list<T, NodeAllocator>::create_node(const T& value) {
+    //choose a height: each extra level has a 1 in 4 chance (xorshift random number generator)
+    int32_t height = 1;
+    while(height < MAX_LEVELS) {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 17;
+        random_state ^= random_state << 5;
+        if((random_state & 3) != 0) {
+            break;
+        }
+        height++;
+    }
+
+    Link* upper_links = (height > 1) ? new Link[height - 1]() : nullptr;
+    Node* new_node = nullptr;
+
+    //construct the node in the allocated memory. If anything throws, give the memory back
+    try {
+        new_node = node_allocator.allocate();
+        try {
+            ::new (static_cast<void*>(new_node)) Node{Link{nullptr, nullptr, 1}, upper_links, height, value};
+        }
+        catch(...) {
+            node_allocator.deallocate(new_node);
+            throw;
+        }
+    }
+    catch(...) {
+        delete[] upper_links;
+        throw;
+    }
+
+    return new_node;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void indexed_fast_linked_list<T, NodeAllocator>::destroy_node(Node* node) {
+    assert((node != nullptr && "INTERNAL ERROR- Cannot destroy a null node"));
+
+    delete[] node->upper_links;
+    node->~Node();
+    node_allocator.deallocate(node);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+typename indexed_fast_linked_list<T, NodeAllocator>::Node* indexed_fast_linked_list<T, NodeAllocator>::get_list_position(int32_t index) const {
+    assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+    assert((index >= 0 && index < n_elements && "INTERNAL ERROR- index is out of bounds"));
+    assert((last_used_node != nullptr && "INTERNAL ERROR- Last accessed node cannot be null"));
+    assert((last_used_index >= 0 && last_used_index < n_elements && "INTERNAL ERROR- Last accessed index is out of list's bounds"));
+
+    //Find the closest of the start, end, and last accessed node
+    int32_t current_index = 0;
+    Node* current_node = head_nodes[0];
+    int32_t walk_distance = index;
+
+    if(distance(index, n_elements-1) < walk_distance) {
+        current_index = n_elements-1;
+        current_node = tail_nodes[0];
+        walk_distance = distance(index, n_elements-1);
+    }
+    if(distance(index, last_used_index) < walk_distance) {
+        current_index = last_used_index;
+        current_node = last_used_node;
+        walk_distance = distance(index, last_used_index);
+    }
+
+    //Close enough: walk through level 0
+    if(walk_distance <= MAX_WALK_DISTANCE) {
+        while(current_index < index) {
+            current_node = current_node->base_link.next;
+            current_index++;
+        }
+        while(current_index > index) {
+            current_node = current_node->base_link.prev;
+            current_index--;
+        }
+        return current_node;
+    }
+
+    //Too far: search from the top level down, moving forward while the next node does not pass the index
+    current_node = nullptr;
+    current_index = -1;
+    for(int32_t l = n_levels - 1; l >= 0; l--) {
+        while(true) {
+            Node* next_node = (current_node == nullptr) ? head_nodes[l] : current_node->link(l).next;
+            if(next_node == nullptr) {
+                break;
+            }
+
+            int32_t next_index = (current_node == nullptr) ? (int32_t)(head_positions[l] - origin) : current_index + current_node->link(l).span;
+            if(next_index > index) {
+                break;
+            }
+
+            current_node = next_node;
+            current_index = next_index;
+        }
+
+        if(current_index == index) {
+            return current_node;
+        }
+    }
+
+    //Execution should never get here
+    throw std::runtime_error("INTERNAL ERROR: Index search failed");
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void indexed_fast_linked_list<T, NodeAllocator>::find_predecessors(int32_t index, Node** predecessors, int32_t* predecessor_indices) const {
+    Node* current_node = nullptr;
+    int32_t current_index = -1;
+
+    //search from the top level down, moving forward while the next node is before the index
+    for(int32_t l = n_levels - 1; l >= 0; l--) {
+        while(true) {
+            Node* next_node = (current_node == nullptr) ? head_nodes[l] : current_node->link(l).next;
+            if(next_node == nullptr) {
+                break;
+            }
+
+            int32_t next_index = (current_node == nullptr) ? (int32_t)(head_positions[l] - origin) : current_index + current_node->link(l).span;
+            if(next_index >= index) {
+                break;
+            }
+
+            current_node = next_node;
+            current_index = next_index;
+        }
+
+        predecessors[l] = current_node;
+        predecessor_indices[l] = current_index;
+    }
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+typename indexed_fast_linked_list<T, NodeAllocator>::Node* indexed_fast_linked_list<T, NodeAllocator>::insert_node(int32_t index, const T& value) {
+    Node* new_node = create_node(value);
+
+    //Adding to the front: shift every index using the origin, then link the new node's levels
+    if(index == 0) {
+        origin--;
+
+        for(int32_t l = 0; l < new_node->height; l++) {
+            Node* next_node = head_nodes[l];
+            new_node->link(l).next = next_node;
+
+            if(next_node != nullptr) {
+                new_node->link(l).span = (int32_t)(head_positions[l] - origin);
+                next_node->link(l).prev = new_node;
+            }
+            else {
+                tail_nodes[l] = new_node;
+                tail_positions[l] = origin;
+            }
+
+            head_nodes[l] = new_node;
+            head_positions[l] = origin;
+        }
+    }
+    //Adding to the back: link the new node after the final node of each of its levels
+    else if(index == n_elements) {
+        for(int32_t l = 0; l < new_node->height; l++) {
+            Node* prev_node = tail_nodes[l];
+            new_node->link(l).prev = prev_node;
+
+            if(prev_node != nullptr) {
+                prev_node->link(l).next = new_node;
+                prev_node->link(l).span = index - (int32_t)(tail_positions[l] - origin);
+            }
+            else {
+                head_nodes[l] = new_node;
+                head_positions[l] = index + origin;
+            }
+
+            tail_nodes[l] = new_node;
+            tail_positions[l] = index + origin;
+        }
+    }
+    //Adding to the middle: every level changes, either to link the new node, or because the nodes after it shift
+    else {
+        Node* predecessors[MAX_LEVELS];
+        int32_t predecessor_indices[MAX_LEVELS];
+        find_predecessors(index, predecessors, predecessor_indices);
+
+        int32_t levels_to_update = (new_node->height > n_levels) ? new_node->height : n_levels;
+        for(int32_t l = n_levels; l < levels_to_update; l++) {
+            predecessors[l] = nullptr;
+            predecessor_indices[l] = -1;
+        }
+
+        for(int32_t l = 0; l < levels_to_update; l++) {
+            Node* prev_node = predecessors[l];
+            Node* next_node = (prev_node == nullptr) ? head_nodes[l] : prev_node->link(l).next;
+
+            //nodes after the new node shift one index later
+            if(next_node != nullptr) {
+                tail_positions[l]++;
+            }
+
+            //level without the new node: the link over the new node gets one longer
+            if(l >= new_node->height) {
+                if(next_node != nullptr) {
+                    if(prev_node == nullptr) {
+                        head_positions[l]++;
+                    }
+                    else {
+                        prev_node->link(l).span++;
+                    }
+                }
+                continue;
+            }
+
+            //level with the new node: put the new node between the predecessor and its successor
+            new_node->link(l).prev = prev_node;
+            new_node->link(l).next = next_node;
+
+            if(next_node != nullptr) {
+                int32_t next_index = (prev_node == nullptr) ? (int32_t)(head_positions[l] - origin) : predecessor_indices[l] + prev_node->link(l).span;
+                new_node->link(l).span = next_index + 1 - index;
+                next_node->link(l).prev = new_node;
+            }
+            else {
+                tail_nodes[l] = new_node;
+                tail_positions[l] = index + origin;
+            }
+
+            if(prev_node == nullptr) {
+                head_nodes[l] = new_node;
+                head_positions[l] = index + origin;
+            }
+            else {
+                prev_node->link(l).next = new_node;
+                prev_node->link(l).span = index - predecessor_indices[l];
+            }
+        }
+    }
+
+    if(new_node->height > n_levels) {
+        n_levels = new_node->height;
+    }
+
+    return new_node;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void indexed_fast_linked_list<T, NodeAllocator>::erase_node(int32_t index) {
+
+    //Removing from the front: unlink the node's levels, then shift every index using the origin
+    if(index == 0) {
+        Node* delete_node = head_nodes[0];
+
+        for(int32_t l = 0; l < delete_node->height; l++) {
+            Node* next_node = delete_node->link(l).next;
+            head_nodes[l] = next_node;
+
+            if(next_node != nullptr) {
+                head_positions[l] = origin + delete_node->link(l).span;
+                next_node->link(l).prev = nullptr;
+            }
+            else {
+                tail_nodes[l] = nullptr;
+            }
+        }
+
+        origin++;
+        destroy_node(delete_node);
+    }
+    //Removing from the back: the node is the final node of each of its levels
+    else if(index == n_elements-1) {
+        Node* delete_node = tail_nodes[0];
+
+        for(int32_t l = 0; l < delete_node->height; l++) {
+            Node* prev_node = delete_node->link(l).prev;
+            tail_nodes[l] = prev_node;
+
+            if(prev_node != nullptr) {
+                prev_node->link(l).next = nullptr;
+                tail_positions[l] = (index - prev_node->link(l).span) + origin;
+            }
+            else {
+                head_nodes[l] = nullptr;
+            }
+        }
+
+        destroy_node(delete_node);
+    }
+    //Removing from the middle: every level changes, either to unlink the node, or because the nodes after it shift
+    else {
+        Node* predecessors[MAX_LEVELS];
+        int32_t predecessor_indices[MAX_LEVELS];
+        find_predecessors(index, predecessors, predecessor_indices);
+
+        Node* delete_node = (predecessors[0] == nullptr) ? head_nodes[0] : predecessors[0]->base_link.next;
+
+        for(int32_t l = 0; l < n_levels; l++) {
+            Node* prev_node = predecessors[l];
+
+            //level without the node: the link over the node gets one shorter
+            if(l >= delete_node->height) {
+                Node* next_node = (prev_node == nullptr) ? head_nodes[l] : prev_node->link(l).next;
+                if(next_node != nullptr) {
+                    if(prev_node == nullptr) {
+                        head_positions[l]--;
+                    }
+                    else {
+                        prev_node->link(l).span--;
+                    }
+                    tail_positions[l]--;
+                }
+                continue;
+            }
+
+            //level with the node: connect the node's predecessor and successor
+            Node* next_node = delete_node->link(l).next;
+
+            if(next_node != nullptr) {
+                if(prev_node == nullptr) {
+                    head_positions[l] = (index + delete_node->link(l).span - 1) + origin;
+                }
+                else {
+                    prev_node->link(l).span += delete_node->link(l).span - 1;
+                }
+                next_node->link(l).prev = prev_node;
+                tail_positions[l]--;
+            }
+            else {
+                tail_nodes[l] = prev_node;
+                tail_positions[l] = predecessor_indices[l] + origin;
+            }
+
+            if(prev_node == nullptr) {
+                head_nodes[l] = next_node;
+            }
+            else {
+                prev_node->link(l).next = next_node;
+            }
+        }
+
+        destroy_node(delete_node);
+    }
+}
+
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+T& indexed_fast_linked_list<T, NodeAllocator>::at(int32_t index, bool setting_last_accessed) {
+    //check index range
+    if(!(index >= 0 && index < n_elements)) {
+        throw std::out_of_range("Element retrieval index must be at least 0 and less than the array's size");
+    }
+
+    //Get node at the desired position
+    Node* position = get_list_position(index);
+
+    //Set last accessed, if selected and the user didn't get the first or last index
+    if(setting_last_accessed && !(index==0 || index==n_elements-1)) {
+        last_used_node = position;
+        last_used_index = index;
+    }
+
+    return position->data;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void indexed_fast_linked_list<T, NodeAllocator>::erase(int32_t index) {
+    if(!(index >= 0 && index < n_elements)) {
+        throw std::out_of_range("Removal index must be at least 0 and less than the list's size");
+    }
+
+    //find the last accessed element's replacement before its node is destroyed
+    Node* removed_last_used_replacement = nullptr;
+    if(index == last_used_index) {
+        removed_last_used_replacement = (index == n_elements-1) ? last_used_node->base_link.prev : last_used_node->base_link.next;
+    }
+
+    erase_node(index);
+    n_elements--;
+
+    if(n_elements == 0) {
+        last_used_node = nullptr;
+        last_used_index = 0;
+    }
+    //elements after the removed element move one index earlier
+    else if(index < last_used_index) {
+        last_used_index--;
+    }
+    //last accessed removed: use the next element, or the new end
+    else if(index == last_used_index) {
+        last_used_node = removed_last_used_replacement;
+        if(last_used_index == n_elements) {
+            last_used_index--;
+        }
+    }
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void indexed_fast_linked_list<T, NodeAllocator>::insert(int32_t index, T new_value) {
+    if(!(index >= 0 && index <= n_elements)) {
+        throw std::out_of_range("Insertion index must be at least 0 and no greater than the list's size");
+    }
+
+    Node* new_node = insert_node(index, new_value);
+
+    //no elements: the new element is the last accessed
+    if(n_elements == 0) {
+        last_used_node = new_node;
+        last_used_index = 0;
+    }
+    //elements at or after the new element move one index later
+    else if(index <= last_used_index) {
+        last_used_index++;
+    }
+
+    n_elements++;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+inline int32_t indexed_fast_linked_list<T, NodeAllocator>::last_accessed_index() const {
+    //check for empty list
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot access the last accessed index of an empty list");
+    }
+    //check index range
+    assert((last_used_index >= 0 && last_used_index < n_elements && "INTERNAL ERROR- Last accessed index out of range"));
+
+    return last_used_index;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+inline T& indexed_fast_linked_list<T, NodeAllocator>::last_accessed_element() {
+    //check for empty list
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot access the last used element of an empty list");
+    }
+    //check index range
+    assert((last_used_index >= 0 && last_used_index < n_elements && "INTERNAL ERROR- Last accessed index out of range"));
+
+    return last_used_node->data;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void indexed_fast_linked_list<T, NodeAllocator>::pop_back() {
+    assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot remove elements from the back of an empty list");
+    }
+
+    erase(n_elements - 1);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void indexed_fast_linked_list<T, NodeAllocator>::pop_front() {
+    assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot remove elements from the front of an empty list");
+    }
+
+    erase(0);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void indexed_fast_linked_list<T, NodeAllocator>::pop_last_accessed() {
+    assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot remove the last accessed element of an empty list");
+    }
+
+    erase(last_used_index);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void indexed_fast_linked_list<T, NodeAllocator>::push_back(T new_value) {
+    insert(n_elements, new_value);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void indexed_fast_linked_list<T, NodeAllocator>::push_front(T new_value) {
+    insert(0, new_value);
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void indexed_fast_linked_list<T, NodeAllocator>::push_last_accessed(T new_value) {
+    assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+
+    //no elements: throw exception
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot add values in front of the last used element, in an empty list");
+    }
+    assert((last_used_index>=0 && last_used_index<n_elements && "INTERNAL ERROR- Last accessed index out of range"));
+
+    //last accessed at end: essentially push back
+    int32_t new_index = (last_used_index == n_elements-1 && last_used_index != 0) ? n_elements : last_used_index;
+
+    Node* new_node = insert_node(new_index, new_value);
+    n_elements++;
+
+    //the new element becomes the last accessed
+    last_used_node = new_node;
+    last_used_index = new_index;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void indexed_fast_linked_list<T, NodeAllocator>::set(int32_t index, T new_value, bool setting_last_accessed) {
+    if(!(index>=0 && index<n_elements)) {
+        throw std::out_of_range("Index must be at least 0 and less than the list's size");
+    }
+
+    //Find the node at the specified index
+    Node* pos = get_list_position(index);
+
+    //Reconfigure last accessed, if desired and the value set is not the first or last index
+    if(setting_last_accessed && !(index==0 || index==n_elements-1)) {
+        last_used_node = pos;
+        last_used_index = index;
+    }
+
+    //Update the node
+    pos->data = new_value;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+inline int32_t indexed_fast_linked_list<T, NodeAllocator>::size() const {
+    return n_elements;
+}
+
+
+
+template<typename T, template<typename> class NodeAllocator>
+void indexed_fast_linked_list<T, NodeAllocator>::clear() {
+    Node* current = head_nodes[0];
+    while(current != nullptr) {
+        Node* delete_node = current;
+        current = current->base_link.next;
+        destroy_node(delete_node);
+    }
+
+    for(int32_t l = 0; l < MAX_LEVELS; l++) {
+        head_nodes[l] = nullptr;
+        tail_nodes[l] = nullptr;
+    }
+    origin = 0;
+    n_levels = 1;
+
+    last_used_node = nullptr;
+    last_used_index = 0;
+    n_elements = 0;
+}
+
+
+
+template<typename CharT, typename Traits, typename T, template<typename> class NodeAllocator>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const indexed_fast_linked_list<T, NodeAllocator>& ifll) {
+    assert((ifll.n_elements>=0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+
+    const CharT open[]  = { CharT('{'), CharT('\0') };
+    const CharT close[] = { CharT('}'), CharT('\0') };
+    const CharT comma[] = { CharT(','), CharT(' '), CharT('\0') };
+
+    if(ifll.n_elements == 0) {
+        output_stream << open << close;
+        return output_stream;
+    }
+
+    output_stream << open;
+
+    auto* current_node = ifll.head_nodes[0];
+    while(current_node->base_link.next != nullptr) {
+        output_stream << current_node->data << comma;
+        current_node = current_node->base_link.next;
+    }
+
+    output_stream << current_node->data << close;
+
+    return output_stream;
+}
+
+
+
+
+}
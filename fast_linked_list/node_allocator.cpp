@@ -0,0 +1,419 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace utils {
+
+
+
+
+/**
+ * Node allocation policy that allocates and frees every node separately using the global `operator new` and `operator delete`.
+ *
+ * Matches how nodes were allocated before allocation policies existed. Mostly useful as a baseline for benchmarks.
+ *
+ * An allocation policy only hands out and takes back raw memory. Constructing and destroying the nodes is the list's job.
+ *
+ * A policy also has `reserve`, a hint that many nodes are about to be allocated together.
+ *
+ * To support splicing, a policy also has `merge`, which makes it responsible for every node of another instance of the policy,
+ * and `SHARED_NODES`, which is true if any instance can free a node allocated by any other instance.
+ *
+ * @param Node type of node to allocate memory for
+ */
+template<typename Node>
+class node_new_delete {
+public:
+
+    /**
+     * Every node comes from the global heap, so any instance can free it
+     */
+    static const bool SHARED_NODES = true;
+
+    /**
+     * Returns a pointer to uninitialized memory large enough to hold one `Node`.
+     *
+     * @return pointer to memory for one node
+     * @throws `std::bad_alloc` if the memory cannot be allocated
+     */
+    Node* allocate() {
+        return static_cast<Node*>(::operator new(sizeof(Node)));
+    }
+
+    /**
+     * Frees the memory pointed to by `node`. The node must have already been destroyed.
+     *
+     * @param node pointer previously returned by `allocate`
+     */
+    void deallocate(Node* node) noexcept {
+        ::operator delete(node);
+    }
+
+    /**
+     * Does nothing, since every node is allocated separately.
+     *
+     * @param n_nodes number of nodes about to be allocated
+     */
+    void reserve(std::size_t n_nodes) noexcept {
+        (void)n_nodes;
+    }
+
+    /**
+     * Does nothing, since every instance can already free nodes from `other_policy`.
+     *
+     * @param other_policy policy whose nodes are being taken over
+     */
+    void merge(node_new_delete& other_policy) noexcept {
+        (void)other_policy;
+    }
+};
+
+
+
+
+/**
+ * Node allocation policy that carves nodes out of large contiguous chunks, then recycles freed nodes through a free list.
+ *
+ * Each new chunk holds twice as many nodes as the previous chunk, up to `MAX_CHUNK_NODES` nodes.
+ * Freed nodes are kept by the pool for later allocations. Chunks are only returned to the system when the pool is destroyed.
+ *
+ * Pools cannot be copied, since every node handed out by a pool belongs to that pool.
+ * Moving a pool moves all of its chunks, so nodes handed out by the old pool now belong to the new pool.
+ * Merging pools moves all chunks of one pool into another.
+ *
+ * @param Node type of node to allocate memory for
+ */
+template<typename Node>
+class node_pool {
+
+private:
+    /**
+     * One node-sized piece of a chunk. An unused slot stores a pointer to the next unused slot in the free list.
+     *
+     * The first slot of every chunk is reserved, and stores a pointer to the first slot of the previously allocated chunk.
+     */
+    union Slot {
+        Slot* next;
+        typename std::aligned_storage<sizeof(Node), alignof(Node)>::type storage;
+    };
+
+    /**
+     * Number of nodes in the first chunk
+     */
+    static const std::size_t INITIAL_CHUNK_NODES = 16;
+
+    /**
+     * Maximum number of nodes in one chunk
+     */
+    static const std::size_t MAX_CHUNK_NODES = 4096;
+
+
+    /**
+     * Most recently freed slot. `nullptr` if no freed slots exist.
+     */
+    Slot* free_list;
+
+    /**
+     * Final slot in the free list, so another pool's free list can be joined to it at once. `nullptr` if no freed slots exist.
+     */
+    Slot* free_tail;
+
+    /**
+     * Number of slots in the free list
+     */
+    std::size_t n_free_slots;
+
+    /**
+     * First slot (the reserved one) of the most recently allocated chunk. `nullptr` if no chunks exist.
+     */
+    Slot* chunk_list;
+
+    /**
+     * First slot (the reserved one) of the oldest chunk, which ends the chunk list. `nullptr` if no chunks exist.
+     */
+    Slot* oldest_chunk;
+
+    /**
+     * First never-used slot in the most recently allocated chunk
+     */
+    Slot* unused_start;
+
+    /**
+     * One past the final slot of the most recently allocated chunk
+     */
+    Slot* unused_end;
+
+    /**
+     * Number of nodes to put in the next chunk
+     */
+    std::size_t next_chunk_nodes;
+
+    /**
+     * Number of node slots in every chunk owned by the pool, not counting the reserved slots
+     */
+    std::size_t n_chunk_slots;
+
+
+
+    /**
+     * Allocates a new chunk of `n_nodes` slots and makes it the source of never-used slots.
+     *
+     * @param n_nodes number of slots in the new chunk, not counting the reserved slot
+     */
+    void allocate_chunk(std::size_t n_nodes) {
+        Slot* chunk = new Slot[n_nodes + 1];
+
+        //link the new chunk to the old ones, through the reserved first slot
+        chunk[0].next = chunk_list;
+        if(chunk_list == nullptr) {
+            oldest_chunk = chunk;
+        }
+        chunk_list = chunk;
+
+        unused_start = chunk + 1;
+        unused_end = chunk + 1 + n_nodes;
+        n_chunk_slots += n_nodes;
+    }
+
+    /**
+     * Takes every chunk and free slot from `other_pool`, then resets `other_pool` to an empty pool.
+     * This pool's own chunks must have already been freed.
+     *
+     * @param other_pool pool to take chunks from
+     */
+    void take_chunks(node_pool& other_pool) noexcept {
+        free_list = other_pool.free_list;
+        free_tail = other_pool.free_tail;
+        n_free_slots = other_pool.n_free_slots;
+        chunk_list = other_pool.chunk_list;
+        oldest_chunk = other_pool.oldest_chunk;
+        unused_start = other_pool.unused_start;
+        unused_end = other_pool.unused_end;
+        next_chunk_nodes = other_pool.next_chunk_nodes;
+        n_chunk_slots = other_pool.n_chunk_slots;
+
+        other_pool.free_list = nullptr;
+        other_pool.free_tail = nullptr;
+        other_pool.n_free_slots = 0;
+        other_pool.chunk_list = nullptr;
+        other_pool.oldest_chunk = nullptr;
+        other_pool.unused_start = nullptr;
+        other_pool.unused_end = nullptr;
+        other_pool.next_chunk_nodes = INITIAL_CHUNK_NODES;
+        other_pool.n_chunk_slots = 0;
+    }
+
+    /**
+     * Frees every chunk owned by the pool, leaving it with no chunks.
+     */
+    void free_chunks() noexcept {
+        while(chunk_list != nullptr) {
+            Slot* delete_chunk = chunk_list;
+            chunk_list = chunk_list[0].next;
+            delete[] delete_chunk;
+        }
+        oldest_chunk = nullptr;
+        free_list = nullptr;
+        free_tail = nullptr;
+        n_free_slots = 0;
+        unused_start = nullptr;
+        unused_end = nullptr;
+        n_chunk_slots = 0;
+    }
+
+public:
+
+    /**
+     * Creates an empty pool. No memory is allocated until the first call to `allocate`.
+     */
+    node_pool() noexcept {
+        free_list = nullptr;
+        free_tail = nullptr;
+        n_free_slots = 0;
+        chunk_list = nullptr;
+        oldest_chunk = nullptr;
+        unused_start = nullptr;
+        unused_end = nullptr;
+        next_chunk_nodes = INITIAL_CHUNK_NODES;
+        n_chunk_slots = 0;
+    }
+
+    /**
+     * Nodes live in the chunks of the pool that allocated them, so they cannot outlive that pool
+     */
+    static const bool SHARED_NODES = false;
+
+
+    node_pool(const node_pool&) = delete;
+    node_pool& operator=(const node_pool&) = delete;
+
+
+    /**
+     * Takes every chunk from `other_pool`, leaving `other_pool` empty.
+     *
+     * @param other_pool pool to move into this pool
+     */
+    node_pool(node_pool&& other_pool) noexcept {
+        take_chunks(other_pool);
+    }
+
+    /**
+     * Frees this pool's chunks, then takes every chunk from `other_pool`, leaving `other_pool` empty.
+     * All nodes from this pool must have already been destroyed.
+     *
+     * @param other_pool pool to move into this pool
+     * @return reference to this pool
+     */
+    node_pool& operator=(node_pool&& other_pool) noexcept {
+        if(this != &other_pool) {
+            free_chunks();
+            take_chunks(other_pool);
+        }
+        return *this;
+    }
+
+
+    /**
+     * Returns the number of nodes the pool's chunks can hold, counting nodes in use, freed nodes, and never-used slots.
+     * Only grows until the pool is destroyed.
+     *
+     * @return number of node slots in the pool's chunks
+     */
+    std::size_t capacity() const noexcept {
+        return n_chunk_slots;
+    }
+
+
+    /**
+     * Returns a pointer to uninitialized memory large enough to hold one `Node`.
+     *
+     * Recently freed nodes are reused first. If none exist, the node is taken from the newest chunk, allocating a new chunk if needed.
+     *
+     * @return pointer to memory for one node
+     * @throws `std::bad_alloc` if a new chunk cannot be allocated
+     */
+    Node* allocate() {
+        Slot* slot;
+
+        if(free_list != nullptr) {
+            slot = free_list;
+            free_list = free_list->next;
+            n_free_slots--;
+            if(free_list == nullptr) {
+                free_tail = nullptr;
+            }
+        }
+        else {
+            if(unused_start == unused_end) {
+                allocate_chunk(next_chunk_nodes);
+                next_chunk_nodes = (next_chunk_nodes * 2 > MAX_CHUNK_NODES) ? MAX_CHUNK_NODES : next_chunk_nodes * 2;
+            }
+            slot = unused_start;
+            unused_start++;
+        }
+
+        return reinterpret_cast<Node*>(&slot->storage);
+    }
+
+    /**
+     * Returns the memory pointed to by `node` to the pool for reuse. The node must have already been destroyed.
+     *
+     * @param node pointer previously returned by this pool's `allocate`
+     */
+    void deallocate(Node* node) noexcept {
+        assert((node != nullptr && "INTERNAL ERROR- Cannot deallocate a null node"));
+
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->next = free_list;
+        if(free_list == nullptr) {
+            free_tail = slot;
+        }
+        free_list = slot;
+        n_free_slots++;
+    }
+
+
+    /**
+     * Prepares for `n_nodes` allocations in a row. Freed slots and the newest chunk's never-used slots count towards `n_nodes`.
+     *
+     * Does nothing if those slots, plus the next chunk `allocate` would make, are enough. Otherwise, allocates a chunk large enough
+     * for the nodes the freed slots cannot hold (at most `MAX_CHUNK_NODES`), and makes later chunks grow from its size.
+     * Only then are never-used slots left in the previous newest chunk abandoned.
+     *
+     * Chunks are kept at most `MAX_CHUNK_NODES` long, since one huge chunk is no faster to fill than several large ones,
+     * and the system allocator hands it out as fresh pages that must all be faulted in again after every load.
+     *
+     * @param n_nodes number of nodes about to be allocated
+     * @throws `std::bad_alloc` if a new chunk cannot be allocated
+     */
+    void reserve(std::size_t n_nodes) {
+        std::size_t n_available = n_free_slots + (std::size_t)(unused_end - unused_start);
+        if(n_nodes <= n_available + next_chunk_nodes) {
+            return;
+        }
+
+        std::size_t n_chunk_nodes = n_nodes - n_free_slots;
+        n_chunk_nodes = (n_chunk_nodes < MAX_CHUNK_NODES) ? n_chunk_nodes : MAX_CHUNK_NODES;
+        allocate_chunk(n_chunk_nodes);
+        next_chunk_nodes = (n_chunk_nodes * 2 > MAX_CHUNK_NODES) ? MAX_CHUNK_NODES : n_chunk_nodes * 2;
+    }
+
+
+    /**
+     * Takes every chunk and freed slot from `other_pool`, so this pool now owns all nodes handed out by `other_pool`.
+     * `other_pool` is left empty. Never-used slots of `other_pool`'s newest chunk are not reused.
+     *
+     * Takes constant time, since both pools know the ends of their chunk lists and free lists.
+     *
+     * @param other_pool pool to merge into this pool
+     */
+    void merge(node_pool& other_pool) noexcept {
+        if(this == &other_pool || other_pool.chunk_list == nullptr) {
+            return;
+        }
+
+        //put the other pool's chunks in front of this pool's chunks
+        other_pool.oldest_chunk[0].next = chunk_list;
+        if(chunk_list == nullptr) {
+            oldest_chunk = other_pool.oldest_chunk;
+        }
+        chunk_list = other_pool.chunk_list;
+
+        //put the other pool's freed slots in front of this pool's freed slots
+        if(other_pool.free_list != nullptr) {
+            other_pool.free_tail->next = free_list;
+            if(free_list == nullptr) {
+                free_tail = other_pool.free_tail;
+            }
+            free_list = other_pool.free_list;
+            n_free_slots += other_pool.n_free_slots;
+        }
+        n_chunk_slots += other_pool.n_chunk_slots;
+
+        other_pool.free_list = nullptr;
+        other_pool.free_tail = nullptr;
+        other_pool.n_free_slots = 0;
+        other_pool.chunk_list = nullptr;
+        other_pool.oldest_chunk = nullptr;
+        other_pool.unused_start = nullptr;
+        other_pool.unused_end = nullptr;
+        other_pool.next_chunk_nodes = INITIAL_CHUNK_NODES;
+        other_pool.n_chunk_slots = 0;
+    }
+
+
+    /**
+     * Frees every chunk owned by the pool. All nodes from the pool must have already been destroyed.
+     */
+    ~node_pool() {
+        free_chunks();
+    }
+};
+
+
+
+
+}
@@ -0,0 +1,126 @@
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "concurrent_fast_linked_list.cpp"
+
+using namespace std;
+using namespace utils;
+
+
+void test_single_thread() {
+    concurrent_fast_linked_list<int> l1;
+    for (int i = 0; i < 5; i++) {
+        l1.push_back(10 + i);
+        l1.push_front(9 - i);
+    }
+
+    concurrent_fast_linked_list<int>::cursor position;
+    cout << "Indexed access: expected 5 9 10 14, size=10" << endl;
+    cout << l1.at(0, position) << " " << l1.at(4, position) << " " << l1.at(5, position) << " " << l1.at(9) << ", size=" << l1.size() << endl;
+
+    int front;
+    int back;
+    l1.try_pop_front(front);
+    l1.try_pop_back(back);
+    l1.set(0, -6, position);
+    cout << "After popping both ends and setting index 0: expected popped 5 14, first -6, size=8" << endl;
+    cout << "popped " << front << " " << back << ", first " << l1.at(0, position) << ", size=" << l1.size() << endl;
+
+    try {
+        l1.at(8);
+        cout << "test failed: reading past the end did not throw" << endl;
+    }
+    catch(out_of_range& e) {
+        cout << "reading past the end successfully threw std::out_of_range" << endl;
+    }
+
+    concurrent_fast_linked_list<int> empty;
+    cout << "Popping an empty list: expected false" << endl;
+    cout << (empty.try_pop_front(front) ? "true" : "false") << endl;
+}
+
+
+
+void test_many_threads() {
+    concurrent_fast_linked_list<long> l1;
+    atomic<long> popped_sum(0);
+    vector<thread> threads;
+
+    //each thread adds 1 to 100000 at one end, and removes as many elements as it can from the other end
+    for (int t = 0; t < 4; t++) {
+        threads.push_back(thread([&l1, &popped_sum, t]() {
+            long value;
+            for (long i = 1; i <= 100000; i++) {
+                if (t % 2 == 0) {
+                    l1.push_back(i);
+                    if (l1.try_pop_front(value)) {
+                        popped_sum += value;
+                    }
+                }
+                else {
+                    l1.push_front(i);
+                    if (l1.try_pop_back(value)) {
+                        popped_sum += value;
+                    }
+                }
+            }
+        }));
+    }
+    for (int t = 0; t < 4; t++) {
+        threads[t].join();
+    }
+
+    long value;
+    while (l1.try_pop_front(value)) {
+        popped_sum += value;
+    }
+    cout << "Four threads: expected every value popped once, sum = 20000200000" << endl;
+    cout << "sum = " << popped_sum << endl;
+}
+
+
+//largest capacity reached by any measured_pool
+size_t measured_pool_peak = 0;
+
+//node pool that records its largest capacity in measured_pool_peak
+template<typename Node>
+class measured_pool : public node_pool<Node> {
+public:
+    Node* allocate() {
+        Node* node = node_pool<Node>::allocate();
+        if (this->capacity() > measured_pool_peak) {
+            measured_pool_peak = this->capacity();
+        }
+        return node;
+    }
+};
+
+
+void test_queue_reuse() {
+    //used as a queue, nodes removed at the front are reused at the back, so the pool stops growing
+    concurrent_fast_linked_list<int, measured_pool> queue;
+    int value;
+    for (int i = 0; i < 10; i++) {
+        queue.push_back(i);
+    }
+    for (int i = 0; i < 1000; i++) {
+        queue.push_back(i);
+        queue.try_pop_front(value);
+    }
+    size_t warm_peak = measured_pool_peak;
+    for (int i = 0; i < 1000000; i++) {
+        queue.push_back(i);
+        queue.try_pop_front(value);
+    }
+    cout << "Queue of 10 after 1000000 more push_back and try_pop_front pairs: expected pool did not grow, size=10" << endl;
+    cout << "pool " << (measured_pool_peak == warm_peak ? "did not grow" : "grew") << " (" << warm_peak << " to " << measured_pool_peak << " nodes), size=" << queue.size() << endl;
+}
+
+
+int main() {
+    // test_single_thread();
+    // test_many_threads();
+    // test_queue_reuse();
+}
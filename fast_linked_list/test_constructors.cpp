@@ -0,0 +1,48 @@
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "fast_linked_list.cpp"
+
+using namespace std;
+using namespace utils;
+
+
+void test_initializer_list() {
+    fast_linked_list<int> l1 = {0, 10, 20, 30, 40};
+    cout << "Initializer list: equals {0, 10, 20, 30, 40}, size=5, last accessed index = 2, last accessed value = 20" << endl;
+    cout << l1 << endl;
+    cout << "size=" << l1.size() << endl;
+    cout << "last accessed index=" << l1.last_accessed_index() << endl;
+    cout << "last accessed value=" << l1.last_accessed_element() << endl;
+}
+
+
+
+void test_iterator_range() {
+    vector<int> values = {1, 2, 3, 4, 5, 6};
+    fast_linked_list<int> l1(values.begin() + 1, values.end());
+    cout << "Iterator range: equals {2, 3, 4, 5, 6}, last accessed value = 4" << endl;
+    cout << l1 << ", last accessed value = " << l1.last_accessed_element() << endl;
+
+    fast_linked_list<int> l2(values.begin(), values.begin());
+    cout << "Empty range: equals {}, size=0" << endl;
+    cout << l2 << ", size=" << l2.size() << endl;
+}
+
+
+
+void test_move_from_vector() {
+    vector<string> values = {"first", "second", "third", "fourth"};
+    fast_linked_list<string> l1(std::move(values));
+    cout << "Move from vector: equals {first, second, third, fourth}, last accessed value = third, vector strings empty" << endl;
+    cout << l1 << ", last accessed value = " << l1.last_accessed_element()
+        << ", vector strings " << (values[0].empty() ? "empty" : "not empty") << endl;
+}
+
+
+int main() {
+    // test_initializer_list();
+    // test_iterator_range();
+    // test_move_from_vector();
+}
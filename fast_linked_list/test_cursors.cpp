@@ -0,0 +1,81 @@
+#include <iostream>
+#include <stdexcept>
+#include "fast_linked_list.cpp"
+
+using namespace std;
+using namespace utils;
+
+
+void test_interleaved_readers() {
+    fast_linked_list<int> l1;
+    for (int i = 0; i < 1000; i++) {
+        l1.push_back(i);
+    }
+
+    //two readers walking through different halves of the list
+    int sum1 = 0;
+    int sum2 = 0;
+    for (int i = 0; i < 500; i++) {
+        sum1 += l1.at(i);
+        sum2 += l1.at(500 + i);
+    }
+    cout << "Interleaved readers: expected 124750 374750, last accessed index = 499" << endl;
+    cout << sum1 << " " << sum2 << ", last accessed index = " << l1.last_accessed_index() << endl;
+}
+
+
+
+void test_pinned_cursors() {
+    fast_linked_list<int> l1;
+    for (int i = 0; i < 10; i++) {
+        l1.push_back(i * 10);
+    }
+    l1.at(2);
+
+    int c1 = l1.pin_cursor(5);
+    int c2 = l1.pin_cursor(9);
+    cout << "Reading through cursors: expected 60 90, cursor indices 6 9, last accessed index = 2" << endl;
+    cout << l1.at_cursor(c1, 6) << " " << l1.at_cursor(c2, 9) << ", cursor indices "
+        << l1.cursor_index(c1) << " " << l1.cursor_index(c2) << ", last accessed index = " << l1.last_accessed_index() << endl;
+
+    l1.push_front(-10);
+    l1.pop_back();
+    cout << "After push_front and pop_back: expected cursor indices 7 9, values 60 80" << endl;
+    cout << "cursor indices " << l1.cursor_index(c1) << " " << l1.cursor_index(c2) << ", values "
+        << l1.at_cursor(c1, l1.cursor_index(c1)) << " " << l1.at_cursor(c2, l1.cursor_index(c2)) << endl;
+
+    l1.unpin_cursor(c1);
+    try {
+        l1.at_cursor(c1, 0);
+        cout << "test failed: reading through an unpinned cursor did not throw" << endl;
+    }
+    catch(invalid_argument& e) {
+        cout << "reading through an unpinned cursor successfully threw std::invalid_argument" << endl;
+    }
+    l1.unpin_cursor(c2);
+}
+
+
+
+void test_cursor_limit() {
+    fast_linked_list<int> l1;
+    l1.push_back(0);
+
+    for (int i = 0; i < 8; i++) {
+        l1.pin_cursor(0);
+    }
+    try {
+        l1.pin_cursor(0);
+        cout << "test failed: pinning a ninth cursor did not throw" << endl;
+    }
+    catch(length_error& e) {
+        cout << "pinning a ninth cursor successfully threw std::length_error" << endl;
+    }
+}
+
+
+int main() {
+    // test_interleaved_readers();
+    // test_pinned_cursors();
+    // test_cursor_limit();
+}
@@ -0,0 +1,61 @@
+#include <iostream>
+#include "indexed_fast_linked_list.cpp"
+
+using namespace std;
+using namespace utils;
+
+
+void test_insert_erase() {
+    indexed_fast_linked_list<int> l1;
+    for (int i = 0; i < 100; i += 10) {
+        l1.push_back(i);
+    }
+    l1.at(5);
+
+    l1.insert(2, 15);
+    l1.insert(0, -10);
+    l1.insert(l1.size(), 100);
+    cout << "Insertion: equals {-10, 0, 10, 15, 20... 90, 100}, size=13, last accessed index = 7, last accessed value = 50" << endl;
+    cout << l1 << endl;
+    cout << "size=" << l1.size() << endl;
+    cout << "last accessed index=" << l1.last_accessed_index() << endl;
+    cout << "last accessed value=" << l1.last_accessed_element() << endl;
+
+    l1.erase(3);
+    l1.erase(6);
+    cout << "Erasure of the last accessed element: equals {-10, 0, 10, 20, 30, 40, 60... 90, 100}, size=11, last accessed index = 6, last accessed value = 60" << endl;
+    cout << l1 << endl;
+    cout << "size=" << l1.size() << endl;
+    cout << "last accessed index=" << l1.last_accessed_index() << endl;
+    cout << "last accessed value=" << l1.last_accessed_element() << endl;
+
+    try {
+        l1.insert(12, 0);
+        cout << "test failed: insertion past the end did not throw" << endl;
+    }
+    catch(out_of_range& e) {
+        cout << "insertion past the end successfully threw std::out_of_range" << endl;
+    }
+}
+
+
+
+void test_large_random_access() {
+    indexed_fast_linked_list<int> l1;
+    for (int i = 0; i < 100000; i++) {
+        l1.push_back(i);
+    }
+    for (int i = 0; i < 1000; i++) {
+        l1.pop_front();
+    }
+    l1.insert(50000, -1);
+
+    cout << "Random access: expected 1000 50999 -1 51000 99999" << endl;
+    cout << l1.at(0) << " " << l1.at(49999) << " " << l1.at(50000) << " " << l1.at(50001) << " " << l1.at(l1.size() - 1) << endl;
+}
+
+
+int main() {
+    // test_insert_erase();
+    // test_large_random_access();
+}
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <iostream>
+#include "fast_linked_list.cpp"
+
+using namespace std;
+using namespace utils;
+
+
+void test_range_for() {
+    fast_linked_list<int> l1;
+    for (int i = 0; i < 10; i++) {
+        l1.push_back(i);
+    }
+    l1.at(3);
+
+    for (int& value : l1) {
+        value *= 10;
+    }
+    cout << "Range-for modification: equals {0, 10, 20... 90}, last accessed index = 3" << endl;
+    cout << l1 << ", last accessed index = " << l1.last_accessed_index() << endl;
+
+    const fast_linked_list<int>& constant_l1 = l1;
+    int sum = 0;
+    for (int value : constant_l1) {
+        sum += value;
+    }
+    cout << "Constant range-for sum: expected 450" << endl;
+    cout << sum << endl;
+}
+
+
+
+void test_reverse_iteration() {
+    fast_linked_list<int> l1;
+    for (int i = 0; i < 5; i++) {
+        l1.push_back(i);
+    }
+
+    cout << "Reverse iteration: expected 4 3 2 1 0" << endl;
+    for (fast_linked_list<int>::reverse_iterator it = l1.rbegin(); it != l1.rend(); ++it) {
+        cout << *it << " ";
+    }
+    cout << endl;
+
+    fast_linked_list<int> empty;
+    cout << "Empty list: expected begin == end and rbegin == rend" << endl;
+    cout << ((empty.begin() == empty.end()) ? "begin == end" : "begin != end") << " and "
+        << ((empty.rbegin() == empty.rend()) ? "rbegin == rend" : "rbegin != rend") << endl;
+}
+
+
+
+void test_algorithms() {
+    fast_linked_list<int> l1;
+    for (int i = 0; i < 10; i++) {
+        l1.push_back(i);
+    }
+
+    std::reverse(l1.begin(), l1.end());
+    cout << "std::reverse: equals {9, 8, 7... 0}" << endl;
+    cout << l1 << endl;
+
+    fast_linked_list<int>::const_iterator found = std::find(l1.cbegin(), l1.cend(), 4);
+    cout << "std::find and std::count_if: expected 4 5" << endl;
+    cout << *found << " " << std::count_if(l1.begin(), l1.end(), [](int value) { return value % 2 == 0; }) << endl;
+}
+
+
+int main() {
+    // test_range_for();
+    // test_reverse_iteration();
+    // test_algorithms();
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <string>
+#include <utility>
+#include "fast_linked_list.cpp"
+
+using namespace std;
+using namespace utils;
+
+
+/**
+ * String wrapper that counts how many times it has been copied
+ */
+struct counted_string {
+    static int copies;
+    string value;
+
+    counted_string(const char* value) : value(value) {}
+    counted_string(const counted_string& other) : value(other.value) { copies++; }
+    counted_string(counted_string&& other) : value(std::move(other.value)) {}
+    counted_string& operator=(const counted_string& other) { value = other.value; copies++; return *this; }
+    counted_string& operator=(counted_string&& other) { value = std::move(other.value); return *this; }
+};
+int counted_string::copies = 0;
+
+ostream& operator<<(ostream& output_stream, const counted_string& s) {
+    return output_stream << s.value;
+}
+
+
+fast_linked_list<counted_string> make_list() {
+    fast_linked_list<counted_string> l1;
+    l1.emplace_back("b");
+    l1.emplace_back("c");
+    l1.emplace_back("d");
+    l1.emplace_front("a");
+    l1.at(2);
+    return l1;
+}
+
+
+
+void test_emplace_and_rvalue_push() {
+    counted_string::copies = 0;
+
+    fast_linked_list<counted_string> l1 = make_list();
+    l1.emplace_last_accessed("x");
+    l1.push_back(counted_string("e"));
+    counted_string front("0");
+    l1.push_front(std::move(front));
+    l1.push_last_accessed(counted_string("y"));
+
+    cout << "Emplace and rvalue push: equals {0, a, b, y, x, c, d, e}, last accessed index = 3, copies = 0" << endl;
+    cout << l1 << ", last accessed index = " << l1.last_accessed_index() << ", copies = " << counted_string::copies << endl;
+}
+
+
+
+void test_move_constructor() {
+    fast_linked_list<counted_string> l1 = make_list();
+    int cursor = l1.pin_cursor(3);
+    counted_string::copies = 0;
+
+    fast_linked_list<counted_string> l2(std::move(l1));
+    cout << "Move constructor: equals {a, b, c, d}, last accessed index = 2, cursor index = 3, old list = {}, copies = 0" << endl;
+    cout << l2 << ", last accessed index = " << l2.last_accessed_index() << ", cursor index = " << l2.cursor_index(cursor)
+        << ", old list = " << l1 << ", copies = " << counted_string::copies << endl;
+
+    l1.emplace_back("reused");
+    cout << "Moved-from list is reusable: equals {reused}" << endl;
+    cout << l1 << endl;
+}
+
+
+
+void test_move_assign() {
+    fast_linked_list<counted_string> l1 = make_list();
+    fast_linked_list<counted_string> l2;
+    l2.emplace_back("old");
+    counted_string::copies = 0;
+
+    l2 = std::move(l1);
+    l2 = std::move(l2);
+    cout << "Move assignment: equals {a, b, c, d}, size=4, last accessed value = c, old list size=0, copies = 0" << endl;
+    cout << l2 << ", size=" << l2.size() << ", last accessed value = " << l2.last_accessed_element()
+        << ", old list size=" << l1.size() << ", copies = " << counted_string::copies << endl;
+
+    try {
+        l1.emplace_last_accessed("z");
+        cout << "test failed: emplacing at the last accessed element of an empty list did not throw" << endl;
+    }
+    catch(out_of_range& e) {
+        cout << "emplacing at the last accessed element of an empty list successfully threw std::out_of_range" << endl;
+    }
+}
+
+
+int main() {
+    // test_emplace_and_rvalue_push();
+    // test_move_constructor();
+    // test_move_assign();
+}
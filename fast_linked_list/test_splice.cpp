@@ -0,0 +1,140 @@
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "fast_linked_list.cpp"
+
+using namespace std;
+using namespace utils;
+
+
+void test_range_insert_erase() {
+    fast_linked_list<int> l1;
+    for (int i = 0; i < 100; i += 10) {
+        l1.push_back(i);
+    }
+    l1.at(5);
+
+    vector<int> values = {21, 22, 23};
+    l1.insert(3, values.begin(), values.end());
+    cout << "Range insertion: equals {0, 10, 20, 21, 22, 23, 30... 90}, size=13, last accessed index = 8, last accessed value = 50" << endl;
+    cout << l1 << endl;
+    cout << "size=" << l1.size() << endl;
+    cout << "last accessed index=" << l1.last_accessed_index() << endl;
+    cout << "last accessed value=" << l1.last_accessed_element() << endl;
+
+    l1.erase(7, 10);
+    cout << "Range erasure of the last accessed element: equals {0, 10, 20, 21, 22, 23, 30, 70, 80, 90}, size=10, last accessed index = 7, last accessed value = 70" << endl;
+    cout << l1 << endl;
+    cout << "size=" << l1.size() << endl;
+    cout << "last accessed index=" << l1.last_accessed_index() << endl;
+    cout << "last accessed value=" << l1.last_accessed_element() << endl;
+
+    try {
+        l1.erase(5, 20);
+        cout << "test failed: erasing past the end did not throw" << endl;
+    }
+    catch(out_of_range& e) {
+        cout << "erasing past the end successfully threw std::out_of_range" << endl;
+    }
+}
+
+
+
+void test_splice_lists() {
+    fast_linked_list<int> l1;
+    fast_linked_list<int> l2;
+    fast_linked_list<int> l3;
+    for (int i = 0; i < 5; i++) {
+        l1.push_back(i);
+        l2.push_back(10 + i);
+        l3.push_back(20 + i);
+    }
+    l1.at(2);
+
+    l1.splice_back(l2);
+    l1.splice_front(l3);
+    cout << "Splicing to the back and front: equals {20... 24, 0... 4, 10... 14}, size=15, last accessed index = 7, other lists empty" << endl;
+    cout << l1 << endl;
+    cout << "size=" << l1.size() << endl;
+    cout << "last accessed index=" << l1.last_accessed_index() << endl;
+    cout << "other lists: " << l2 << " " << l3 << endl;
+
+    fast_linked_list<int> l4;
+    l4.push_back(-1);
+    l4.push_back(-2);
+    l1.splice_last_accessed(l4);
+    cout << "Splicing to the last accessed: equals {20... 24, 0, 1, -1, -2, 2, 3, 4, 10... 14}, last accessed index = 7, last accessed value = -1" << endl;
+    cout << l1 << endl;
+    cout << "last accessed index=" << l1.last_accessed_index() << endl;
+    cout << "last accessed value=" << l1.last_accessed_element() << endl;
+
+    l4.splice(0, l1, 5, 11);
+    cout << "Splicing a range: equals {0, 1, -1, -2, 2, 3} and {20... 24, 4, 10... 14}" << endl;
+    cout << l4 << " and " << l1 << endl;
+
+    try {
+        l1.splice_back(l1);
+        cout << "test failed: splicing a list into itself did not throw" << endl;
+    }
+    catch(invalid_argument& e) {
+        cout << "splicing a list into itself successfully threw std::invalid_argument" << endl;
+    }
+}
+
+
+void test_repeated_range_inserts() {
+    //small ranges reuse freed nodes and the current chunk, and a large range still gets a large chunk
+    fast_linked_list<int> l1;
+    vector<int> pair_values = {1, 2};
+    for (int i = 0; i < 1000; i++) {
+        l1.insert(l1.size(), pair_values.begin(), pair_values.end());
+        if (i % 3 == 0) {
+            l1.erase(0, 2);
+        }
+    }
+    vector<int> many(5000, 3);
+    l1.insert(l1.size() / 2, many.begin(), many.end());
+
+    long long sum = 0;
+    for (int value : l1) {
+        sum += value;
+    }
+    cout << "Repeated range insertion: size=6332, sum=16998" << endl;
+    cout << "size=" << l1.size() << ", sum=" << sum << endl;
+}
+
+
+
+void test_splice_churned_lists() {
+    //pools with several chunks and freed nodes merge in constant time, and their freed nodes are reused afterwards
+    fast_linked_list<int> combined;
+    for (int list = 0; list < 4; list++) {
+        fast_linked_list<int> churned;
+        for (int i = 0; i < 3000; i++) {
+            churned.push_back(i);
+        }
+        for (int i = 0; i < 2990; i++) {
+            churned.pop_front();
+        }
+        combined.splice_back(churned);
+    }
+    for (int i = 0; i < 12000; i++) {
+        combined.push_back(1);
+    }
+
+    long long sum = 0;
+    for (int value : combined) {
+        sum += value;
+    }
+    cout << "Splicing churned lists: size=12040, sum=131780" << endl;
+    cout << "size=" << combined.size() << ", sum=" << sum << endl;
+}
+
+
+
+int main() {
+    // test_range_insert_erase();
+    // test_splice_lists();
+    // test_repeated_range_inserts();
+    // test_splice_churned_lists();
+}
@@ -0,0 +1,95 @@
+#include <iostream>
+#include "unrolled_fast_linked_list.cpp"
+
+using namespace std;
+using namespace utils;
+
+
+void test_node_boundaries() {
+    //4 elements per node, so most operations cross node boundaries
+    unrolled_fast_linked_list<int, 4> l1;
+    for (int i = 0; i < 100; i += 10) {
+        l1.push_back(i);
+    }
+    l1.push_front(-10);
+
+    cout << "Pushes across nodes: equals {-10, 0, 10, 20... 90}, size=11, last accessed index = 1, last accessed value = 0" << endl;
+    cout << l1 << endl;
+    cout << "size=" << l1.size() << endl;
+    cout << "last accessed index=" << l1.last_accessed_index() << endl;
+    cout << "last accessed value=" << l1.last_accessed_element() << endl;
+
+    for (int i = 0; i < l1.size(); i++) {
+        l1.at(i);
+    }
+    cout << "Sequential reads: last accessed index = 9, last accessed value = 80" << endl;
+    cout << "last accessed index=" << l1.last_accessed_index() << endl;
+    cout << "last accessed value=" << l1.last_accessed_element() << endl;
+}
+
+
+
+void test_middle_changes() {
+    unrolled_fast_linked_list<int, 4> l1;
+    for (int i = 0; i < 8; i++) {
+        l1.push_back(i);
+    }
+
+    //index 3 is the final element of a full node, so adding there splits the node
+    l1.at(3);
+    l1.push_last_accessed(100);
+    l1.push_last_accessed(200);
+    cout << "Middle additions: equals {0, 1, 2, 200, 100, 3, 4, 5, 6, 7}, size=10, last accessed index = 3, last accessed value = 200" << endl;
+    cout << l1 << endl;
+    cout << "size=" << l1.size() << endl;
+    cout << "last accessed index=" << l1.last_accessed_index() << endl;
+    cout << "last accessed value=" << l1.last_accessed_element() << endl;
+
+    l1.pop_last_accessed();
+    l1.pop_last_accessed();
+    l1.pop_last_accessed();
+    cout << "Middle removals: equals {0, 1, 2, 4, 5, 6, 7}, size=7, last accessed index = 3, last accessed value = 4" << endl;
+    cout << l1 << endl;
+    cout << "size=" << l1.size() << endl;
+    cout << "last accessed index=" << l1.last_accessed_index() << endl;
+    cout << "last accessed value=" << l1.last_accessed_element() << endl;
+}
+
+
+
+void test_copying() {
+    vector<int> initial;
+    for (int i = 0; i < 100; i += 10) {
+        initial.push_back(i);
+    }
+    unrolled_fast_linked_list<int, 4> l1 = unrolled_fast_linked_list<int, 4>(initial);
+
+    unrolled_fast_linked_list<int, 4> l2 = l1;
+    l2.set(1, 1000);
+    cout << "Copy constructor: equals {0, 1000, 20... 90}, size=10, last accessed index = 1, last accessed value = 1000" << endl;
+    cout << l2 << endl;
+    cout << "size=" << l2.size() << endl;
+    cout << "last accessed index=" << l2.last_accessed_index() << endl;
+    cout << "last accessed value=" << l2.last_accessed_element() << endl;
+
+    l2 = l1;
+    cout << "Assignment: equals {0, 10, 20... 90}, size=10, last accessed index = 5, last accessed value = 50, lists equal (1)" << endl;
+    cout << l2 << endl;
+    cout << "size=" << l2.size() << endl;
+    cout << "last accessed index=" << l2.last_accessed_index() << endl;
+    cout << "last accessed value=" << l2.last_accessed_element() << endl;
+    cout << "equal=" << (l1 == l2) << endl;
+
+    unrolled_fast_linked_list<int, 4> empty;
+    l2 = empty;
+    cout << "Assignment to empty list: equals {}, size=0" << endl;
+    cout << l2 << endl;
+    cout << "size=" << l2.size() << endl;
+}
+
+
+int main() {
+    // test_node_boundaries();
+    // test_middle_changes();
+    // test_copying();
+}
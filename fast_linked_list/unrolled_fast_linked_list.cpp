@@ -0,0 +1,1068 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fast_linked_list.cpp"
+#include "node_allocator.cpp"
+
+namespace utils {
+
+
+
+
+/**
+ * Unrolled version of the Fast Linked List. Each node holds up to `NodeCapacity` elements in an array, instead of exactly one element.
+ *
+ * Supports the same operations as `fast_linked_list`, with the same last accessed element behavior:
+ * The list maintains a reference to the most recently used element for faster operations.
+ * The previously used element can be changed by reading or writing to a list element that is not the first or last element.
+ * If the previously accessed element is removed, the new previous element becomes the one at the start or end of the list.
+ *
+ * Storing several elements per node divides the number of node links by up to `NodeCapacity`,
+ * which greatly reduces memory use for small element types. Searching for an index skips whole nodes at a time.
+ *
+ * Adding or removing an element in the middle of a node shifts the other elements of that node.
+ * A full node is split in half to make room. After a removal, a node is merged with its successor if both fit in one node.
+ *
+ * @param T datatype of the stored items
+ * @param NodeCapacity maximum number of elements in one node. Must be positive. Default: enough elements to fill 64 bytes, but at least 4
+ * @param NodeAllocator allocation policy for the list's nodes. Default: `node_pool`
+ */
+template<typename T, int32_t NodeCapacity = (sizeof(T) * 4 > 64) ? 4 : (int32_t)(64 / sizeof(T)),
+    template<typename> class NodeAllocator = node_pool>
+class unrolled_fast_linked_list {
+    static_assert(NodeCapacity > 0, "Node capacity must be positive");
+
+private:
+    /**
+     * A node in an unrolled fast linked list, containing up to `NodeCapacity` elements,
+     * a pointer to a predecessor node (`prev`), and a pointer to a successor node (`next`).
+     *
+     * Only the first `count` element slots hold elements. A node in the list always holds at least one element.
+     *
+     * A node at the start of the list has a `nullptr` predecessor.
+     * A node at the end of the list has a `nullptr` successor.
+     */
+    struct Node {
+        Node* prev;
+        Node* next;
+        int32_t count;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[NodeCapacity];
+
+        /**
+         * @return pointer to the node's first element slot
+         */
+        T* elements() {
+            return reinterpret_cast<T*>(slots);
+        }
+    };
+
+
+    /**
+     * Pointer to the starting node
+     */
+    Node* start_node;
+
+    /**
+     * Pointer to the ending node
+     */
+    Node* end_node;
+
+    /**
+     * Pointer to the node holding the last element used
+     */
+    Node* last_used_node;
+
+    /**
+     * Position of the last element used inside `last_used_node`
+     */
+    int32_t last_used_offset;
+
+    /**
+     * Index number (0-based indexing) of the last element used
+     */
+    int32_t last_used_index;
+
+    /**
+     * Number of elements in the list. Non-negative.
+     */
+    int32_t n_elements;
+
+    /**
+     * Source of memory for all nodes in the list
+     */
+    NodeAllocator<Node> node_allocator;
+
+
+
+    /**
+     * Returns a pointer to a new node with no elements. The new node's predecessor and successor are `nullptr`.
+     *
+     * Private helper method.
+     *
+     * @return pointer to the new node
+     */
+    Node* create_node();
+
+    /**
+     * Destroys all elements in `node`, then gives the node's memory back to the node allocator.
+     *
+     * Private helper method.
+     *
+     * @param node node to destroy. Cannot be `nullptr`
+     */
+    void destroy_node(Node* node);
+
+    /**
+     * Removes `node` from the chain of nodes, then destroys it.
+     *
+     * Private helper method.
+     *
+     * @param node node to remove. Must be in this list
+     */
+    void unlink_node(Node* node);
+
+    /**
+     * Puts `value` at position `offset` of `node`, moving the node's elements at or after `offset` one position later.
+     *
+     * Private helper method.
+     *
+     * @param node node to add to. Must not be full
+     * @param offset position to add at. Must be on the interval [ 0, `node->count` ]
+     * @param value value to add
+     */
+    void insert_in_node(Node* node, int32_t offset, const T& value);
+
+    /**
+     * Removes the element at position `offset` of `node`, moving the node's elements after `offset` one position earlier.
+     *
+     * Private helper method.
+     *
+     * @param node node to remove from
+     * @param offset position to remove. Must be on the interval [ 0, `node->count`-1 ]
+     */
+    void erase_in_node(Node* node, int32_t offset);
+
+    /**
+     * Moves the second half of `node`'s elements into a new node placed directly after `node`.
+     *
+     * Private helper method.
+     *
+     * @param node node to split
+     */
+    void split_node(Node* node);
+
+    /**
+     * Moves all elements of `node->next` to the end of `node`, then removes `node->next`.
+     *
+     * Private helper method.
+     *
+     * @param node node to merge into. Its successor must exist, and both nodes' elements must fit in one node
+     */
+    void merge_with_next(Node* node);
+
+    /**
+     * Returns a pointer to the node containing list index `index`, and sets `offset` to the index's position inside that node.
+     *
+     * Private helper method.
+     *
+     * @param index index to get in the list. Must be on the interval [ 0, `list.size()`-1 ]
+     * @param offset output: position of `index` inside the returned node
+     * @return pointer to the node containing the index
+     */
+    Node* get_list_position(int32_t index, int32_t& offset) const;
+
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+public:
+
+    /**
+     * Creates an empty Unrolled Fast Linked List.
+     */
+    unrolled_fast_linked_list() {
+        start_node = nullptr;
+        end_node = nullptr;
+        last_used_node = nullptr;
+
+        last_used_offset = 0;
+        last_used_index = 0;
+        n_elements = 0;
+    }
+
+
+
+    /**
+     * Creates an Unrolled Fast Linked List containing the items in `initial_contents` in order.
+     *
+     * The last used index is set to `initial_contents.size() / 2`.
+     *
+     * @param initial_contents std::vector of items to load the list with
+     */
+    unrolled_fast_linked_list(const std::vector<T>& initial_contents) : unrolled_fast_linked_list() {
+        for(int32_t i = 0; i < (int32_t)initial_contents.size(); i++) {
+            this->push_back(initial_contents[i]);
+        }
+
+        if(n_elements > 0) {
+            last_used_node = get_list_position(n_elements / 2, last_used_offset);
+            last_used_index = n_elements / 2;
+        }
+    }
+
+
+
+    /**
+     * Copies `other_list` into a new list.
+     * @param other_list list to copy into this list
+     */
+    unrolled_fast_linked_list(const unrolled_fast_linked_list& other_list) : unrolled_fast_linked_list() {
+        *this = other_list;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //METHOD DECLARATIONS
+
+
+    /**
+     * Returns a reference to the value at index `index` (0-based indexing).
+     * If `setting_last_accessed` is true, the last accessed value will be set to the one at `index`.
+     *
+     * If `index` is negative or at least the list's size, throws `std::out_of_range`.
+     *
+     * The last accessed value will *not* be changed if the first or last index is retrieved,
+     * regardless of the value of `setting_last_accessed`.
+     *
+     * @param index index to get value from
+     * @param setting_last_accessed whether to change the last accessed value to the one at `index`
+     * @return value at the specified index
+     * @throws `std::out_of_range` if `index` is out of the array's bounds
+     *
+     */
+    T& at(int32_t index, bool setting_last_accessed = true);
+
+    /**
+     * Returns the index number of the element (0-based indexing) last retrieved or modified.
+     *
+     * If the list is empty, throws a `std::out_of_range`.
+     *
+     * @return index of the element marked for quick access
+     * @throws `std::out_of_range` if the list is empty
+     */
+    int32_t last_accessed_index() const;
+
+    /**
+     * Returns a reference to the element last retrieved or modified.
+     *
+     * If the list is empty, throws `std::out_of_range`.
+     *
+     * @return reference to the previous element retrieved or edited
+     * @throws `std::out_of_range` if the list is empty
+     */
+    T& last_accessed_element();
+
+    /**
+     * Removes the final element of the list.
+     *
+     * If the last accessed value is the final index,
+     * the new last accessed value becomes the new end of the list.
+     *
+     * Throws `std::out_of_range` if the list is empty.
+     *
+     * @throws `std::out_of_range` if the list is empty
+     */
+    void pop_back();
+
+    /**
+     * Removes the first element of the list.
+     *
+     * If the last accessed value is the first index,
+     * the new last accessed value becomes the new front of the list.
+     *
+     * Throws `std::out_of_range` if the list is empty.
+     *
+     * @throws `std::out_of_range` if the list is empty
+     */
+    void pop_front();
+
+    /**
+     * Removes the last accessed element.
+     *
+     * The new last accessed element becomes the element after the removed element.
+     * If the last accessed element is the final element, the new last accessed element becomes
+     * the new end of the list.
+     *
+     * If the list is empty, throws `std::out_of_range`.
+     *
+     * @throws `std::out_of_range` if the list is empty
+     */
+    void pop_last_accessed();
+
+    /**
+     * Adds `new_value` to the end of the list.
+     * @param new_value value to add to the end
+     *
+    */
+    void push_back(T new_value);
+
+    /**
+     * Adds `new_value` to the front of the list.
+     *
+     * The last accessed index will increase by 1. The last accessed value remains the same.
+     *
+     * @param new_value value to add to the end
+     *
+     */
+    void push_front(T new_value);
+
+    /**
+     * Adds `new_value` at the index of the last accessed element.
+     *
+     * All elements at or after the last acccessed element will have their indices increase by 1.
+     *
+     * The newly added element becomes the new last accessed element.
+     *
+     * If the list is empty, throws `std::out_of_range`.
+     *
+     * @param new_value value to add to the last accessed
+     * @throws `std::out_of_range` if the list is empty
+     */
+    void push_last_accessed(T new_value);
+
+
+    /**
+     * Sets the value at index `index` (0-based indexing) to `new_value`.
+     * If `setting_last_accessed` is true, the last accessed index will be set to `index`.
+     *
+     * If `index` is negative or at least the list's size, throws `std::out_of_range`.
+     *
+     * The last accessed value will *not* be changed if the first or last index is set,
+     * regardless of the value of `setting_last_accessed`.
+     *
+     * @param index index to change in the list
+     * @param new_value value to set
+     * @param setting_last_accessed whether to change the last accessed value to the one at `index`. Default: true
+     * @throws `std::out_of_range` if `index` is out of the array's bounds
+     *
+     */
+    void set(int32_t index, T new_value, bool setting_last_accessed = true);
+
+    /**
+     *
+     * @return the number of elements in the list
+     */
+    int32_t size() const;
+
+    /**
+     * Removes all elements from the list.
+     */
+    void clear();
+
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //OPERATOR OVERLOADS
+
+    /**
+     * Copies `other_list` into this Unrolled Fast Linked List object, returning a reference to this list after the modification.
+     *
+     * The location of `other_list`'s last accessed value is also copied.
+     *
+     * @param other_list list to copy into this list
+     * @return reference to this (modified) list
+     */
+    unrolled_fast_linked_list& operator=(const unrolled_fast_linked_list& other_list) {
+        //self-assignment check
+        if(this == &other_list) {
+            return *this;
+        }
+
+        clear();
+
+        for(Node* other_current = other_list.start_node; other_current != nullptr; other_current = other_current->next) {
+            for(int32_t i = 0; i < other_current->count; i++) {
+                this->push_back(other_current->elements()[i]);
+            }
+        }
+
+        //copy the last accessed index. The copy's nodes are packed full, so the position is looked up again
+        if(n_elements > 0) {
+            last_used_node = get_list_position(other_list.last_used_index, last_used_offset);
+            last_used_index = other_list.last_used_index;
+        }
+
+        return *this;
+    }
+
+
+
+    /**
+     * Returns `true` if this list and `other_list` have the same number of elements,
+     * and each corresponding element is equal.
+     * Returns `false` otherwise.
+     *
+     * @param other_list list to compare to
+     * @return whether the lists are equal (length and elements)
+     */
+    bool operator==(const unrolled_fast_linked_list& other_list) const {
+        //check size
+        if(other_list.n_elements != this->n_elements) {
+            return false;
+        }
+
+        Node* current_node = this->start_node;
+        int32_t current_offset = 0;
+        Node* other_current_node = other_list.start_node;
+        int32_t other_current_offset = 0;
+
+        //check each element. Node layouts may differ, so each list advances separately
+        for(int32_t i = 0; i < n_elements; i++) {
+            if(current_offset == current_node->count) {
+                current_node = current_node->next;
+                current_offset = 0;
+            }
+            if(other_current_offset == other_current_node->count) {
+                other_current_node = other_current_node->next;
+                other_current_offset = 0;
+            }
+
+            if(current_node->elements()[current_offset] != other_current_node->elements()[other_current_offset]) {
+                return false;
+            }
+
+            current_offset++;
+            other_current_offset++;
+        }
+
+        return true;
+    }
+
+
+
+    /**
+     * Returns a non-constant reference to the value at index `index` (0-based indexing), and sets the last accessed value to the one at `index`.
+     * If `index` is negative or at least the list's size, throws `out_of_range`.
+     *
+     * The last accessed value will *not* be changed if the first or last index is retrieved.
+     *
+     * Equivalent to `{listName}.at(index, true)`.
+     *
+     * @param index the index to get the value from
+     * @return reference to value at index `index`
+     * @throws `out_of_range` if `index` is out of the array's bounds
+     *
+     */
+    T& operator[](int32_t index) {
+        return at(index, true);
+    }
+
+
+
+    /**
+     * Exports `ufll` to `output_stream`, returning a reference to `output_stream` with `ufll` inside.
+     *
+     * The contents of `ufll` are surrounded in curly braces and separated by commas.
+     *
+     * @param output_stream stream to send the list into
+     * @param ufll list to export
+     * @return reference to `output_stream` with `ufll` inside
+     */
+    template<typename CharT, typename Traits, typename Tp, int32_t Capacity, template<typename> class Alloc>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const unrolled_fast_linked_list<Tp, Capacity, Alloc>& ufll);
+
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////
+    //DESTRUCTOR
+
+
+    /**
+     * Properly destroys an Unrolled Fast Linked List.
+     */
+    ~unrolled_fast_linked_list() {
+        clear();
+    }
+};
+
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+//METHOD DEFINITIONS
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+typename unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::Node* unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::create_node() {
+    Node* new_node = ::new (static_cast<void*>(node_allocator.allocate())) Node;
+    new_node->prev = nullptr;
+    new_node->next = nullptr;
+    new_node->count = 0;
+    return new_node;
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::destroy_node(Node* node) {
+    assert((node != nullptr && "INTERNAL ERROR- Cannot destroy a null node"));
+
+    for(int32_t i = 0; i < node->count; i++) {
+        node->elements()[i].~T();
+    }
+    node->~Node();
+    node_allocator.deallocate(node);
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::unlink_node(Node* node) {
+    //reconnect the neighbors, or move the ends of the list
+    if(node->prev != nullptr) {
+        node->prev->next = node->next;
+    }
+    else {
+        start_node = node->next;
+    }
+
+    if(node->next != nullptr) {
+        node->next->prev = node->prev;
+    }
+    else {
+        end_node = node->prev;
+    }
+
+    destroy_node(node);
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::insert_in_node(Node* node, int32_t offset, const T& value) {
+    assert((node->count < NodeCapacity && "INTERNAL ERROR- Cannot add to a full node"));
+    assert((offset >= 0 && offset <= node->count && "INTERNAL ERROR- Node offset out of range"));
+
+    T* elems = node->elements();
+
+    //adding after the final element: nothing to move
+    if(offset == node->count) {
+        ::new (static_cast<void*>(elems + offset)) T(value);
+    }
+    //otherwise, move the final element into the empty slot, then shift the rest over by one
+    else {
+        ::new (static_cast<void*>(elems + node->count)) T(std::move(elems[node->count - 1]));
+        std::move_backward(elems + offset, elems + node->count - 1, elems + node->count);
+        elems[offset] = value;
+    }
+
+    node->count++;
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::erase_in_node(Node* node, int32_t offset) {
+    assert((offset >= 0 && offset < node->count && "INTERNAL ERROR- Node offset out of range"));
+
+    T* elems = node->elements();
+    std::move(elems + offset + 1, elems + node->count, elems + offset);
+    elems[node->count - 1].~T();
+
+    node->count--;
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::split_node(Node* node) {
+    Node* new_node = create_node();
+
+    //move the second half of the elements into the new node
+    int32_t keep_count = node->count / 2;
+    T* elems = node->elements();
+    for(int32_t i = keep_count; i < node->count; i++) {
+        ::new (static_cast<void*>(new_node->elements() + new_node->count)) T(std::move(elems[i]));
+        new_node->count++;
+        elems[i].~T();
+    }
+    node->count = keep_count;
+
+    //put the new node after the old one
+    new_node->prev = node;
+    new_node->next = node->next;
+    if(node->next != nullptr) {
+        node->next->prev = new_node;
+    }
+    else {
+        end_node = new_node;
+    }
+    node->next = new_node;
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::merge_with_next(Node* node) {
+    Node* next_node = node->next;
+    assert((next_node != nullptr && "INTERNAL ERROR- Cannot merge the final node"));
+    assert((node->count + next_node->count <= NodeCapacity && "INTERNAL ERROR- Merged nodes must fit in one node"));
+
+    //move the successor's elements over, then remove the empty successor
+    T* next_elems = next_node->elements();
+    for(int32_t i = 0; i < next_node->count; i++) {
+        ::new (static_cast<void*>(node->elements() + node->count)) T(std::move(next_elems[i]));
+        node->count++;
+        next_elems[i].~T();
+    }
+    next_node->count = 0;
+
+    unlink_node(next_node);
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+typename unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::Node* unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::get_list_position(int32_t index, int32_t& offset) const {
+    assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+    assert((index >= 0 && index < n_elements && "INTERNAL ERROR- index is out of bounds"));
+    assert((last_used_node != nullptr && "INTERNAL ERROR- Last accessed node cannot be null"));
+    assert((last_used_index >= 0 && last_used_index < n_elements && "INTERNAL ERROR- Last accessed index is out of list's bounds"));
+
+    //Determine the start node, and the list index of that node's first element
+    Node* current_node = start_node;
+    int32_t current_base = 0;
+
+    //Past last accessed index: compare last accessed index and end
+    if(index > last_used_index) {
+        //closer to last accessed index: start from last accessed
+        if(distance(index, last_used_index) < distance(index, n_elements-1)) {
+            current_node = last_used_node;
+            current_base = last_used_index - last_used_offset;
+        }
+        //closer to end: start from end
+        else {
+            current_node = end_node;
+            current_base = n_elements - end_node->count;
+        }
+    }
+    //At or before last accessed: compare start and last accessed
+    else {
+        //closer to last accessed index: start from last accessed
+        if(distance(index, last_used_index) < distance(index, 0)) {
+            current_node = last_used_node;
+            current_base = last_used_index - last_used_offset;
+        }
+        //closer to start: start from the start (already set in initialization)
+    }
+
+    //Move whole nodes at a time toward the desired index. At most one of these loops runs
+    while(index >= current_base + current_node->count) {
+        current_base += current_node->count;
+        current_node = current_node->next;
+    }
+    while(index < current_base) {
+        current_node = current_node->prev;
+        current_base -= current_node->count;
+    }
+
+    offset = index - current_base;
+    return current_node;
+}
+
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+T& unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::at(int32_t index, bool setting_last_accessed) {
+    //check index range
+    if(!(index >= 0 && index < n_elements)) {
+        throw std::out_of_range("Element retrieval index must be at least 0 and less than the array's size");
+    }
+
+    //Get node at the desired position
+    int32_t offset;
+    Node* position = get_list_position(index, offset);
+
+    //Set last accessed, if selected and the user didn't get the first or last index
+    if(setting_last_accessed && !(index==0 || index==n_elements-1)) {
+        last_used_node = position;
+        last_used_offset = offset;
+        last_used_index = index;
+    }
+
+    return position->elements()[offset];
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+inline int32_t unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::last_accessed_index() const {
+    //check for empty list
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot access the last accessed index of an empty list");
+    }
+    //check index range
+    assert((last_used_index >= 0 && last_used_index < n_elements && "INTERNAL ERROR- Last accessed index out of range"));
+
+    return last_used_index;
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+inline T& unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::last_accessed_element() {
+    //check for empty list
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot access the last used element of an empty list");
+    }
+    //check index range
+    assert((last_used_index >= 0 && last_used_index < n_elements && "INTERNAL ERROR- Last accessed index out of range"));
+
+    return last_used_node->elements()[last_used_offset];
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::pop_back() {
+    assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot remove elements from the back of an empty list");
+    }
+
+    //remove the final element, and the final node if it becomes empty
+    erase_in_node(end_node, end_node->count - 1);
+    if(end_node->count == 0) {
+        unlink_node(end_node);
+    }
+
+    n_elements--;
+
+    //change last accessed if needed
+    if(n_elements == 0) {
+        last_used_node = nullptr;
+        last_used_offset = 0;
+        last_used_index = 0;
+    }
+    else if(last_used_index >= n_elements) {
+        last_used_node = end_node;
+        last_used_offset = end_node->count - 1;
+        last_used_index = n_elements - 1;
+    }
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::pop_front() {
+    assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot remove elements from the front of an empty list");
+    }
+
+    //remove the first element, and the first node if it becomes empty
+    bool last_used_in_start = (last_used_node == start_node);
+    erase_in_node(start_node, 0);
+    if(start_node->count == 0) {
+        unlink_node(start_node);
+    }
+
+    n_elements--;
+
+    if(n_elements == 0) {
+        last_used_node = nullptr;
+        last_used_offset = 0;
+        last_used_index = 0;
+    }
+    //move last accessed down one index. Elements of the old start node moved one position earlier
+    else if(last_used_index > 0) {
+        last_used_index -= 1;
+        if(last_used_in_start) {
+            last_used_offset -= 1;
+        }
+    }
+    //if last accessed is at the start, move the pointer up
+    else {
+        last_used_node = start_node;
+        last_used_offset = 0;
+    }
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::pop_last_accessed() {
+
+    //assertions
+    assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+
+    //no elements: throw exception
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot remove the last accessed element of an empty list");
+    }
+    assert((last_used_index >= 0 && last_used_index < n_elements && "INTERNAL ERROR- Last accessed index out of range"));
+
+    //last accessed at start: essentially pop front
+    if(last_used_index == 0) {
+        pop_front();
+        return;
+    }
+    //last accessed at end: essentially pop back
+    else if(last_used_index == n_elements-1) {
+        pop_back();
+        return;
+    }
+
+    //last accessed in middle: remove it, then merge its node with the successor if both fit in one node
+    Node* node = last_used_node;
+    int32_t offset = last_used_offset;
+    Node* next_node = node->next;
+
+    erase_in_node(node, offset);
+    if(node->count == 0) {
+        unlink_node(node);
+        node = next_node;
+        offset = 0;
+    }
+    else if(next_node != nullptr && node->count + next_node->count <= NodeCapacity) {
+        merge_with_next(node);
+    }
+
+    n_elements--;
+
+    //the new last accessed element is the one after the removed element, at the same index
+    if(offset == node->count) {
+        node = node->next;
+        offset = 0;
+    }
+    last_used_node = node;
+    last_used_offset = offset;
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::push_back(T new_value) {
+    assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+
+    //no room in the final node: add a new final node
+    if(end_node == nullptr || end_node->count == NodeCapacity) {
+        Node* new_node = create_node();
+
+        if(end_node == nullptr) {
+            start_node = new_node;
+        }
+        else {
+            end_node->next = new_node;
+            new_node->prev = end_node;
+        }
+        end_node = new_node;
+    }
+
+    insert_in_node(end_node, end_node->count, new_value);
+
+    //no elements in list: the new element is the last accessed
+    if(n_elements == 0) {
+        last_used_node = start_node;
+        last_used_offset = 0;
+        last_used_index = 0;
+    }
+
+    n_elements++;
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::push_front(T new_value) {
+    assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+
+    //no room in the first node: add a new first node
+    if(start_node == nullptr || start_node->count == NodeCapacity) {
+        Node* new_node = create_node();
+
+        if(start_node == nullptr) {
+            end_node = new_node;
+        }
+        else {
+            start_node->prev = new_node;
+            new_node->next = start_node;
+        }
+        start_node = new_node;
+    }
+
+    insert_in_node(start_node, 0, new_value);
+
+    //no elements: the new element is the last accessed
+    if(n_elements == 0) {
+        last_used_node = start_node;
+        last_used_offset = 0;
+        last_used_index = 0;
+    }
+    //elements: the last accessed element moved one index later, and one position later if it shares the first node
+    else {
+        if(last_used_node == start_node) {
+            last_used_offset++;
+        }
+        last_used_index++;
+    }
+
+    n_elements++;
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::push_last_accessed(T new_value) {
+    assert((n_elements >= 0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+
+    //no elements: throw exception
+    if(n_elements == 0) {
+        throw std::out_of_range("Cannot add values in front of the last used element, in an empty list");
+    }
+    assert((last_used_index>=0 && last_used_index<n_elements && "INTERNAL ERROR- Last accessed index out of range"));
+
+    //last accessed at start: essentially push front
+    if(last_used_index == 0) {
+        push_front(new_value);
+
+        //reconfigure last accessed
+        last_used_node = start_node;
+        last_used_offset = 0;
+        last_used_index = 0;
+    }
+    //last accessed at end: essentially push back
+    else if(last_used_index == n_elements-1) {
+        push_back(new_value);
+
+        //reconfigure last accessed
+        last_used_node = end_node;
+        last_used_offset = end_node->count - 1;
+        last_used_index = n_elements - 1;
+    }
+    //last accessed in middle: add to the last accessed, splitting its node if it is full
+    else {
+        Node* node = last_used_node;
+        int32_t offset = last_used_offset;
+
+        if(node->count == NodeCapacity) {
+            split_node(node);
+            if(offset > node->count) {
+                offset -= node->count;
+                node = node->next;
+            }
+        }
+
+        insert_in_node(node, offset, new_value);
+
+        //fix last accessed
+        last_used_node = node;
+        last_used_offset = offset;
+
+        n_elements++;
+    }
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::set(int32_t index, T new_value, bool setting_last_accessed) {
+    if(!(index>=0 && index<n_elements)) {
+        throw std::out_of_range("Index must be at least 0 and less than the list's size");
+    }
+
+    //Find the node and position of the specified index
+    int32_t offset;
+    Node* pos = get_list_position(index, offset);
+
+    //Reconfigure last accessed, if desired and the value set is not the first or last index
+    if(setting_last_accessed && !(index==0 || index==n_elements-1)) {
+        last_used_node = pos;
+        last_used_offset = offset;
+        last_used_index = index;
+    }
+
+    //Update the element
+    pos->elements()[offset] = new_value;
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+inline int32_t unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::size() const {
+    return n_elements;
+}
+
+
+
+template<typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+void unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>::clear() {
+    Node* current = start_node;
+    while(current != nullptr) {
+        Node* delete_node = current;
+        current = current->next;
+        destroy_node(delete_node);
+    }
+
+    start_node = nullptr;
+    end_node = nullptr;
+    last_used_node = nullptr;
+
+    last_used_offset = 0;
+    last_used_index = 0;
+    n_elements = 0;
+}
+
+
+
+template<typename CharT, typename Traits, typename T, int32_t NodeCapacity, template<typename> class NodeAllocator>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const unrolled_fast_linked_list<T, NodeCapacity, NodeAllocator>& ufll) {
+    assert((ufll.n_elements>=0 && "INTERNAL ERROR- Number of elements cannot be negative"));
+
+    const CharT open[]  = { CharT('{'), CharT('\0') };
+    const CharT close[] = { CharT('}'), CharT('\0') };
+    const CharT comma[] = { CharT(','), CharT(' '), CharT('\0') };
+
+    output_stream << open;
+
+    bool first = true;
+    for(auto* current_node = ufll.start_node; current_node != nullptr; current_node = current_node->next) {
+        for(int32_t i = 0; i < current_node->count; i++) {
+            if(!first) {
+                output_stream << comma;
+            }
+            output_stream << current_node->elements()[i];
+            first = false;
+        }
+    }
+
+    output_stream << close;
+
+    return output_stream;
+}
+
+
+
+
+}
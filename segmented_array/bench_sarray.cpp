@@ -0,0 +1,867 @@
+#include "chunked_segmented_array.cpp"
+#include "segmented_array.cpp"
+#include <chrono>
+#include <climits>
+#include <fcntl.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace utils;
+
+
+/**
+ * Returns the number of seconds elapsed since `start`.
+ *
+ * @param start time point to measure from
+ * @return seconds between `start` and now
+ */
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+
+
+/**
+ * Returns the peak resident set size of this process so far, in megabytes.
+ *
+ * @return peak memory use, in megabytes
+ */
+double peak_rss_mb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    //Linux reports kilobytes
+    return usage.ru_maxrss / 1024.0;
+}
+
+
+
+/**
+ * Runs `benchmark` in a child process, so its peak memory use is not mixed with other benchmarks.
+ *
+ * @param benchmark function that runs and prints one measurement
+ */
+void run_isolated(void (*benchmark)()) {
+    //Flush first, so the child does not print the parent's buffered output again
+    cout << flush;
+
+    pid_t child = fork();
+    if(child == 0) {
+        benchmark();
+        cout << flush;
+        _exit(0);
+    }
+    waitpid(child, nullptr, 0);
+}
+
+
+
+/**
+ * Appends `n_elems` characters to an empty array, `block_length` characters per call to `push_back`.
+ *
+ * Prints the number of appended characters per second and the peak memory use of the process.
+ *
+ * @param Array type of segmented array to measure
+ * @param label name of the storage mode being measured
+ * @param n_elems number of characters to append
+ * @param block_length number of characters per append. 1 appends single characters
+ */
+template<typename Array>
+void bench_append(const char* label, int64_t n_elems, int32_t block_length) {
+    Array arr = Array("", 4096);
+    string block(block_length, 'x');
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    if(block_length == 1) {
+        for(int64_t i = 0; i < n_elems; i++) {
+            arr.push_back((char)('a' + i % 26));
+        }
+    }
+    else {
+        for(int64_t i = 0; i < n_elems; i += block_length) {
+            arr.push_back(block);
+        }
+    }
+    double elapsed = seconds_since(start);
+
+    cout << label << ": " << (arr.size() / elapsed) / 1e6 << " million chars per second, peak RSS " << peak_rss_mb() << " MB"
+        << " (size " << arr.size() << ", capacity " << arr.capacity() << ")" << endl;
+}
+
+
+
+/**
+ * Number of reallocations counted by `counting_growth`
+ */
+int64_t n_reallocations = 0;
+
+/**
+ * Number of bytes of existing elements moved by the reallocations counted by `counting_growth`
+ */
+int64_t n_bytes_copied = 0;
+
+/**
+ * Growth policy that counts every reallocation and the bytes it moves, then grows like `BasePolicy`.
+ *
+ * @param BasePolicy growth policy to measure
+ * @param ElementSize size of each element in bytes
+ */
+template<typename BasePolicy, int64_t ElementSize>
+struct counting_growth {
+    static int64_t new_capacity(int64_t old_size, int64_t required_size, int64_t old_capacity, int32_t segment_length) noexcept {
+        n_reallocations++;
+        n_bytes_copied += old_size * ElementSize;
+        return BasePolicy::new_capacity(old_size, required_size, old_capacity, segment_length);
+    }
+};
+
+
+
+/**
+ * Appends `n_elems` single characters to an empty array that grows with `GrowthPolicy`, optionally reserving room for all of them first.
+ *
+ * Prints the time taken, number of reallocations, bytes copied by reallocations, and final unused space.
+ *
+ * @param GrowthPolicy growth policy to measure
+ * @param label name of the growth policy
+ * @param n_elems number of characters to append
+ * @param reserve_first whether to call `reserve(n_elems)` before appending
+ */
+template<typename GrowthPolicy>
+void bench_growth(const char* label, int64_t n_elems, bool reserve_first) {
+    n_reallocations = 0;
+    n_bytes_copied = 0;
+    segmented_array<char, counting_growth<GrowthPolicy, sizeof(char)> > arr = segmented_array<char, counting_growth<GrowthPolicy, sizeof(char)> >(0, 4096);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    if(reserve_first) {
+        arr.reserve(n_elems);
+    }
+    for(int64_t i = 0; i < n_elems; i++) {
+        arr.push_back((char)('a' + i % 26));
+    }
+    double elapsed = seconds_since(start);
+
+    cout << label << ": " << elapsed * 1000 << " ms, " << n_reallocations << " reallocations, "
+        << n_bytes_copied / 1e6 << " MB copied, " << (arr.capacity() - arr.size()) / 1e6 << " MB unused" << endl;
+}
+
+
+
+/**
+ * Appends 500M single characters to the contiguous array.
+ */
+void append_chars_contiguous() {
+    bench_append<segmented_array<char> >("  segmented_array", 500000000, 1);
+}
+
+/**
+ * Appends 500M single characters to the chunked array.
+ */
+void append_chars_chunked() {
+    bench_append<chunked_segmented_array<char> >("  chunked_segmented_array", 500000000, 1);
+}
+
+/**
+ * Appends 1G characters in 4 KiB blocks to the contiguous array.
+ */
+void append_blocks_contiguous() {
+    bench_append<segmented_array<char> >("  segmented_array", 1000000000, 4096);
+}
+
+/**
+ * Appends 1G characters in 4 KiB blocks to the chunked array.
+ */
+void append_blocks_chunked() {
+    bench_append<chunked_segmented_array<char> >("  chunked_segmented_array", 1000000000, 4096);
+}
+
+
+
+/**
+ * Measures `find`, `count`, `find_in_segment`, and `operator==` on an array of `n_elems` characters, using at most `max_level` instructions.
+ * The searched character is never in the array, so every element is checked.
+ *
+ * Prints the number of gigabytes checked per second for each operation.
+ *
+ * @param label name of the instruction set being measured
+ * @param max_level highest instruction set the kernels may use
+ * @param n_elems number of characters in the array
+ * @param rounds number of times to repeat each operation
+ */
+void bench_search(const char* label, simd::level max_level, int64_t n_elems, int32_t rounds) {
+    segmented_array<char> arr = segmented_array<char>(string(n_elems, 'a'), 4096);
+    segmented_array<char> same = arr;
+    simd::limit_level(max_level);
+    int64_t checksum = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int32_t r = 0; r < rounds; r++) {
+        checksum += arr.find('z');
+    }
+    double find_seconds = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    for(int32_t r = 0; r < rounds; r++) {
+        checksum += arr.count('z');
+    }
+    double count_seconds = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    for(int32_t r = 0; r < rounds; r++) {
+        for(int32_t i = 0; i < arr.filled_segment_count(); i++) {
+            checksum += arr.find_in_segment(i, 'z');
+        }
+    }
+    double segment_seconds = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    for(int32_t r = 0; r < rounds; r++) {
+        checksum += (arr == same);
+    }
+    double equal_seconds = seconds_since(start);
+
+    simd::limit_level(simd::AVX2);
+
+    double gigabytes = (double)n_elems * rounds / 1e9;
+    cout << label << ": find " << gigabytes / find_seconds << " GB/s, count " << gigabytes / count_seconds
+        << " GB/s, find_in_segment " << gigabytes / segment_seconds << " GB/s, == " << gigabytes / equal_seconds << " GB/s"
+        << " (checksum " << checksum << ")" << endl;
+}
+
+
+
+/**
+ * Measures the old way of searching: copying the array with `to_string`, then calling `std::string::find`.
+ *
+ * @param n_elems number of characters in the array
+ * @param rounds number of times to repeat the search
+ */
+void bench_search_by_copy(int64_t n_elems, int32_t rounds) {
+    segmented_array<char> arr = segmented_array<char>(string(n_elems, 'a'), 4096);
+    int64_t checksum = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int32_t r = 0; r < rounds; r++) {
+        checksum += (int64_t)arr.to_string().find('z');
+    }
+    double elapsed = seconds_since(start);
+
+    cout << "  to_string().find: " << (double)n_elems * rounds / 1e9 / elapsed << " GB/s (checksum " << checksum << ")" << endl;
+}
+
+
+
+/**
+ * Compares loading a file of `n_bytes` characters by reading it into a string and copying it into an array,
+ * by reading it straight into an array with `append_from`, and by mapping it with the memory-mapped constructor.
+ *
+ * Prints the time until the array is ready and the time to scan every element.
+ * The file was just written, so it is likely in the page cache for both methods.
+ *
+ * @param n_bytes size of the file to load
+ */
+void bench_load(int64_t n_bytes) {
+    const char* path = "bench_sarray.tmp";
+    {
+        ofstream file(path, ios::binary);
+        string block(1 << 20, 'a');
+        for(int64_t i = 0; i < n_bytes; i += (int64_t)block.size()) {
+            file.write(block.data(), (streamsize)block.size());
+        }
+    }
+
+    //Read, then copy
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        ifstream file(path, ios::binary);
+        stringstream buffer;
+        buffer << file.rdbuf();
+        segmented_array<char> arr = segmented_array<char>(buffer.str(), 4096);
+        double load_seconds = seconds_since(start);
+
+        start = chrono::steady_clock::now();
+        int64_t checksum = arr.count('z');
+        double scan_seconds = seconds_since(start);
+        cout << "  read and copy: ready in " << load_seconds * 1000 << " ms, scanned in " << scan_seconds * 1000 << " ms (checksum " << checksum << ")" << endl;
+    }
+
+    //Read straight into the array
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        int fd = open(path, O_RDONLY);
+        segmented_array<char> arr = segmented_array<char>("", 4096);
+        arr.append_from(fd, n_bytes);
+        close(fd);
+        double load_seconds = seconds_since(start);
+
+        start = chrono::steady_clock::now();
+        int64_t checksum = arr.count('z');
+        double scan_seconds = seconds_since(start);
+        cout << "  append_from: ready in " << load_seconds * 1000 << " ms, scanned in " << scan_seconds * 1000 << " ms (checksum " << checksum << ")" << endl;
+    }
+
+    //Map
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        segmented_array<char> arr = segmented_array<char>(path, 4096, map_mode::READ_ONLY);
+        double load_seconds = seconds_since(start);
+
+        start = chrono::steady_clock::now();
+        int64_t checksum = arr.count('z');
+        double scan_seconds = seconds_since(start);
+        cout << "  memory-mapped: ready in " << load_seconds * 1000 << " ms, scanned in " << scan_seconds * 1000 << " ms (checksum " << checksum << ")" << endl;
+    }
+
+    remove(path);
+}
+
+
+
+/**
+ * Measures a `std::vector` of `n_arrays` arrays, each holding `array_length` characters.
+ * The vector grows by `push_back`, which moves the arrays it already holds, then the whole vector is copied, which copies every element.
+ *
+ * Prints the time taken by each.
+ *
+ * @param n_arrays number of arrays in the vector
+ * @param array_length number of characters in each array
+ */
+void bench_vector_of_arrays(int32_t n_arrays, int64_t array_length) {
+    string text(array_length, 'a');
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<segmented_array<char> > arrays;
+    for(int32_t i = 0; i < n_arrays; i++) {
+        arrays.push_back(segmented_array<char>(text, 4096));
+    }
+    double grow_seconds = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    vector<segmented_array<char> > copies = arrays;
+    double copy_seconds = seconds_since(start);
+
+    cout << "  push_back (moves on growth): " << grow_seconds * 1000 << " ms, copying the vector: " << copy_seconds * 1000
+        << " ms (" << copies.size() << " arrays)" << endl;
+}
+
+
+
+/**
+ * Reads `n_reads` elements at random flat positions of an array of `n_elems` characters, and sums them:
+ * by dividing each position into segment and element numbers for `operator()`, with `operator[]`,
+ * and with `to_coords` converting every position at once before the reads.
+ *
+ * Prints the number of million reads per second for each.
+ *
+ * @param Array type of segmented array to measure
+ * @param label name of the array type
+ * @param n_elems number of characters in the array
+ * @param n_reads number of elements to read
+ */
+template<typename Array>
+void bench_flat_access(const char* label, int64_t n_elems, int64_t n_reads) {
+    Array arr = Array(string(n_elems, 'a'), 4096);
+
+    mt19937_64 generator(12345);
+    uniform_int_distribution<int64_t> position(0, n_elems - 1);
+    vector<int64_t> positions((size_t)n_reads);
+    for(int64_t i = 0; i < n_reads; i++) {
+        positions[i] = position(generator);
+    }
+    int64_t checksum = 0;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int64_t i = 0; i < n_reads; i++) {
+        checksum += arr(positions[i] / arr.filled_segment_length(), (int32_t)(positions[i] % arr.filled_segment_length()));
+    }
+    double divide_seconds = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    for(int64_t i = 0; i < n_reads; i++) {
+        checksum += arr[positions[i]];
+    }
+    double flat_seconds = seconds_since(start);
+
+    vector<int64_t> segment_numbers((size_t)n_reads);
+    vector<int32_t> element_numbers((size_t)n_reads);
+    start = chrono::steady_clock::now();
+    arr.to_coords(positions.data(), n_reads, segment_numbers.data(), element_numbers.data());
+    for(int64_t i = 0; i < n_reads; i++) {
+        checksum += arr(segment_numbers[i], element_numbers[i]);
+    }
+    double batch_seconds = seconds_since(start);
+
+    double millions = (double)n_reads / 1e6;
+    cout << label << ": divide and operator() " << millions / divide_seconds << " M/s, operator[] " << millions / flat_seconds
+        << " M/s, to_coords and operator() " << millions / batch_seconds << " M/s (checksum " << checksum << ")" << endl;
+}
+
+
+
+/**
+ * Measures the cost of each kind of element access: `operator()` and `operator[]` (checked only while assertions are enabled),
+ * `checked_at` and `at` (always checked), and `unchecked_at` (never checked).
+ * Reads `n_reads` random elements of a `segmented_array<char>` of `n_elems` characters, small enough to stay in cache.
+ * The positions are chosen before timing starts.
+ *
+ * Prints the average number of nanoseconds per access for each method.
+ *
+ * @param n_elems number of characters in the array
+ * @param n_reads number of elements to read with each method
+ */
+void bench_access(int64_t n_elems, int64_t n_reads) {
+    segmented_array<char> arr = segmented_array<char>(string(n_elems, 'a'), 4096);
+
+    mt19937_64 generator(12345);
+    uniform_int_distribution<int64_t> position(0, n_elems - 1);
+    vector<int64_t> positions((size_t)n_reads);
+    vector<int64_t> segment_numbers((size_t)n_reads);
+    vector<int32_t> element_numbers((size_t)n_reads);
+    for(int64_t i = 0; i < n_reads; i++) {
+        positions[i] = position(generator);
+        segment_numbers[i] = positions[i] / 4096;
+        element_numbers[i] = (int32_t)(positions[i] % 4096);
+    }
+    int64_t checksum = 0;
+    double nanoseconds = 1e9 / (double)n_reads;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int64_t i = 0; i < n_reads; i++) {
+        checksum += arr(segment_numbers[i], element_numbers[i]);
+    }
+    double assert_ns = seconds_since(start) * nanoseconds;
+
+    start = chrono::steady_clock::now();
+    for(int64_t i = 0; i < n_reads; i++) {
+        checksum += arr.checked_at(segment_numbers[i], element_numbers[i]);
+    }
+    double checked_ns = seconds_since(start) * nanoseconds;
+
+    start = chrono::steady_clock::now();
+    for(int64_t i = 0; i < n_reads; i++) {
+        checksum += arr.unchecked_at(segment_numbers[i], element_numbers[i]);
+    }
+    double unchecked_ns = seconds_since(start) * nanoseconds;
+
+    start = chrono::steady_clock::now();
+    for(int64_t i = 0; i < n_reads; i++) {
+        checksum += arr[positions[i]];
+    }
+    double flat_assert_ns = seconds_since(start) * nanoseconds;
+
+    start = chrono::steady_clock::now();
+    for(int64_t i = 0; i < n_reads; i++) {
+        checksum += arr.at(positions[i]);
+    }
+    double flat_checked_ns = seconds_since(start) * nanoseconds;
+
+    start = chrono::steady_clock::now();
+    for(int64_t i = 0; i < n_reads; i++) {
+        checksum += arr.unchecked_at(positions[i]);
+    }
+    double flat_unchecked_ns = seconds_since(start) * nanoseconds;
+
+    #ifdef NDEBUG
+        const char* asserts = "assertions disabled";
+    #else
+        const char* asserts = "assertions enabled";
+    #endif
+    cout << "  segment and element (" << asserts << "): operator() " << assert_ns << " ns, checked_at " << checked_ns
+        << " ns, unchecked_at " << unchecked_ns << " ns" << endl;
+    cout << "  flat position (" << asserts << "): operator[] " << flat_assert_ns << " ns, at " << flat_checked_ns
+        << " ns, unchecked_at " << flat_unchecked_ns << " ns (checksum " << checksum << ")" << endl;
+}
+
+
+
+/**
+ * Measures editing the middle of an array of `n_elems` characters, as a text buffer would:
+ * `n_edits` random single-character inserts and erases with `insert` and `erase`,
+ * against rebuilding the array from `to_string` after editing the string.
+ *
+ * Prints the average number of microseconds per edit for each method.
+ *
+ * @param n_elems number of characters in the array
+ * @param n_edits number of edits to make with each method. Every other edit is an erase
+ */
+void bench_edit(int64_t n_elems, int32_t n_edits) {
+    segmented_array<char> arr = segmented_array<char>(string(n_elems, 'a'), 4096);
+    arr.reserve(n_elems + 1);
+
+    mt19937_64 generator(12345);
+    uniform_int_distribution<int64_t> position(0, n_elems - 1);
+    vector<int64_t> positions((size_t)n_edits);
+    for(int32_t i = 0; i < n_edits; i++) {
+        positions[i] = position(generator);
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int32_t i = 0; i < n_edits; i++) {
+        pair<int64_t, int32_t> coords = arr.to_coords(positions[i]);
+        if(i % 2 == 0) {
+            arr.insert(coords.first, coords.second, 'b');
+        }
+        else {
+            arr.erase(coords.first, coords.second);
+        }
+    }
+    double edit_seconds = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    for(int32_t i = 0; i < n_edits; i++) {
+        string text = arr.to_string();
+        if(i % 2 == 0) {
+            text.insert((size_t)positions[i], 1, 'b');
+        }
+        else {
+            text.erase((size_t)positions[i], 1);
+        }
+        arr = segmented_array<char>(text, 4096);
+    }
+    double rebuild_seconds = seconds_since(start);
+
+    double microseconds = 1e6 / (double)n_edits;
+    cout << "  insert and erase: " << edit_seconds * microseconds << " us per edit, rebuild from to_string: "
+        << rebuild_seconds * microseconds << " us per edit (size " << arr.size() << ")" << endl;
+}
+
+
+
+/**
+ * Converts English letters to their position in the alphabet, like the old `mut_array::lettersToNumValue`.
+ *
+ * @param c character to convert
+ * @return 0 to 25 for a letter of either case, or `c` unchanged
+ */
+char letter_to_number(char c) {
+    if(c >= 'A' && c <= 'Z') {
+        return (char)(c - 'A');
+    }
+    if(c >= 'a' && c <= 'z') {
+        return (char)(c - 'a');
+    }
+    return c;
+}
+
+/**
+ * Returns the 64-bit FNV-1a hash of a segment.
+ *
+ * @param view segment to hash
+ * @return hash of the segment's bytes
+ */
+uint64_t hash_segment(segment_view<const char> view) {
+    uint64_t hash = 14695981039346656037ULL;
+    for(char c : view) {
+        hash = (hash ^ (unsigned char)c) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * Measures `transform_segments` (converting letters to numbers) and `reduce_segments` (hashing every segment)
+ * on an array of `n_elems` characters, with `n_threads` threads. 1 thread runs serially, without a pool.
+ *
+ * Prints the number of gigabytes processed per second by each operation.
+ *
+ * @param n_threads number of threads to run on
+ * @param n_elems number of characters in the array
+ */
+void bench_parallel(int32_t n_threads, int64_t n_elems) {
+    segmented_array<char> arr = segmented_array<char>(0, 4096);
+    for(int64_t i = 0; i < n_elems; i++) {
+        arr.push_back((char)('a' + i % 26));
+    }
+    thread_pool pool(n_threads);
+    thread_pool* used_pool = (n_threads > 1) ? &pool : nullptr;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    arr.transform_segments(letter_to_number, used_pool);
+    double transform_seconds = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    uint64_t checksum = arr.reduce_segments((uint64_t)0, hash_segment, [](uint64_t a, uint64_t b) { return a * 31 + b; }, used_pool);
+    double reduce_seconds = seconds_since(start);
+
+    double gigabytes = (double)n_elems / 1e9;
+    cout << "  " << n_threads << " threads: transform " << gigabytes / transform_seconds << " GB/s, reduce " << gigabytes / reduce_seconds
+        << " GB/s (checksum " << checksum % 1000 << ")" << endl;
+}
+
+
+
+/**
+ * Compares saving and reloading an array of `n_bytes` characters as text (`operator<<`, then reading it back and copying it)
+ * against the binary format (`save`, then `load` or `load_mapped`).
+ *
+ * Prints the time taken by each step. The file was just written, so it is likely in the page cache when it is loaded.
+ *
+ * @param n_bytes number of characters in the array
+ */
+void bench_save_load(int64_t n_bytes) {
+    const char* path = "bench_sarray.tmp";
+    segmented_array<char> arr = segmented_array<char>(string(n_bytes, 'a'), 4096);
+
+    //Text
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        {
+            ofstream file(path, ios::binary);
+            file << arr;
+        }
+        double save_seconds = seconds_since(start);
+
+        start = chrono::steady_clock::now();
+        ifstream file(path, ios::binary);
+        stringstream buffer;
+        buffer << file.rdbuf();
+        segmented_array<char> loaded = segmented_array<char>(buffer.str(), 4096);
+        double load_seconds = seconds_since(start);
+        cout << "  operator<< and read: saved in " << save_seconds * 1000 << " ms, loaded in " << load_seconds * 1000 << " ms" << endl;
+    }
+
+    //Binary
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        arr.save(path);
+        double save_seconds = seconds_since(start);
+
+        start = chrono::steady_clock::now();
+        segmented_array<char> loaded = segmented_array<char>::load(path);
+        double load_seconds = seconds_since(start);
+
+        start = chrono::steady_clock::now();
+        segmented_array<char> mapped = segmented_array<char>::load_mapped(path);
+        double mapped_seconds = seconds_since(start);
+
+        start = chrono::steady_clock::now();
+        segmented_array<char> unchecked = segmented_array<char>::load_mapped(path, false);
+        double unchecked_seconds = seconds_since(start);
+
+        cout << "  save and load: saved in " << save_seconds * 1000 << " ms, loaded in " << load_seconds * 1000
+            << " ms, mapped in " << mapped_seconds * 1000 << " ms (" << unchecked_seconds * 1000 << " ms without checksum)" << endl;
+    }
+
+    remove(path);
+}
+
+
+
+/**
+ * Measures writing an array of `n_bytes` characters to a file one character at a time (how `operator<<` used to work),
+ * with `operator<<`, and with `write_segments`, and measures `to_string`.
+ *
+ * Prints the number of gigabytes written per second by each.
+ *
+ * @param n_bytes number of characters in the array
+ */
+void bench_output(int64_t n_bytes) {
+    const char* path = "bench_sarray.tmp";
+    segmented_array<char> arr = segmented_array<char>(string(n_bytes, 'a'), 4096);
+    double gigabytes = (double)n_bytes / 1e9;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    {
+        ofstream file(path, ios::binary);
+        for(int64_t i = 0; i < arr.size(); i++) {
+            file << arr(i / 4096, i % 4096);
+        }
+    }
+    double per_char_seconds = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    {
+        ofstream file(path, ios::binary);
+        file << arr;
+    }
+    double stream_seconds = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    {
+        ofstream file(path, ios::binary);
+        arr.write_segments(file, string("\n"));
+    }
+    double segments_seconds = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    int64_t length = (int64_t)arr.to_string().length();
+    double string_seconds = seconds_since(start);
+
+    cout << "  per character " << gigabytes / per_char_seconds << " GB/s, operator<< " << gigabytes / stream_seconds
+        << " GB/s, write_segments " << gigabytes / segments_seconds << " GB/s, to_string " << gigabytes / string_seconds
+        << " GB/s (length " << length << ")" << endl;
+    remove(path);
+}
+
+
+
+/**
+ * Number of characters in the stress test: 6 GB, or 60% of physical memory if that is smaller,
+ * but always more than 2^31 so that element and segment counts overflow 32 bits.
+ *
+ * @return number of characters to put in the stress test's array
+ */
+int64_t stress_size() {
+    int64_t physical_bytes = (int64_t)sysconf(_SC_PHYS_PAGES) * (int64_t)sysconf(_SC_PAGE_SIZE);
+    int64_t n_elems = min((int64_t)6000000000LL, physical_bytes / 10 * 6);
+    return max(n_elems, (int64_t)INT_MAX + 100000000);
+}
+
+/**
+ * Builds an array of more than 2^31 characters with 1 character per segment, so segment numbers also pass 2^31,
+ * then checks that appending, indexing, searching, and removing stay correct past 32-bit limits.
+ *
+ * Prints the append and scan throughput, and whether every check passed.
+ */
+void bench_stress() {
+    int64_t n_elems = stress_size();
+    segmented_array<char> arr = segmented_array<char>(0, 1);
+    arr.reserve(n_elems);
+    string block(1 << 20, 'a');
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    while(arr.size() < n_elems) {
+        arr.append(block.data(), min((int64_t)block.size(), n_elems - arr.size()));
+    }
+    double append_seconds = seconds_since(start);
+
+    //Mark elements on both sides of 2^31, and the final element
+    int64_t marks[4] = {(int64_t)INT_MAX - 1, (int64_t)INT_MAX, (int64_t)INT_MAX + 1, n_elems - 1};
+    for(int32_t i = 0; i < 4; i++) {
+        arr.set_char_at(marks[i], 0, 'b');
+    }
+
+    start = chrono::steady_clock::now();
+    int64_t n_marked = arr.count('b');
+    int64_t first_mark = arr.find('b');
+    double scan_seconds = seconds_since(start);
+
+    bool correct = arr.size() == n_elems && arr.filled_segment_count() == n_elems && n_marked == 4 && first_mark == marks[0];
+    for(int32_t i = 0; i < 4; i++) {
+        correct = correct && arr(marks[i], 0) == 'b' && arr.segment(marks[i])[0] == 'b';
+    }
+
+    //Remove more than 2^31 elements at once
+    arr.pop_back(n_elems - 10);
+    correct = correct && arr.size() == 10 && arr.filled_segment_count() == 10 && arr.to_string() == string(10, 'a');
+
+    double gigabytes = (double)n_elems / 1e9;
+    cout << "  " << gigabytes << " G characters: append " << gigabytes / append_seconds << " GB/s, count and find "
+        << 2 * gigabytes / scan_seconds << " GB/s, peak RSS " << peak_rss_mb() << " MB, " << (correct ? "all checks passed" : "CHECKS FAILED") << endl;
+}
+
+
+
+/**
+ * Reads `n_reads` elements at random positions of an array of `n_elems` characters with `operator()`, and sums them.
+ * The segment and element numbers are chosen before timing starts.
+ *
+ * Prints the number of million reads per second.
+ *
+ * @param Array type of segmented array to measure
+ * @param label name of the array type
+ * @param n_elems number of characters in the array
+ * @param n_reads number of elements to read
+ */
+template<typename Array>
+void bench_random_access(const char* label, int64_t n_elems, int64_t n_reads) {
+    Array arr = Array(string(n_elems, 'a'), 4096);
+
+    mt19937_64 generator(12345);
+    uniform_int_distribution<int64_t> position(0, n_elems - 1);
+    vector<int64_t> segment_numbers((size_t)n_reads);
+    vector<int32_t> element_numbers((size_t)n_reads);
+    for(int64_t i = 0; i < n_reads; i++) {
+        int64_t flat = position(generator);
+        segment_numbers[i] = flat / 4096;
+        element_numbers[i] = (int32_t)(flat % 4096);
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int64_t checksum = 0;
+    for(int64_t i = 0; i < n_reads; i++) {
+        checksum += arr(segment_numbers[i], element_numbers[i]);
+    }
+    double elapsed = seconds_since(start);
+
+    cout << label << ": " << (n_reads / elapsed) / 1e6 << " million reads per second (checksum " << checksum << ")" << endl;
+}
+
+
+
+int main() {
+    cout << "Appending 500M single characters, 4096 per segment" << endl;
+    run_isolated(append_chars_contiguous);
+    run_isolated(append_chars_chunked);
+
+    cout << "Appending 1G characters in 4 KiB blocks, 4096 per segment" << endl;
+    run_isolated(append_blocks_contiguous);
+    run_isolated(append_blocks_chunked);
+
+    cout << "Appending 100M single characters with each growth policy, 4096 per segment" << endl;
+    bench_growth<default_growth>("  default_growth", 100000000, false);
+    bench_growth<default_growth>("  default_growth after reserve", 100000000, true);
+    bench_growth<geometric_growth<3, 2> >("  geometric_growth<3, 2>", 100000000, false);
+    bench_growth<geometric_growth<2> >("  geometric_growth<2>", 100000000, false);
+    bench_growth<segment_aligned_growth<geometric_growth<2> > >("  segment_aligned_growth<geometric_growth<2>>", 100000000, false);
+    bench_growth<capped_growth<16777216> >("  capped_growth<16M>", 100000000, false);
+
+    cout << "Filling a vector with 10000 arrays of 64 KiB" << endl;
+    bench_vector_of_arrays(10000, 65536);
+
+    cout << "Reading 100M random elements of a 1 MB array with operator(), 4096 per segment" << endl;
+    bench_random_access<segmented_array<char> >("  run-time segment length", 1 << 20, 100000000);
+    bench_random_access<fixed_segmented_array<char, 4096> >("  fixed_segmented_array<char, 4096>", 1 << 20, 100000000);
+
+    cout << "Reading 100M random flat positions of a 1 MB array, 4096 per segment" << endl;
+    bench_flat_access<segmented_array<char> >("  run-time segment length", 1 << 20, 100000000);
+    bench_flat_access<fixed_segmented_array<char, 4096> >("  fixed_segmented_array<char, 4096>", 1 << 20, 100000000);
+
+    cout << "Nanoseconds per access to 100M random elements of a 1 MB array, 4096 per segment" << endl;
+    bench_access(1 << 20, 100000000);
+
+    cout << "Appending 100M single characters, 4096 per segment" << endl;
+    bench_append<segmented_array<char> >("  run-time segment length", 100000000, 1);
+    bench_append<fixed_segmented_array<char, 4096> >("  fixed_segmented_array<char, 4096>", 100000000, 1);
+
+    cout << "Inserting and erasing single characters at 200 random positions of a 64 MB array, 4096 per segment" << endl;
+    bench_edit(64000000, 200);
+
+    cout << "Searching 256M characters, 4096 per segment" << endl;
+    bench_search("  scalar", simd::SCALAR, 256000000, 5);
+    bench_search("  SSE2", simd::SSE2, 256000000, 5);
+    bench_search("  AVX2", simd::AVX2, 256000000, 5);
+    bench_search_by_copy(256000000, 5);
+
+    //1, 2, 4... threads, up to the number of hardware threads
+    int32_t max_threads = max((int32_t)thread::hardware_concurrency(), 1);
+    cout << "Transforming and reducing 256M characters by segment, 4096 per segment, " << max_threads << " hardware threads" << endl;
+    for(int32_t n_threads = 1; n_threads < max_threads; n_threads *= 2) {
+        bench_parallel(n_threads, 256000000);
+    }
+    bench_parallel(max_threads, 256000000);
+
+    cout << "Loading a 1 GB file" << endl;
+    bench_load(1 << 30);
+
+    cout << "Writing a 500 MB array to a file" << endl;
+    bench_output(500000000);
+
+    cout << "Saving and reloading a 1 GB array" << endl;
+    bench_save_load(1 << 30);
+
+    cout << "Stress test past 2^31 characters and segments" << endl;
+    run_isolated(bench_stress);
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace utils {
+
+
+
+
+/**
+ * Header at the start of a segmented array saved in binary. The elements' raw bytes follow it immediately.
+ *
+ * Every field is stored in the byte order of the machine that saved the array. `byte_order` tells whether the loading machine uses the same order.
+ * The header is 64 bytes, so the elements that follow are aligned for any type when the file is mapped into memory.
+ */
+struct binary_header {
+    /**
+     * Always "SEGARRAY", to recognize the format
+     */
+    char magic[8];
+
+    /**
+     * Version of the format. Currently 1.
+     */
+    uint32_t version;
+
+    /**
+     * Always 0x01020304 when read on a machine with the saving machine's byte order
+     */
+    uint32_t byte_order;
+
+    /**
+     * Size of the header, in bytes. The elements start this many bytes into the file.
+     */
+    uint32_t header_bytes;
+
+    /**
+     * Size of each element, in bytes
+     */
+    uint32_t element_bytes;
+
+    /**
+     * Number of elements per segment
+     */
+    int32_t elements_per_segment;
+
+    /**
+     * Number of elements in the remainder
+     */
+    int32_t n_remainder_elems;
+
+    /**
+     * Number of full-length segments
+     */
+    int64_t n_segments;
+
+    /**
+     * Total number of elements
+     */
+    int64_t n_elements;
+
+    /**
+     * `checksum64` of the elements' bytes
+     */
+    uint64_t checksum;
+
+    /**
+     * Unused. Always 0.
+     */
+    char padding[8];
+};
+
+static_assert(sizeof(binary_header) == 64, "The binary header must be 64 bytes");
+
+
+
+/**
+ * Returns a 64-bit checksum of `n_bytes` bytes starting at `data`, to detect damaged saved arrays.
+ *
+ * Bytes are read 32 at a time in four independent lanes, so the checksum runs close to memory speed.
+ * Not suitable as a cryptographic hash.
+ *
+ * @param data first byte to checksum
+ * @param n_bytes number of bytes to checksum. Must be non-negative
+ * @return checksum of the bytes
+ */
+inline uint64_t checksum64(const void* data, int64_t n_bytes) noexcept {
+    const uint64_t prime_1 = 11400714785074694791ULL;
+    const uint64_t prime_2 = 14029467366897019727ULL;
+    const unsigned char* next = static_cast<const unsigned char*>(data);
+    uint64_t lanes[4] = {prime_1 + prime_2, prime_2, 0, 0 - prime_1};
+
+    //Mix whole blocks of 4 words into the lanes
+    int64_t i = 0;
+    for(; i + 32 <= n_bytes; i += 32) {
+        for(int32_t lane = 0; lane < 4; lane++) {
+            uint64_t word;
+            std::memcpy(&word, next + i + lane * 8, 8);
+            lanes[lane] += word * prime_2;
+            lanes[lane] = ((lanes[lane] << 31) | (lanes[lane] >> 33)) * prime_1;
+        }
+    }
+
+    //Combine the lanes, then mix in the leftover bytes and the length
+    uint64_t result = (uint64_t)n_bytes;
+    for(int32_t lane = 0; lane < 4; lane++) {
+        result = (result ^ lanes[lane]) * prime_1 + prime_2;
+    }
+    for(; i < n_bytes; i++) {
+        result = (result ^ next[i]) * prime_1;
+    }
+    result ^= result >> 29;
+    result *= prime_2;
+    result ^= result >> 32;
+    return result;
+}
+
+
+
+
+}
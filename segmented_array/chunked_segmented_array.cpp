@@ -0,0 +1,1202 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "segment_view.cpp"
+
+namespace utils {
+
+
+
+
+/**
+ * Chunked version of the Segmented Array. Stores data of any default-constructible type.
+ *
+ * Has the same segments, remainder, and indexing as `segmented_array`:
+ * data is divided into segments of a set length, and the final segment may be a shorter "remainder".
+ *
+ * Instead of one buffer, the contents are stored in chunks of `segments_per_chunk()` whole segments each.
+ * A directory holds a pointer to every chunk. A segment never crosses the boundary between two chunks.
+ *
+ * Appending adds new chunks when the existing chunks are full, so existing elements are never copied or moved.
+ * Only the directory (one pointer per chunk) is copied when it grows.
+ * Accessing an element takes constant time: one division picks the chunk, and the rest picks the position in the chunk.
+ *
+ * Unused space is measured in whole chunks: the array's capacity is always a multiple of the chunk length.
+ * Every element of a chunk is default-constructed when the chunk is allocated, and new elements are assigned into place.
+ *
+ * @param T datatype stored in the array
+ */
+template <typename T>
+class chunked_segmented_array {
+
+private:
+
+    /**
+     * Default minimum number of bytes in a chunk. Chunks hold at least one segment, so they may be larger.
+     */
+    static const int64_t DEFAULT_CHUNK_BYTES = 65536;
+
+    /**
+     * Number of full-length segments in the array. The remainder does not count as a segment.
+     *
+     * Non-negative.
+     */
+    int64_t n_segments;
+
+    /**
+     * Number of elements in each full-length segment in the array
+     *
+     * Positive. Should not be changed after the array's construction.
+     */
+    int32_t n_elems_per_segment;
+
+    /**
+     * Number of elements in the remainder segment.
+     *
+     * Non-negative.
+     */
+    int32_t n_remainder_elems;
+
+    /**
+     * Number of segments stored in each chunk
+     *
+     * Positive. Should not be changed after the array's construction.
+     */
+    int32_t n_segments_per_chunk;
+
+
+    /**
+     * The directory of chunks. Chunk `i` holds segments `i * n_segments_per_chunk` through `(i+1) * n_segments_per_chunk - 1`.
+     *
+     * Only the first `n_chunks` pointers point to chunks. The rest are unused.
+     */
+    T** chunks;
+
+    /**
+     * Number of allocated chunks. The chunks hold every element of the array, plus any unused space.
+     *
+     * Non-negative.
+     */
+    int64_t n_chunks;
+
+    /**
+     * Number of chunk pointers the directory can hold before it must grow.
+     *
+     * At least `n_chunks`.
+     */
+    int64_t n_directory_slots;
+
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////////////////////////////////////
+    //PRIVATE HELPERS
+
+    /**
+     * Returns the number of segments to put in each chunk, so each chunk holds at least `DEFAULT_CHUNK_BYTES` bytes.
+     *
+     * Private helper method.
+     *
+     * @param elements_per_segment number of elements per segment in the array. Must be positive
+     * @return default number of segments per chunk. Always positive.
+     */
+    static int32_t _default_segments_per_chunk(int32_t elements_per_segment) noexcept {
+        int64_t segment_bytes = (int64_t)elements_per_segment * (int64_t)sizeof(T);
+        if(segment_bytes >= DEFAULT_CHUNK_BYTES) {
+            return 1;
+        }
+        return (int32_t)((DEFAULT_CHUNK_BYTES + segment_bytes - 1) / segment_bytes);
+    }
+
+
+
+    /**
+     * Sets every size to that of an empty array with `elements_per_segment` elements per segment, and `segments_per_chunk` segments per chunk.
+     * No memory is allocated.
+     *
+     * Private helper method.
+     *
+     * @param elements_per_segment number of elements per segment in the array. Must be positive
+     * @param segments_per_chunk number of segments per chunk, or 0 to use the default
+     */
+    void _init_empty(int32_t elements_per_segment, int32_t segments_per_chunk) noexcept {
+        n_segments = 0;
+        n_elems_per_segment = elements_per_segment;
+        n_remainder_elems = 0;
+        n_segments_per_chunk = (segments_per_chunk == 0) ? _default_segments_per_chunk(elements_per_segment) : segments_per_chunk;
+
+        chunks = nullptr;
+        n_chunks = 0;
+        n_directory_slots = 0;
+    }
+
+
+
+    /**
+     * Checks if `segment_number` and `elem_number` are valid indices in the array.
+     * If not, raises an assertion.
+     *
+     * Does nothing if assertions are disabled.
+     *
+     * @param segment_number segment index to check
+     * @param elem_number element index to check
+     */
+    void _assert_valid_index(int64_t segment_number, int32_t elem_number) const {
+        //Automatic exit if assertions are disabled
+        #ifndef NDEBUG
+            //Check for integer overflow
+            assert(n_segments >= 0 && "(POSSIBLE INTEGER OVERFLOW) Number of segments must be non-negative");
+            assert(n_elems_per_segment > 0 && "(POSSIBLE INTEGER OVERFLOW) Number of elements per segment must be positive");
+            assert(n_remainder_elems >= 0 && "(POSSIBLE INTEGER OVERFLOW) Number of remainder elements must be non-negative");
+
+            //Check segment and element numbers are non-negative
+            assert(segment_number >= 0 && "Segment number must be non-negative");
+            assert(elem_number >= 0 && "Element number must be non-negative");
+
+            //In remainder: check if remainder is exceeded
+            if(segment_number == filled_segment_count()) {
+                assert(elem_number < remainder_length() && "When accessing the remainder, element number must be less than the number of elements in the remainder");
+            }
+            //Not in remainder: check like normal 2D array
+            else {
+                assert(segment_number < filled_segment_count() && "Segment number must be less than the number of segments in the array");
+                assert(elem_number < filled_segment_length() && "Element number must be less than the number of elements per segment");
+            }
+
+        #endif
+    }
+
+
+
+    /**
+     * Returns whether segment `segment_number` and position `elem_number` hold an element of the array.
+     * Unlike `_assert_valid_index`, the check runs whether or not `NDEBUG` is defined.
+     *
+     * Private helper method.
+     *
+     * @param segment_number segment index to check
+     * @param elem_number element index to check
+     * @return true if the element exists, false otherwise
+     */
+    bool _is_valid_index(int64_t segment_number, int32_t elem_number) const noexcept {
+        if(segment_number < 0 || elem_number < 0) {
+            return false;
+        }
+        if(segment_number < n_segments) {
+            return elem_number < filled_segment_length();
+        }
+        return segment_number == n_segments && elem_number < n_remainder_elems;
+    }
+
+
+
+    /**
+     * Throws if segment `segment_number` and position `elem_number` do not hold an element of the array, whether or not `NDEBUG` is defined.
+     *
+     * Private helper method.
+     *
+     * @param segment_number segment index to check
+     * @param elem_number element index to check
+     * @throws `std::out_of_range` if the element does not exist
+     */
+    void _check_index(int64_t segment_number, int32_t elem_number) const {
+        if(!_is_valid_index(segment_number, elem_number)) {
+            throw std::out_of_range("Segment " + std::to_string(segment_number) + ", element " + std::to_string(elem_number) + " is outside the array");
+        }
+    }
+
+
+
+    /**
+     * Returns a pointer to the first element of segment `segment_number`. The segment's elements follow it contiguously.
+     *
+     * Private helper method.
+     *
+     * @param segment_number segment to find. Must be in an allocated chunk
+     * @return pointer to the segment's first element
+     */
+    T* _segment_start(int64_t segment_number) const noexcept {
+        return chunks[segment_number / n_segments_per_chunk]
+            + (int64_t)(segment_number % n_segments_per_chunk) * (int64_t)n_elems_per_segment;
+    }
+
+
+
+    /**
+     * Returns a reference to the element at flat position `index`, counting from the first element of segment 0.
+     *
+     * Private helper method.
+     *
+     * @param index position of the element. Must be in an allocated chunk
+     * @return reference to the element
+     */
+    T& _flat_element(int64_t index) const noexcept {
+        return chunks[index / chunk_length()][index % chunk_length()];
+    }
+
+
+
+    /**
+     * Writes the `n_elems` elements starting at `first` to `output_stream`.
+     * Elements of the stream's character type are written with a single `write`. Other elements are written one at a time with `<<`.
+     *
+     * Private helper method.
+     *
+     * @param output_stream output stream to write to
+     * @param first first element to write
+     * @param n_elems number of elements to write
+     */
+    template<typename CharT, typename Traits>
+    static void _write_elements(std::basic_ostream<CharT, Traits>& output_stream, const T* first, int64_t n_elems, std::true_type) {
+        output_stream.write(first, (std::streamsize)n_elems);
+    }
+
+    template<typename CharT, typename Traits>
+    static void _write_elements(std::basic_ostream<CharT, Traits>& output_stream, const T* first, int64_t n_elems, std::false_type) {
+        for(int64_t i = 0; i < n_elems; i++) {
+            output_stream << first[i];
+        }
+    }
+
+
+
+    /**
+     * Allocates chunks until the array can hold at least `n_elems` elements. Existing chunks are not moved.
+     *
+     * The directory doubles in size when it runs out of room, which copies only the chunk pointers.
+     *
+     * Private helper method.
+     *
+     * @param n_elems number of elements the array must be able to hold
+     */
+    void _reserve_chunks(int64_t n_elems) {
+        int64_t n_needed_chunks = (n_elems + chunk_length() - 1) / chunk_length();
+        if(n_needed_chunks <= n_chunks) {
+            return;
+        }
+
+        //Grow the directory
+        if(n_needed_chunks > n_directory_slots) {
+            int64_t new_slots = (n_directory_slots == 0) ? 1 : n_directory_slots;
+            while(new_slots < n_needed_chunks) {
+                new_slots *= 2;
+            }
+
+            T** new_chunks = new T*[new_slots];
+            std::copy(chunks, chunks + n_chunks, new_chunks);
+            delete[] chunks;
+            chunks = new_chunks;
+            n_directory_slots = new_slots;
+        }
+
+        //Allocate the new chunks
+        while(n_chunks < n_needed_chunks) {
+            chunks[n_chunks] = new T[chunk_length()];
+            n_chunks++;
+        }
+    }
+
+
+
+    /**
+     * Frees every chunk that holds no elements of the array.
+     *
+     * Private helper method.
+     */
+    void _free_unused_chunks() noexcept {
+        int64_t n_used_chunks = (size() + chunk_length() - 1) / chunk_length();
+        while(n_chunks > n_used_chunks) {
+            n_chunks--;
+            delete[] chunks[n_chunks];
+        }
+
+        //Free the directory too, if nothing is left in it
+        if(n_chunks == 0) {
+            delete[] chunks;
+            chunks = nullptr;
+            n_directory_slots = 0;
+        }
+    }
+
+
+
+    /**
+     * Frees every chunk and the directory.
+     *
+     * Private helper method.
+     */
+    void _free_all_chunks() noexcept {
+        for(int64_t i = 0; i < n_chunks; i++) {
+            delete[] chunks[i];
+        }
+        delete[] chunks;
+        chunks = nullptr;
+        n_chunks = 0;
+        n_directory_slots = 0;
+    }
+
+
+
+    /**
+     * Copies `n_elems` elements from `source` into the array, starting at flat position `position`.
+     * Copies one contiguous run per chunk. The chunks must already be allocated.
+     *
+     * Private helper method.
+     *
+     * @param source elements to copy
+     * @param n_elems number of elements to copy. Must be non-negative
+     * @param position flat position of the first copied element
+     */
+    void _copy_in(const T* source, int64_t n_elems, int64_t position) noexcept {
+        while(n_elems > 0) {
+            int64_t offset = position % chunk_length();
+            int64_t n_copied = std::min(n_elems, chunk_length() - offset);
+
+            std::copy(source, source + n_copied, chunks[position / chunk_length()] + offset);
+
+            source += n_copied;
+            position += n_copied;
+            n_elems -= n_copied;
+        }
+    }
+
+
+
+    /**
+     * Sets the segment and remainder counts so the array holds `new_size` elements.
+     *
+     * Private helper method.
+     *
+     * @param new_size new number of elements in the array. Must be non-negative
+     */
+    void _set_size(int64_t new_size) noexcept {
+        n_segments = new_size / n_elems_per_segment;
+        n_remainder_elems = (int32_t)(new_size % n_elems_per_segment);
+    }
+
+
+
+    /**
+     * Makes this array a deep copy of `copy_array`. Only allocates the chunks needed to hold `copy_array`'s elements.
+     * This array must not own any chunks.
+     *
+     * Private helper method.
+     *
+     * @param copy_array Chunked Segmented Array to copy
+     */
+    void _copy_from(const chunked_segmented_array& copy_array) {
+        _init_empty(copy_array.n_elems_per_segment, copy_array.n_segments_per_chunk);
+        _reserve_chunks(copy_array.size());
+
+        for(int64_t i = 0; i < n_chunks; i++) {
+            int64_t n_copied = std::min(chunk_length(), copy_array.size() - i * chunk_length());
+            std::copy(copy_array.chunks[i], copy_array.chunks[i] + n_copied, chunks[i]);
+        }
+
+        n_segments = copy_array.n_segments;
+        n_remainder_elems = copy_array.n_remainder_elems;
+    }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+
+public:
+
+    /**
+     * Creates a new Chunked Segmented Array with `segments` segments and `elements_per_segment` elements per segment, with an initial remainder size of `remainder_size`.
+     * All elements are uninitialized.
+     *
+     * @param segments number of segments in the array. Must be non-negative
+     * @param elements_per_segment number of elements per segment in the array. Must be positive
+     * @param remainder_size number of elements in the remainder. Must be non-negative and less than `elements_per_segment`. Default: 0
+     * @param segments_per_chunk number of segments stored in each chunk. Must be non-negative. Default: 0, which picks enough segments to fill 64 KiB
+     */
+    chunked_segmented_array(int64_t segments, int32_t elements_per_segment, int32_t remainder_size = 0, int32_t segments_per_chunk = 0) {
+        assert((segments >= 0 && "Segments must be non-negative"));
+        assert((elements_per_segment > 0 && "Elems. per segment must be positive"));
+        assert((remainder_size >= 0 && "Remainder size cannot be negative"));
+        assert((remainder_size < elements_per_segment && "Remainder size must be less than the number of elements per segment"));
+        assert((segments_per_chunk >= 0 && "Segments per chunk cannot be negative"));
+
+        _init_empty(elements_per_segment, segments_per_chunk);
+        _reserve_chunks((int64_t)segments * (int64_t)elements_per_segment + (int64_t)remainder_size);
+
+        //Set sizes
+        n_segments = segments;
+        n_remainder_elems = remainder_size;
+    }
+
+
+
+    /**
+     * Creates a new Chunked Segmented Array containing the elements of `initial_contents` split into pieces of size `elements_per_segment`.
+     * If `initial_contents.length()` is not evenly divisible by `elements_per_segment`, the resulting array will have a remainder.
+     *
+     * @param initial_contents contents to be placed in the new array
+     * @param elements_per_segment number of elements per segment in the array. Must be positive
+     * @param segments_per_chunk number of segments stored in each chunk. Must be non-negative. Default: 0, which picks enough segments to fill 64 KiB
+     */
+    chunked_segmented_array(const std::basic_string<T>& initial_contents, int32_t elements_per_segment, int32_t segments_per_chunk = 0) {
+        assert(elements_per_segment > 0 && "Number of elements per segment must be positive");
+        assert((segments_per_chunk >= 0 && "Segments per chunk cannot be negative"));
+
+        _init_empty(elements_per_segment, segments_per_chunk);
+        _reserve_chunks((int64_t)initial_contents.length());
+        _copy_in(initial_contents.data(), (int64_t)initial_contents.length(), 0);
+        _set_size((int64_t)initial_contents.length());
+    }
+
+
+
+    /**
+     * Creates a deep copy of `copy_array`. Unused chunks are not copied.
+     *
+     * @param copy_array Chunked Segmented Array to copy
+     */
+    chunked_segmented_array(const chunked_segmented_array& copy_array) {
+        _copy_from(copy_array);
+    }
+
+
+
+    /**
+     * Moves the chunks of `move_array` into a new array without copying any elements.
+     * `move_array` is left empty, with the same number of elements and segments per chunk.
+     *
+     * @param move_array Chunked Segmented Array to move
+     */
+    chunked_segmented_array(chunked_segmented_array&& move_array) noexcept {
+        _init_empty(move_array.n_elems_per_segment, move_array.n_segments_per_chunk);
+        swap(move_array);
+    }
+
+    ///////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////
+    //GETTERS
+
+
+    /**
+     * @return number of elements the allocated chunks can hold, including unused space
+     */
+    int64_t capacity() const noexcept {
+        return n_chunks * chunk_length();
+    }
+
+
+
+    /**
+     * @return number of elements in each chunk
+     */
+    int64_t chunk_length() const noexcept {
+        return (int64_t)n_segments_per_chunk * (int64_t)n_elems_per_segment;
+    }
+
+
+
+    /**
+     * @return number of full-length segments in the array
+     *
+     * The remainder does not count as a full-length segment.
+     */
+    int64_t filled_segment_count() const noexcept {
+        return n_segments;
+    }
+
+
+
+    /**
+     * @return length of each full-sized segment in the array
+     */
+    int32_t filled_segment_length() const noexcept {
+        return n_elems_per_segment;
+    }
+
+
+
+    /**
+     * @return number of elements in the remainder. Returns 0 if no remainder exists.
+     */
+    int32_t remainder_length() const noexcept {
+        return n_remainder_elems;
+    }
+
+
+
+    /**
+     * @return number of segments stored in each chunk
+     */
+    int32_t segments_per_chunk() const noexcept {
+        return n_segments_per_chunk;
+    }
+
+
+
+    /**
+     * @return number of elements in the array (excluding unused space)
+     *
+     * Total elements = number of segments * number of elements per segment + number of remainder elements
+     */
+    int64_t size() const noexcept {
+        return (int64_t)n_segments * (int64_t)n_elems_per_segment + (int64_t)n_remainder_elems;
+    }
+
+
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number` in the array as a character value.
+     *
+     * Segment and element indexing starts at 0. The first element of the first segment is at `{arrayName}.char_at(0,0)`.
+     *
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     *
+     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
+     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
+     * @return character value at segment `segment_number` and position `element_number`
+     */
+    const T& char_at(int64_t segment_number, int32_t element_number) const noexcept {
+        _assert_valid_index(segment_number, element_number);
+        return _segment_start(segment_number)[element_number];
+    }
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number` in the array as a character value.
+     *
+     * Segment and element indexing starts at 0. The first element of the first segment is at `{arrayName}.char_at(0,0)`.
+     *
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     *
+     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
+     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
+     * @return character value at segment `segment_number` and position `element_number`
+     */
+    T& char_at(int64_t segment_number, int32_t element_number) noexcept {
+        _assert_valid_index(segment_number, element_number);
+        return _segment_start(segment_number)[element_number];
+    }
+
+
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number` in the array as an integer value.
+     *
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     *
+     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
+     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
+     * @return value at segment `segment_number` and position `element_number`, as an integer
+     */
+    int32_t int_value_at(int64_t segment_number, int32_t element_number) const noexcept {
+        _assert_valid_index(segment_number, element_number);
+        return (int32_t)_segment_start(segment_number)[element_number];
+    }
+
+
+
+    /**
+     * Returns the element at flat position `flat_index`, after checking that the position is in the array.
+     * The flat position of the element at segment `s` and position `e` is `s * {arrayName}.filled_segment_length() + e`.
+     *
+     * @param flat_index position of the element, counting from the first element of segment 0
+     * @return reference to the element
+     * @throws `std::out_of_range` if `flat_index` is negative or not less than `size()`
+     */
+    T& at(int64_t flat_index) {
+        if(flat_index < 0 || flat_index >= size()) {
+            throw std::out_of_range("Flat index " + std::to_string(flat_index) + " is outside an array of size " + std::to_string(size()));
+        }
+        return _flat_element(flat_index);
+    }
+
+    /**
+     * Returns the element at flat position `flat_index`, after checking that the position is in the array.
+     *
+     * @param flat_index position of the element, counting from the first element of segment 0
+     * @return reference to the element
+     * @throws `std::out_of_range` if `flat_index` is negative or not less than `size()`
+     */
+    const T& at(int64_t flat_index) const {
+        if(flat_index < 0 || flat_index >= size()) {
+            throw std::out_of_range("Flat index " + std::to_string(flat_index) + " is outside an array of size " + std::to_string(size()));
+        }
+        return _flat_element(flat_index);
+    }
+
+
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number`, after checking that it exists.
+     * The check runs whether or not `NDEBUG` is defined, so it is suited to indices from outside the program.
+     *
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     *
+     * @param segment_number segment to access (0-based indexing)
+     * @param element_number element to access in segment `segment_number` (0-based indexing)
+     * @return reference to the element
+     * @throws `std::out_of_range` if the element does not exist
+     */
+    T& checked_at(int64_t segment_number, int32_t element_number) {
+        _check_index(segment_number, element_number);
+        return _segment_start(segment_number)[element_number];
+    }
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number`, after checking that it exists.
+     * The check runs whether or not `NDEBUG` is defined.
+     *
+     * @param segment_number segment to access (0-based indexing)
+     * @param element_number element to access in segment `segment_number` (0-based indexing)
+     * @return reference to the element
+     * @throws `std::out_of_range` if the element does not exist
+     */
+    const T& checked_at(int64_t segment_number, int32_t element_number) const {
+        _check_index(segment_number, element_number);
+        return _segment_start(segment_number)[element_number];
+    }
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number` without any checks, even when assertions are enabled.
+     * For hot loops whose indices are already known to be valid.
+     *
+     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
+     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
+     * @return reference to the element
+     */
+    T& unchecked_at(int64_t segment_number, int32_t element_number) noexcept {
+        return _segment_start(segment_number)[element_number];
+    }
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number` without any checks, even when assertions are enabled.
+     *
+     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
+     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
+     * @return reference to the element
+     */
+    const T& unchecked_at(int64_t segment_number, int32_t element_number) const noexcept {
+        return _segment_start(segment_number)[element_number];
+    }
+
+    /**
+     * Returns the element at flat position `flat_index` without any checks, even when assertions are enabled.
+     *
+     * @param flat_index position of the element, counting from the first element of segment 0. Must be non-negative and less than `size()`
+     * @return reference to the element
+     */
+    T& unchecked_at(int64_t flat_index) noexcept {
+        return _flat_element(flat_index);
+    }
+
+    /**
+     * Returns the element at flat position `flat_index` without any checks, even when assertions are enabled.
+     *
+     * @param flat_index position of the element, counting from the first element of segment 0. Must be non-negative and less than `size()`
+     * @return reference to the element
+     */
+    const T& unchecked_at(int64_t flat_index) const noexcept {
+        return _flat_element(flat_index);
+    }
+
+
+
+    /**
+     * Returns a view of segment `segment_number`, without copying it. Every segment is contiguous, even in a chunked array.
+     *
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     *
+     * @param segment_number segment to view. Must be a valid segment number in the array, or `{arrayName}.filled_segment_count()`
+     * @return view of the segment
+     */
+    segment_view<T> segment(int64_t segment_number) noexcept {
+        assert((segment_number >= 0 && segment_number <= filled_segment_count() && "Segment number must be a valid segment or the remainder"));
+        int32_t segment_length = (segment_number == filled_segment_count()) ? remainder_length() : filled_segment_length();
+
+        //An empty remainder may be past the final chunk
+        if(segment_length == 0) {
+            return segment_view<T>();
+        }
+        return segment_view<T>(_segment_start(segment_number), segment_length);
+    }
+
+    /**
+     * Returns a read-only view of segment `segment_number`, without copying it. Every segment is contiguous, even in a chunked array.
+     *
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     *
+     * @param segment_number segment to view. Must be a valid segment number in the array, or `{arrayName}.filled_segment_count()`
+     * @return view of the segment
+     */
+    segment_view<const T> segment(int64_t segment_number) const noexcept {
+        return const_cast<chunked_segmented_array*>(this)->segment(segment_number);
+    }
+
+
+
+    /**
+     * @return view of the remainder, without copying it. Empty if no remainder exists.
+     */
+    segment_view<T> remainder() noexcept {
+        return segment(filled_segment_count());
+    }
+
+    /**
+     * @return read-only view of the remainder, without copying it. Empty if no remainder exists.
+     */
+    segment_view<const T> remainder() const noexcept {
+        return segment(filled_segment_count());
+    }
+
+
+
+    /**
+     * Returns a range of views of every segment, for use in range-based `for` loops. The remainder is the final segment, if it is not empty.
+     *
+     * @return range of segment views
+     */
+    segment_range<chunked_segmented_array, segment_view<T> > segments() noexcept {
+        return segment_range<chunked_segmented_array, segment_view<T> >(this);
+    }
+
+    /**
+     * Returns a range of read-only views of every segment, for use in range-based `for` loops. The remainder is the final segment, if it is not empty.
+     *
+     * @return range of segment views
+     */
+    segment_range<const chunked_segmented_array, segment_view<const T> > segments() const noexcept {
+        return segment_range<const chunked_segmented_array, segment_view<const T> >(this);
+    }
+
+
+
+    /**
+     * Returns the current contents of the array, in order, as a string of `char` or `wchar_t` (depending on the template's type).
+     *
+     * @return in-order string representation of contents
+     */
+    std::basic_string<T> to_string() const {
+        std::basic_string<T> output;
+        output.reserve(size());
+
+        //Append the used part of every chunk
+        for(int64_t i = 0; i < n_chunks; i++) {
+            int64_t n_used = std::min(chunk_length(), size() - i * chunk_length());
+            if(n_used <= 0) {
+                break;
+            }
+            output.append(chunks[i], n_used);
+        }
+        return output;
+    }
+
+
+
+    ///////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////
+    //SETTERS
+
+    /**
+     * Removes all elements and unused space from the array.
+     */
+    void clear() noexcept {
+        _free_all_chunks();
+        n_segments = 0;
+        n_remainder_elems = 0;
+    }
+
+
+
+    /**
+     * Exchanges the chunks, sizes, and segment lengths of this array and `other_array`. No elements are copied, and nothing is allocated.
+     *
+     * @param other_array array to swap with
+     */
+    void swap(chunked_segmented_array& other_array) noexcept {
+        std::swap(n_segments, other_array.n_segments);
+        std::swap(n_elems_per_segment, other_array.n_elems_per_segment);
+        std::swap(n_remainder_elems, other_array.n_remainder_elems);
+        std::swap(n_segments_per_chunk, other_array.n_segments_per_chunk);
+        std::swap(chunks, other_array.chunks);
+        std::swap(n_chunks, other_array.n_chunks);
+        std::swap(n_directory_slots, other_array.n_directory_slots);
+    }
+
+
+
+    /**
+     * Extends the array's unused space by at least `extension_length` elements. Whole chunks are added, and no elements are moved.
+     *
+     * @param extension_length number of elements to add to the array's unused space. Must be non-negative
+     */
+    void extend_capacity(int64_t extension_length) {
+        assert((extension_length >= 0 && "Extension length cannot be negative"));
+        _reserve_chunks(capacity() + (int64_t)extension_length);
+    }
+
+
+
+    /**
+     * Adds `new_value` to the end of the remainder.
+     * If the remainder is filled, a new segment is created and `new_value` becomes the first value in the segment.
+     *
+     * If every chunk is full, a new chunk is allocated. Existing elements are never moved.
+     * If `shrink_to_fit` is true, chunks left completely unused are freed afterwards.
+     *
+     * @param new_value new element to add to the array
+     * @param shrink_to_fit whether to remove unused chunks after the operation. Default: false.
+     */
+    void push_back(const T& new_value, bool shrink_to_fit = false) {
+        //Idiot check
+        assert((size() <= capacity() && "INTERNAL ERROR- Total element count cannot exceed total size"));
+
+        if(size() == capacity()) {
+            _reserve_chunks(size() + 1);
+        }
+        _flat_element(size()) = new_value;
+
+        //Increase number of remainder elements. If the remainder got filled, take the remainder as a new segment
+        n_remainder_elems++;
+        if(n_remainder_elems == n_elems_per_segment) {
+            n_remainder_elems = 0;
+            n_segments++;
+        }
+
+        if(shrink_to_fit) {
+            _free_unused_chunks();
+        }
+    }
+
+    /**
+     * Adds `new_values` to the end of the last segment, creating enough chunks to fit the new elements.
+     *
+     * Existing elements are never moved.
+     * If `shrink_to_fit` is true, chunks left completely unused are freed afterwards.
+     *
+     * @param new_values new elements to add to the array
+     * @param shrink_to_fit whether to remove unused chunks after the operation. Default: false.
+     */
+    void push_back(const std::basic_string<T>& new_values, bool shrink_to_fit = false) {
+        //Idiot check
+        assert((size() <= capacity() && "INTERNAL ERROR- Total element count cannot exceed total size"));
+
+        //Early exit
+        if(new_values.length() == 0) {
+            return;
+        }
+
+        int64_t old_size = size();
+        _reserve_chunks(old_size + (int64_t)new_values.length());
+        _copy_in(new_values.data(), (int64_t)new_values.length(), old_size);
+        _set_size(old_size + (int64_t)new_values.length());
+
+        if(shrink_to_fit) {
+            _free_unused_chunks();
+        }
+    }
+
+
+
+    /**
+     * Removes `n_elements_to_remove` elements from the final segment(s) of the array.
+     *
+     * If `shrink_to_fit` is false, the removed elements are converted to unused space.
+     * If `shrink_to_fit` is true, chunks left completely unused are freed afterwards.
+     *
+     * @param n_elements_to_remove number of elements to remove. Must be non-negative and no greater than the amount of elements in the array. Default 1.
+     * @param shrink_to_fit whether to remove unused chunks after the operation. Default: false.
+     */
+    void pop_back(int64_t n_elements_to_remove = 1, bool shrink_to_fit = false) {
+        assert((n_elements_to_remove >= 0 && "Number of elements to remove cannot be negative"));
+        assert((n_elements_to_remove <= size() && "Number of elements to remove cannot exceed the number of elements in the array"));
+
+        //Reset removed elements that may own resources
+        if(!std::is_trivially_copyable<T>::value) {
+            for(int64_t i = size() - n_elements_to_remove; i < size(); i++) {
+                _flat_element(i) = T();
+            }
+        }
+        _set_size(size() - n_elements_to_remove);
+
+        if(shrink_to_fit) {
+            _free_unused_chunks();
+        }
+    }
+
+
+
+    /**
+     * Sets the element at segment `segment_number` and position `element_number` in the array to `new_value`.
+     *
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     *
+     * @param segment_number segment number to change. Must be a valid segment number in the array
+     * @param element_number element number to change. Must be a valid element number in the array
+     * @param new_value new value to set at segment `segment_number` and element `element_number`
+     */
+    void set_char_at(int64_t segment_number, int32_t element_number, const T& new_value) {
+        _assert_valid_index(segment_number, element_number);
+        _segment_start(segment_number)[element_number] = new_value;
+    }
+
+
+
+    /**
+     * Sets the element at segment `segment_number` and position `element_number` in the array to `new_value`.
+     *
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     *
+     * @param segment_number segment number to change. Must be a valid segment number in the array
+     * @param element_number element number to change. Must be a valid element number in the array
+     * @param new_value value to set at segment `segment_number` and element `element_number`
+     */
+    void set_int_value_at(int64_t segment_number, int32_t element_number, int32_t new_value) {
+        _assert_valid_index(segment_number, element_number);
+        _segment_start(segment_number)[element_number] = (T)new_value;
+    }
+
+
+
+    /**
+     * Frees every chunk that holds no elements. The final chunk in use keeps its unused space.
+     */
+    void shrink_to_fit() noexcept {
+        _free_unused_chunks();
+    }
+
+
+    //////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////////
+    //OPERATOR OVERLOADS
+
+
+    /**
+     * Copies the contents of `other_array` into this array, returning a reference to this array.
+     *
+     * @param other_array other array to copy
+     * @return reference to the newly copied array
+     */
+    chunked_segmented_array& operator=(const chunked_segmented_array& other_array) {
+        //self assignment check
+        if (this == &other_array) {
+            return *this;
+        }
+
+        //remove current contents, then copy all data from the other array into this array
+        _free_all_chunks();
+        _copy_from(other_array);
+        return *this;
+    }
+
+
+
+    /**
+     * Moves the chunks of `other_array` into this array without copying any elements, returning a reference to this array.
+     * This array's old contents are removed. `other_array` is left empty.
+     *
+     * @param other_array other array to move
+     * @return reference to this array
+     */
+    chunked_segmented_array& operator=(chunked_segmented_array&& other_array) noexcept {
+        //self assignment check
+        if (this == &other_array) {
+            return *this;
+        }
+
+        clear();
+        swap(other_array);
+        return *this;
+    }
+
+
+
+    /**
+     * Returns whether this array and `other_array` are equal in length, have the same number of elements per segment,
+     * and have equal corresponding elements. The number of segments per chunk does not matter.
+     *
+     * @param other_array array to compare to this array
+     * @return true if arrays are equal, false otherwise
+     */
+    bool operator==(const chunked_segmented_array& other_array) const {
+        //Check lengths
+        if(other_array.size() != size()) {
+            return false;
+        }
+
+        //Check elems. per segment
+        if(other_array.filled_segment_length() != filled_segment_length()) {
+            return false;
+        }
+
+        //Check corresponding segments. Each segment is contiguous in both arrays
+        for(int64_t i = 0; i < n_segments; i++) {
+            if(!std::equal(_segment_start(i), _segment_start(i) + n_elems_per_segment, other_array._segment_start(i))) {
+                return false;
+            }
+        }
+        if(n_remainder_elems > 0) {
+            return std::equal(_segment_start(n_segments), _segment_start(n_segments) + n_remainder_elems, other_array._segment_start(n_segments));
+        }
+
+        return true;
+    }
+
+
+
+    /**
+     * Adds `new_char` to the end of the array.
+     *
+     * Equivalent to the `push_back` method.
+     *
+     * @param new_char character to add to the end of the array
+     */
+    void operator+=(const T& new_char) {
+        push_back(new_char);
+    }
+
+    /**
+     * Adds the elements of `new_chars`, in order, to the end of the array.
+     *
+     * Equivalent to the `push_back` method.
+     *
+     * @param new_chars characters to add to the end of the array
+     */
+    void operator+=(const std::basic_string<T>& new_chars) {
+        push_back(new_chars);
+    }
+
+
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number` in the array as a character value.
+     *
+     * Equivalent to the non-const `char_at` method.
+     *
+     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
+     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
+     * @return character value at segment `segment_number` and position `element_number`
+     */
+    T& operator() (int64_t segment_number, int32_t element_number) {
+        _assert_valid_index(segment_number, element_number);
+        return _segment_start(segment_number)[element_number];
+    }
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number` in the array as a character value.
+     *
+     * Equivalent to the const `char_at` method.
+     *
+     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
+     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
+     * @return character value at segment `segment_number` and position `element_number`
+     */
+    const T& operator() (int64_t segment_number, int32_t element_number) const {
+        _assert_valid_index(segment_number, element_number);
+        return _segment_start(segment_number)[element_number];
+    }
+
+    /**
+     * Returns the element at flat position `flat_index`, without dividing it into segment and element numbers.
+     * The flat position of the element at segment `s` and position `e` is `s * {arrayName}.filled_segment_length() + e`.
+     *
+     * @param flat_index position of the element, counting from the first element of segment 0. Must be non-negative and less than `size()`
+     * @return reference to the element
+     */
+    T& operator[](int64_t flat_index) noexcept {
+        assert((flat_index >= 0 && flat_index < size() && "Flat index must be in the array"));
+        return _flat_element(flat_index);
+    }
+
+    /**
+     * Returns the element at flat position `flat_index`, without dividing it into segment and element numbers.
+     *
+     * @param flat_index position of the element, counting from the first element of segment 0. Must be non-negative and less than `size()`
+     * @return reference to the element
+     */
+    const T& operator[](int64_t flat_index) const noexcept {
+        assert((flat_index >= 0 && flat_index < size() && "Flat index must be in the array"));
+        return _flat_element(flat_index);
+    }
+
+
+
+    /**
+     * Exports the in-order contents of `arr` to the output stream `output_stream`, returning a reference to `output_stream` with `arr` added.
+     *
+     * Elements of the stream's character type are written with one `write` per chunk, without a temporary string and without padding to the stream's width.
+     * Other elements are written one at a time with `<<`.
+     *
+     * @param output_stream output stream to export to
+     * @param arr Chunked Segmented Array to export
+     * @return `output_stream` containing the array's information inside
+     */
+    template<typename CharT, typename Traits, typename Tp>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const chunked_segmented_array<Tp>& arr);
+
+
+    //////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////////
+    //DESTRUCTOR
+
+    /**
+     * Properly destroys a Chunked Segmented Array.
+     */
+    ~chunked_segmented_array() {
+        _free_all_chunks();
+    }
+};
+
+
+
+/**
+ * Exchanges the contents of `a` and `b` without copying any elements.
+ *
+ * @param a first array to swap
+ * @param b second array to swap
+ */
+template<typename T>
+void swap(chunked_segmented_array<T>& a, chunked_segmented_array<T>& b) noexcept {
+    a.swap(b);
+}
+
+
+
+template<typename CharT, typename Traits, typename T>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const chunked_segmented_array<T>& arr) {
+    //Write the used part of every chunk at once
+    for(int64_t i = 0; i < arr.n_chunks; i++) {
+        int64_t n_used = std::min(arr.chunk_length(), arr.size() - i * arr.chunk_length());
+        if(n_used <= 0) {
+            break;
+        }
+        arr._write_elements(output_stream, arr.chunks[i], n_used, std::integral_constant<bool, std::is_same<T, CharT>::value>());
+    }
+    return output_stream;
+}
+
+
+
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+
+//File descriptors need POSIX `read`
+#if defined(__unix__) || defined(__APPLE__)
+    #define UTILS_HAS_FD_IO
+    #include <unistd.h>
+#endif
+
+namespace utils {
+
+
+
+
+/**
+ * Reads up to `n_bytes` bytes from the file descriptor `fd` into `destination`.
+ * Keeps reading until `n_bytes` bytes arrive or the end of the input is reached, so it also works for pipes and sockets.
+ *
+ * @param fd open file descriptor to read from
+ * @param destination memory to read into. Must have room for `n_bytes` bytes
+ * @param n_bytes largest number of bytes to read. Must be non-negative
+ * @return number of bytes read. Less than `n_bytes` only at the end of the input
+ * @throws `std::system_error` if reading fails, or if the platform has no file descriptors
+ */
+inline int64_t read_fd(int fd, void* destination, int64_t n_bytes) {
+    #ifdef UTILS_HAS_FD_IO
+        char* next = static_cast<char*>(destination);
+        int64_t n_read = 0;
+        while(n_read < n_bytes) {
+            ssize_t result = read(fd, next + n_read, (size_t)(n_bytes - n_read));
+            if(result == 0) {
+                break;
+            }
+            if(result < 0) {
+                //Interrupted before anything arrived, so try again
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "Cannot read from file descriptor");
+            }
+            n_read += (int64_t)result;
+        }
+        return n_read;
+    #else
+        (void)fd;
+        (void)destination;
+        (void)n_bytes;
+        throw std::system_error(std::make_error_code(std::errc::function_not_supported), "File descriptors are not supported on this platform");
+    #endif
+}
+
+
+
+
+}
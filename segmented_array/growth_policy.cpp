@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+
+namespace utils {
+
+
+
+
+/**
+ * Growth policy that matches how the Segmented Array grew before growth policies existed:
+ * an empty array grows to exactly the required size, and any other array grows to twice the required size.
+ *
+ * A growth policy decides the new capacity whenever an append needs more room than the array has.
+ * It is consulted by every operation that adds elements: `push_back` and `+=` without `shrink_to_fit`, both `append` overloads,
+ * both `append_from` overloads, and `insert`. `reserve`, `extend_capacity`, and `shrink_to_fit` set the capacity exactly.
+ *
+ * Every policy has one static method, `new_capacity`, which must return at least `required_size`.
+ */
+struct default_growth {
+    /**
+     * Returns the capacity an array should grow to.
+     *
+     * @param old_size number of elements in the array before the append
+     * @param required_size number of elements in the array after the append
+     * @param old_capacity capacity of the array before the append. Less than `required_size`
+     * @param segment_length number of elements per segment in the array
+     * @return new capacity. At least `required_size`
+     */
+    static int64_t new_capacity(int64_t old_size, int64_t required_size, int64_t old_capacity, int32_t segment_length) noexcept {
+        (void)old_capacity;
+        (void)segment_length;
+        return (old_size == 0) ? required_size : required_size * 2;
+    }
+};
+
+
+
+/**
+ * Growth policy that multiplies the old capacity by `Numerator / Denominator`, or grows to the required size if that is larger.
+ *
+ * Smaller factors waste less memory but reallocate more often. A factor of at least 2 makes appends take amortized constant time with the fewest reallocations.
+ *
+ * @param Numerator numerator of the growth factor. Must be greater than `Denominator`
+ * @param Denominator denominator of the growth factor. Must be positive. Default: 1
+ */
+template<int64_t Numerator, int64_t Denominator = 1>
+struct geometric_growth {
+    static_assert(Denominator > 0 && Numerator > Denominator, "The growth factor must be greater than 1");
+
+    /**
+     * Returns the capacity an array should grow to.
+     *
+     * @param old_size number of elements in the array before the append
+     * @param required_size number of elements in the array after the append
+     * @param old_capacity capacity of the array before the append. Less than `required_size`
+     * @param segment_length number of elements per segment in the array
+     * @return new capacity. At least `required_size`
+     */
+    static int64_t new_capacity(int64_t old_size, int64_t required_size, int64_t old_capacity, int32_t segment_length) noexcept {
+        (void)old_size;
+        (void)segment_length;
+        int64_t grown = old_capacity / Denominator * Numerator + old_capacity % Denominator * Numerator / Denominator;
+        return (grown > required_size) ? grown : required_size;
+    }
+};
+
+
+
+/**
+ * Growth policy that rounds the capacity chosen by `BasePolicy` up to a whole number of segments,
+ * so the unused space always ends on a segment boundary.
+ *
+ * @param BasePolicy growth policy to round. Default: `default_growth`
+ */
+template<typename BasePolicy = default_growth>
+struct segment_aligned_growth {
+    /**
+     * Returns the capacity an array should grow to.
+     *
+     * @param old_size number of elements in the array before the append
+     * @param required_size number of elements in the array after the append
+     * @param old_capacity capacity of the array before the append. Less than `required_size`
+     * @param segment_length number of elements per segment in the array
+     * @return new capacity. At least `required_size`
+     */
+    static int64_t new_capacity(int64_t old_size, int64_t required_size, int64_t old_capacity, int32_t segment_length) noexcept {
+        int64_t base = BasePolicy::new_capacity(old_size, required_size, old_capacity, segment_length);
+        return (base + segment_length - 1) / segment_length * segment_length;
+    }
+};
+
+
+
+/**
+ * Growth policy that limits the unused space chosen by `BasePolicy` to at most `MaxUnusedElements` elements.
+ *
+ * Large arrays stop growing geometrically once they reach the cap, which bounds wasted memory but makes later appends reallocate more often.
+ *
+ * @param MaxUnusedElements largest number of unused elements left after an append. Must be non-negative
+ * @param BasePolicy growth policy to limit. Default: `default_growth`
+ */
+template<int64_t MaxUnusedElements, typename BasePolicy = default_growth>
+struct capped_growth {
+    static_assert(MaxUnusedElements >= 0, "The maximum unused space cannot be negative");
+
+    /**
+     * Returns the capacity an array should grow to.
+     *
+     * @param old_size number of elements in the array before the append
+     * @param required_size number of elements in the array after the append
+     * @param old_capacity capacity of the array before the append. Less than `required_size`
+     * @param segment_length number of elements per segment in the array
+     * @return new capacity. At least `required_size`
+     */
+    static int64_t new_capacity(int64_t old_size, int64_t required_size, int64_t old_capacity, int32_t segment_length) noexcept {
+        int64_t base = BasePolicy::new_capacity(old_size, required_size, old_capacity, segment_length);
+        return (base - required_size > MaxUnusedElements) ? required_size + MaxUnusedElements : base;
+    }
+};
+
+
+
+
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+//Memory-mapped files need POSIX `mmap`
+#if defined(__unix__) || defined(__APPLE__)
+    #define UTILS_HAS_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace utils {
+
+
+
+
+/**
+ * How a file is mapped into memory
+ */
+enum class map_mode {
+    /**
+     * The mapping cannot be written to. Writing to it crashes the program.
+     */
+    READ_ONLY,
+
+    /**
+     * Writes change this process's copy of the pages only, and never reach the file
+     */
+    COPY_ON_WRITE,
+
+    /**
+     * Writes reach the file, at the latest when the mapping is flushed or unmapped
+     */
+    READ_WRITE
+};
+
+
+
+/**
+ * Maps the whole file at `path` into memory. Pages are read from the file the first time they are accessed.
+ *
+ * @param path path of the file to map
+ * @param mode how to map the file
+ * @param n_bytes set to the size of the file, in bytes
+ * @return pointer to the first byte of the mapping, or `nullptr` if the file is empty
+ * @throws `std::system_error` if the file cannot be opened or mapped, or if the platform has no memory-mapped files
+ */
+inline void* map_file(const std::string& path, map_mode mode, int64_t& n_bytes) {
+    #ifdef UTILS_HAS_MMAP
+        int fd = open(path.c_str(), (mode == map_mode::READ_WRITE) ? O_RDWR : O_RDONLY);
+        if(fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        }
+
+        struct stat file_info;
+        if(fstat(fd, &file_info) != 0) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "Cannot read the size of " + path);
+        }
+        n_bytes = (int64_t)file_info.st_size;
+
+        //Empty files cannot be mapped
+        if(n_bytes == 0) {
+            close(fd);
+            return nullptr;
+        }
+
+        int protection = (mode == map_mode::READ_ONLY) ? PROT_READ : (PROT_READ | PROT_WRITE);
+        int sharing = (mode == map_mode::COPY_ON_WRITE) ? MAP_PRIVATE : MAP_SHARED;
+        void* mapping = mmap(nullptr, (size_t)n_bytes, protection, sharing, fd, 0);
+        int error = errno;
+
+        //The mapping stays valid after the file is closed
+        close(fd);
+        if(mapping == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "Cannot map " + path);
+        }
+        return mapping;
+    #else
+        (void)path;
+        (void)mode;
+        (void)n_bytes;
+        throw std::system_error(std::make_error_code(std::errc::function_not_supported), "Memory-mapped files are not supported on this platform");
+    #endif
+}
+
+
+
+/**
+ * Writes every change to a `READ_WRITE` mapping back to its file, and waits until the writes finish.
+ * Does nothing for other mappings.
+ *
+ * @param mapping pointer returned by `map_file`. May be `nullptr`
+ * @param n_bytes size of the mapping, in bytes
+ * @throws `std::system_error` if the changes cannot be written
+ */
+inline void flush_mapping(void* mapping, int64_t n_bytes) {
+    #ifdef UTILS_HAS_MMAP
+        if(mapping != nullptr && msync(mapping, (size_t)n_bytes, MS_SYNC) != 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot flush mapped file");
+        }
+    #else
+        (void)mapping;
+        (void)n_bytes;
+    #endif
+}
+
+
+
+/**
+ * Unmaps a mapping returned by `map_file`. Changes to a `READ_WRITE` mapping still reach the file.
+ *
+ * @param mapping pointer returned by `map_file`. May be `nullptr`
+ * @param n_bytes size of the mapping, in bytes
+ */
+inline void unmap_file(void* mapping, int64_t n_bytes) noexcept {
+    #ifdef UTILS_HAS_MMAP
+        if(mapping != nullptr) {
+            munmap(mapping, (size_t)n_bytes);
+        }
+    #else
+        (void)mapping;
+        (void)n_bytes;
+    #endif
+}
+
+
+
+
+}
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+#if __cplusplus >= 201703L
+    #include <string_view>
+#endif
+
+namespace utils {
+
+
+
+
+/**
+ * A non-owning view of one segment of a segmented array: a pointer to the segment's first element, and its length.
+ *
+ * The view does not copy the segment. It is invalidated by any operation that moves or frees the array's contents,
+ * such as appending past the array's capacity, `shrink_to_fit`, or destroying the array.
+ *
+ * When compiled for C++17 or later, a view of characters converts to a `std::basic_string_view`.
+ *
+ * @param T datatype stored in the viewed array. A `const` type gives a read-only view
+ */
+template<typename T>
+class segment_view {
+private:
+    /**
+     * First element of the segment. `nullptr` only if the view is empty.
+     */
+    T* first;
+
+    /**
+     * Number of elements in the segment
+     */
+    int64_t n_elems;
+
+public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef int64_t size_type;
+
+    /**
+     * Creates an empty view.
+     */
+    segment_view() noexcept : first(nullptr), n_elems(0) {}
+
+    /**
+     * Creates a view of the `length` elements starting at `first_element`.
+     *
+     * @param first_element first element in the view
+     * @param length number of elements in the view. Must be non-negative
+     */
+    segment_view(T* first_element, int64_t length) noexcept : first(first_element), n_elems(length) {
+        assert((length >= 0 && "Length cannot be negative"));
+    }
+
+    /**
+     * Creates a read-only view of the same elements as `other_view`.
+     *
+     * @param other_view view to copy. Its type must be the non-const version of this view's type
+     */
+    template<typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+    segment_view(const segment_view<U>& other_view) noexcept : first(other_view.data()), n_elems(other_view.size()) {}
+
+
+    /**
+     * @return pointer to the first element. The other elements follow it contiguously
+     */
+    T* data() const noexcept {
+        return first;
+    }
+
+    /**
+     * @return number of elements in the view
+     */
+    int64_t size() const noexcept {
+        return n_elems;
+    }
+
+    /**
+     * @return true if the view has no elements, false otherwise
+     */
+    bool empty() const noexcept {
+        return n_elems == 0;
+    }
+
+    /**
+     * @return pointer to the first element
+     */
+    T* begin() const noexcept {
+        return first;
+    }
+
+    /**
+     * @return pointer one past the final element
+     */
+    T* end() const noexcept {
+        return first + n_elems;
+    }
+
+    /**
+     * Returns the element at position `index` in the segment.
+     *
+     * @param index position to access. Must be non-negative and less than `size()`
+     * @return reference to the element
+     */
+    T& operator[](int64_t index) const noexcept {
+        assert((index >= 0 && index < n_elems && "Index must be in the view"));
+        return first[index];
+    }
+
+    /**
+     * Returns the segment's elements as a new string. Only available for character types.
+     *
+     * @return copy of the segment's elements
+     */
+    std::basic_string<typename std::remove_const<T>::type> to_string() const {
+        return std::basic_string<typename std::remove_const<T>::type>(first, (size_t)n_elems);
+    }
+
+#if __cplusplus >= 201703L
+    /**
+     * Returns a string view of the same elements. Only available for character types.
+     *
+     * @return string view of the segment
+     */
+    operator std::basic_string_view<typename std::remove_const<T>::type>() const noexcept {
+        return std::basic_string_view<typename std::remove_const<T>::type>(first, (size_t)n_elems);
+    }
+#endif
+};
+
+
+
+
+/**
+ * Iterator over the segments of a segmented array, giving a `segment_view` of each segment.
+ * The remainder, if it is not empty, is the final segment.
+ *
+ * Dereferencing returns a view by value, so this is an input iterator.
+ *
+ * @param Array type of segmented array. A `const` type gives read-only views
+ * @param View type of view returned for each segment
+ */
+template<typename Array, typename View>
+class segment_iterator {
+private:
+    /**
+     * Array the segments belong to
+     */
+    Array* arr;
+
+    /**
+     * Segment number of the current segment
+     */
+    int64_t segment_number;
+
+public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef View value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const View* pointer;
+    typedef View reference;
+
+    /**
+     * Creates an iterator at segment `start_segment` of `array`.
+     *
+     * @param array array to iterate over
+     * @param start_segment segment number to start at
+     */
+    segment_iterator(Array* array, int64_t start_segment) noexcept : arr(array), segment_number(start_segment) {}
+
+    /**
+     * @return view of the current segment
+     */
+    View operator*() const noexcept {
+        return arr->segment(segment_number);
+    }
+
+    /**
+     * Moves to the next segment.
+     *
+     * @return reference to this iterator
+     */
+    segment_iterator& operator++() noexcept {
+        segment_number++;
+        return *this;
+    }
+
+    /**
+     * Moves to the next segment.
+     *
+     * @return copy of this iterator from before it moved
+     */
+    segment_iterator operator++(int) noexcept {
+        segment_iterator old = *this;
+        segment_number++;
+        return old;
+    }
+
+    /**
+     * @param other iterator to compare to
+     * @return true if both iterators are at the same segment of the same array, false otherwise
+     */
+    bool operator==(const segment_iterator& other) const noexcept {
+        return arr == other.arr && segment_number == other.segment_number;
+    }
+
+    /**
+     * @param other iterator to compare to
+     * @return true if the iterators are at different segments, false otherwise
+     */
+    bool operator!=(const segment_iterator& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+
+
+
+/**
+ * Range of every segment of a segmented array, for use in range-based `for` loops.
+ * The remainder, if it is not empty, is the final segment.
+ *
+ * @param Array type of segmented array. A `const` type gives read-only views
+ * @param View type of view returned for each segment
+ */
+template<typename Array, typename View>
+class segment_range {
+private:
+    /**
+     * Array the segments belong to
+     */
+    Array* arr;
+
+public:
+    /**
+     * Creates a range over the segments of `array`.
+     *
+     * @param array array whose segments to iterate over
+     */
+    explicit segment_range(Array* array) noexcept : arr(array) {}
+
+    /**
+     * @return iterator at the first segment
+     */
+    segment_iterator<Array, View> begin() const noexcept {
+        return segment_iterator<Array, View>(arr, 0);
+    }
+
+    /**
+     * @return iterator one past the final segment (or past the remainder, if it is not empty)
+     */
+    segment_iterator<Array, View> end() const noexcept {
+        return segment_iterator<Array, View>(arr, size());
+    }
+
+    /**
+     * @return number of segments in the range, counting a non-empty remainder
+     */
+    int64_t size() const noexcept {
+        return (int64_t)arr->filled_segment_count() + (arr->remainder_length() > 0 ? 1 : 0);
+    }
+};
+
+
+
+
+}
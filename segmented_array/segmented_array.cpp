@@ -1,10 +1,31 @@
-//Uncomment to disable assertions.
-// #define NDEBUG
+#pragma once
 
+//Accessors such as `char_at` and `operator()` check indices with `assert`, so defining NDEBUG removes their checks.
+//`checked_at` always checks and `unchecked_at` never checks, whether or not NDEBUG is defined.
+
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <new>
+#include <ostream>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "binary_format.cpp"
+#include "fd_io.cpp"
+#include "growth_policy.cpp"
+#include "mapped_file.cpp"
+#include "segment_view.cpp"
+#include "simd_kernels.cpp"
+#include "thread_pool.cpp"
 
 namespace utils {
 
@@ -12,7 +33,7 @@ namespace utils {
 
 
 /**
- * A 2D resizeable array that stores data of type `char` or `wchar_t` only.
+ * A 2D resizeable array that stores data of any type.
  * 
  * Data is divided into segments of a set length. Segment and element indexing is 0-based.
  * 
@@ -27,9 +48,16 @@ namespace utils {
  * 
  * Uses a pointer to an array to store its contents. This is not a linked list
  * 
- * @param T datatype (either `char` or `wchar_t`) stored in the array
+ * Trivially copyable types (characters, numbers, plain structs) are copied and moved as raw bytes.
+ * Other types are constructed when added and destroyed when removed, and unused space holds no objects.
+ * 
+ * @param T datatype stored in the array
+ * @param GrowthPolicy decides how much unused space to add when an append needs more room. Default: `default_growth`
+ * @param SegmentLength number of elements per segment, fixed at compile time, or 0 to choose it when the array is constructed. Default: 0.
+ * A fixed length lets the compiler replace multiplication, division, and modulo by the segment length with cheaper operations,
+ * and a power-of-two length turns them into shifts and masks.
  */
-template <typename T> 
+template <typename T, typename GrowthPolicy = default_growth, int32_t SegmentLength = 0> 
 class segmented_array {
 /*
 The original version did not support resizing.
@@ -42,7 +70,7 @@ private:
      * 
      * Non-negative.
      */
-    int32_t n_segments;
+    int64_t n_segments;
 
     /**
      * Number of elements in each full-length segment in the array
@@ -75,6 +103,18 @@ private:
      */
     int64_t n_contents_elems;
 
+    /**
+     * Start of the memory-mapped file that `contents` points into, or `nullptr` if `contents` was allocated normally.
+     * 
+     * Once the contents move to new memory (for example, by appending past the capacity), the file is unmapped and this becomes `nullptr`.
+     */
+    void* mapping;
+
+    /**
+     * Size of `mapping`, in bytes. 0 if no file is mapped.
+     */
+    int64_t n_mapping_bytes;
+
 
     //////////////////////////////////////////////////////////////////////////////////////
     //////////////////////////////////////////////////////////////////////////////////////
@@ -82,6 +122,98 @@ private:
     //////////////////////////////////////////////////////////////////////////////////////
     //PRIVATE HELPERS
 
+    static_assert(SegmentLength >= 0, "The fixed segment length cannot be negative");
+
+    /**
+     * Returns the base-2 logarithm of `n`, rounded down.
+     * 
+     * Private helper method.
+     * 
+     * @param n positive number
+     * @return largest `k` with `2^k <= n`
+     */
+    static constexpr int32_t _log2(int32_t n) noexcept {
+        return (n <= 1) ? 0 : 1 + _log2(n / 2);
+    }
+
+    /**
+     * Whether the segment length is fixed at compile time
+     */
+    static constexpr bool fixed_length = SegmentLength > 0;
+
+    /**
+     * Whether the segment length is fixed at compile time and is a power of two, so addressing uses shifts and masks
+     */
+    static constexpr bool power_of_two_length = fixed_length && (SegmentLength & (SegmentLength - 1)) == 0;
+
+    /**
+     * Base-2 logarithm of the segment length, if `power_of_two_length`
+     */
+    static constexpr int32_t length_shift = _log2(SegmentLength);
+
+
+
+    /**
+     * Returns the number of elements per segment: the compile-time `SegmentLength` if it is fixed, or `n_elems_per_segment` otherwise.
+     * 
+     * Private helper method.
+     * 
+     * @return number of elements per full-length segment
+     */
+    int32_t _segment_length() const noexcept {
+        return fixed_length ? SegmentLength : n_elems_per_segment;
+    }
+
+
+
+    /**
+     * Returns the flat position of the element at segment `segment_number` and position `element_number`, counting from the first element of segment 0.
+     * 
+     * Private helper method.
+     * 
+     * @param segment_number segment number. Must be non-negative
+     * @param element_number position in the segment. Must be non-negative and less than the segment length
+     * @return flat position of the element
+     */
+    int64_t _flat_index(int64_t segment_number, int32_t element_number) const noexcept {
+        if(power_of_two_length) {
+            return (segment_number << length_shift) | element_number;
+        }
+        return segment_number * _segment_length() + element_number;
+    }
+
+    /**
+     * Returns the segment number of the element at flat position `flat_index`.
+     * 
+     * Private helper method.
+     * 
+     * @param flat_index flat position. Must be non-negative
+     * @return segment number holding the position
+     */
+    int64_t _segment_of(int64_t flat_index) const noexcept {
+        if(power_of_two_length) {
+            return (int64_t)((uint64_t)flat_index >> length_shift);
+        }
+        return flat_index / _segment_length();
+    }
+
+    /**
+     * Returns the position within its segment of the element at flat position `flat_index`.
+     * 
+     * Private helper method.
+     * 
+     * @param flat_index flat position. Must be non-negative
+     * @return position in the segment holding the element
+     */
+    int32_t _element_of(int64_t flat_index) const noexcept {
+        if(power_of_two_length) {
+            return (int32_t)(flat_index & (SegmentLength - 1));
+        }
+        return (int32_t)(flat_index % _segment_length());
+    }
+
+
+
     /**
      * Checks if `segment_number` and `elem_number` are valid indices in the array.
      * If not, raises an assertion.
@@ -91,7 +223,7 @@ private:
      * @param segment_number segment index to check
      * @param elem_number element index to check
      */
-    void _assert_valid_index(int32_t segment_number, int32_t elem_number) const {
+    void _assert_valid_index(int64_t segment_number, int32_t elem_number) const {
         //Automatic exit if assertions are disabled
         #ifndef NDEBUG
             //Check for integer overflow
@@ -120,424 +252,1605 @@ private:
 
 
     /**
-     * Appends `new_value` to the remainder. If the remainder is filled, a new segment is created and `new_value` becomes the first value in the segment.
-     * 
-     * If the array is too small to hold the new elements, the array increases its size to hold the new elements.
-     * It also adds twice its new length in unused elements.
+     * Returns whether segment `segment_number` and position `elem_number` hold an element of the array.
+     * Unlike `_assert_valid_index`, the check runs whether or not `NDEBUG` is defined.
      * 
-     * The method is private to prevent the public method `push_back` from becoming too cluttered.
+     * Private helper method.
      * 
-     * @param new_value value to append to the array
+     * @param segment_number segment index to check
+     * @param elem_number element index to check
+     * @return true if the element exists, false otherwise
      */
-    void _push_back_char(T new_value) {
-
-        //Idiot check
-        assert(size() <= capacity() && "INTERNAL ERROR- Total element count cannot exceed total size");
-
-        //If there is not enough room, extend the array
-        if(size() == capacity()) {
-            
-            //Track the actual new size, since the doubling of the array size will not work if the array is empty
-            int64_t new_size = size()==0 ? 1 : (size()+1)*2; //1 if array is empty, 2x the new size otherwise
-
-            //Create new array pointer with more elements than before
-            T* new_contents = new T[new_size];
-            //Update size of contents
-            n_contents_elems = new_size;
-
-            //Copy current contents to new array, then put the new value in
-            std::copy(contents, contents + size(), new_contents);
-            
-            //Make the current contents point to the newly allocated memory
-            delete[] contents;
-            contents = new_contents;
+    bool _is_valid_index(int64_t segment_number, int32_t elem_number) const noexcept {
+        if(segment_number < 0 || elem_number < 0) {
+            return false;
         }
+        if(segment_number < n_segments) {
+            return elem_number < filled_segment_length();
+        }
+        return segment_number == n_segments && elem_number < n_remainder_elems;
+    }
 
-        //add the new element
-        contents[size()] = new_value;
 
-        //Increase number of remainder elements. The new element was likely added to the remainder
-        n_remainder_elems++;
 
-        //If the remainder got filled, take the remainder as a new segment
-        if(n_remainder_elems == n_elems_per_segment) {
-            n_remainder_elems = 0;
-            n_segments++;
+    /**
+     * Throws if segment `segment_number` and position `elem_number` do not hold an element of the array, whether or not `NDEBUG` is defined.
+     * 
+     * Private helper method.
+     * 
+     * @param segment_number segment index to check
+     * @param elem_number element index to check
+     * @throws `std::out_of_range` if the element does not exist
+     */
+    void _check_index(int64_t segment_number, int32_t elem_number) const {
+        if(!_is_valid_index(segment_number, elem_number)) {
+            throw std::out_of_range("Segment " + std::to_string(segment_number) + ", element " + std::to_string(elem_number) + " is outside the array");
         }
     }
 
 
 
     /**
-     * Adds `new_value` to the end of the final segment, then removes any unused space. 
-     * Faster than `push_back_string` and `shrink_to_fit` called separately.
+     * Throws if `elements_per_segment` differs from the fixed segment length, so constructors never count with one length and address with another.
+     * Does nothing if the segment length is not fixed.
      * 
-     * The method is private to prevent the public method `push_back` from becoming too cluttered.
+     * Private helper method.
      * 
-     * @param new_value new elements to add to the last segment
+     * @param elements_per_segment segment length passed to a constructor
+     * @throws `std::invalid_argument` if `SegmentLength` is fixed and differs from `elements_per_segment`
      */
-    void _push_back_char_and_resize(T new_value) {
-        //Make new pointer for the new element
-        T* new_contents = new T[size() + 1];
-        
-        //Copy current contents to new array, then put the new value in
-        std::copy(contents, contents + size(), new_contents);
-        new_contents[size()] = new_value;
-        
-        
-        //Switch pointers
-        delete[] contents;
-        contents = new_contents;
+    static void _check_segment_length(int32_t elements_per_segment) {
+        if(fixed_length && elements_per_segment != SegmentLength) {
+            throw std::invalid_argument("Number of elements per segment must equal the fixed segment length of " + std::to_string(SegmentLength));
+        }
+    }
+
+
+
+    /**
+     * Whether elements can be copied and moved as raw bytes, and need no construction or destruction
+     */
+    typedef std::integral_constant<bool, std::is_trivially_copyable<T>::value> trivial_elements;
+
+    /**
+     * Whether elements are equal exactly when their bytes are equal, and are 1, 2, 4, or 8 bytes wide,
+     * so they can be compared by the vector kernels in `simd_kernels.cpp`
+     */
+    typedef std::integral_constant<bool, (std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value)
+        && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> vector_comparable;
 
-        //Increase number of remainder elements. The new element was likely added to the remainder
-        n_remainder_elems++;
 
-        //If the remainder got filled, take the remainder as a new segment
-        if(n_remainder_elems == n_elems_per_segment) {
-            n_remainder_elems = 0;
-            n_segments++;
+
+    /**
+     * Returns uninitialized memory for `n_elems` elements, or `nullptr` if `n_elems` is 0.
+     * 
+     * Private helper method.
+     * 
+     * @param n_elems number of elements to allocate memory for. Must be non-negative
+     * @return pointer to the memory
+     * @throws `std::bad_alloc` if the memory cannot be allocated
+     */
+    static T* _allocate(int64_t n_elems) {
+        if(n_elems == 0) {
+            return nullptr;
         }
+        return static_cast<T*>(::operator new((size_t)n_elems * sizeof(T)));
+    }
 
-        //Update contents size
-        n_contents_elems = size();
+    /**
+     * Frees memory returned by `_allocate`. Any elements in the memory must have already been destroyed.
+     * 
+     * Private helper method.
+     * 
+     * @param memory memory to free. May be `nullptr`
+     */
+    static void _deallocate(T* memory) noexcept {
+        ::operator delete(memory);
     }
 
 
 
     /**
-     * Adds the elements of `new_values` to the end of the array.
-     * Creates enough new segments and elements to hold the new values.
+     * Creates `n_elems` elements, starting at `destination`.
+     * Trivially copyable elements are left uninitialized. Other elements are default-constructed.
      * 
-     * If the array is too small to hold the new elements, the array increases its size to hold the new elements.
-     * It also adds twice its new length in unused elements.
+     * If a constructor throws, every element created so far is destroyed.
      * 
-     * The method is private to prevent the public method `push_back` from becoming too cluttered.
+     * Private helper method.
      * 
-     * @param new_values new elements to add to the last segment(s)
+     * @param destination uninitialized memory for the elements
+     * @param n_elems number of elements to create
      */
-    void _push_back_string(const std::basic_string<T>& new_values) {
+    static void _construct_default(T* destination, int64_t n_elems) {
+        _construct_default(destination, n_elems, trivial_elements());
+    }
 
-        //If there is no more room, extend the array
-        if(this->size() + new_values.length() - 1 >= n_contents_elems) {
-            //Track the actual new size, since the doubling of the array size will not work if the array is empty
-            int64_t new_size = size()==0 ? new_values.length() : ((int64_t)new_values.length() + this->size())*2; //string's length if array is empty, 2x the new size otherwise
+    static void _construct_default(T* destination, int64_t n_elems, std::true_type) noexcept {
+        (void)destination;
+        (void)n_elems;
+    }
+
+    static void _construct_default(T* destination, int64_t n_elems, std::false_type) {
+        int64_t i = 0;
+        try {
+            for(; i < n_elems; i++) {
+                new (destination + i) T();
+            }
+        }
+        catch(...) {
+            _destroy(destination, i);
+            throw;
+        }
+    }
 
-            //Create new array pointer with enough elements to hold the new contents
-            T* new_contents = new T[new_size];
-            //Update size of contents
-            n_contents_elems = new_size;
 
-            //Copy current contents to new array
-            std::copy(contents, contents + this->size(), new_contents);
 
-            //Make the current contents point to the newly allocated memory
-            delete[] contents;
-            contents = new_contents;
-        }
+    /**
+     * Copies `n_elems` elements from `source` into uninitialized memory starting at `destination`.
+     * The two ranges must not overlap.
+     * 
+     * If a copy constructor throws, every element created so far is destroyed.
+     * 
+     * Private helper method.
+     * 
+     * @param source elements to copy
+     * @param n_elems number of elements to copy
+     * @param destination uninitialized memory for the copies
+     */
+    static void _construct_copy(const T* source, int64_t n_elems, T* destination) {
+        _construct_copy(source, n_elems, destination, trivial_elements());
+    }
 
-        //Put the new values in
-        for(int64_t i = this->size(); i < this->size() + (int64_t)new_values.length(); i++) {
-            contents[i] = new_values[i - size()];
+    static void _construct_copy(const T* source, int64_t n_elems, T* destination, std::true_type) noexcept {
+        if(n_elems > 0) {
+            std::memcpy(destination, source, (size_t)n_elems * sizeof(T));
         }
+    }
 
-        //Update remainder and elem. counts
-        n_segments = n_segments + ((n_remainder_elems + new_values.length()) / n_elems_per_segment);
-        n_remainder_elems = (n_remainder_elems + new_values.length()) % n_elems_per_segment;
+    static void _construct_copy(const T* source, int64_t n_elems, T* destination, std::false_type) {
+        int64_t i = 0;
+        try {
+            for(; i < n_elems; i++) {
+                new (destination + i) T(source[i]);
+            }
+        }
+        catch(...) {
+            _destroy(destination, i);
+            throw;
+        }
     }
 
 
 
     /**
-     * Adds the elements of `new_values` to the end of the array.
-     * Creates enough new segments and elements to hold the new values.
+     * Moves `n_elems` elements from `source` into uninitialized memory starting at `destination`, then destroys the elements in `source`.
+     * The two ranges must not overlap.
      * 
-     * This function also removes unused space.
-     * Faster than `push_back_string` and `shrink_to_fit` called separately.
+     * Elements are copied instead of moved if their move constructor may throw.
+     * If a copy constructor throws, every element created so far is destroyed, and `source` is left unchanged.
      * 
-     * The method is private to prevent the public method `push_back` from becoming too cluttered.
+     * Private helper method.
      * 
-     * @param new_values value to append to the array
+     * @param source elements to move
+     * @param n_elems number of elements to move
+     * @param destination uninitialized memory for the elements
      */
-    void _push_back_string_and_resize(const std::basic_string<T>& new_values) {
+    static void _relocate(T* source, int64_t n_elems, T* destination) {
+        _relocate(source, n_elems, destination, trivial_elements());
+    }
 
-        //Make new pointer for the new elements
-        T* new_contents = new T[size() + (int64_t)new_values.length()];
+    static void _relocate(T* source, int64_t n_elems, T* destination, std::true_type) noexcept {
+        _construct_copy(source, n_elems, destination, std::true_type());
+    }
 
-        //Copy current contents to new array
-        std::copy(contents, contents + size(), new_contents);
-        //Put the new values in
-        for(int64_t i = size(); i < size() + (int64_t)new_values.length(); i++) {
-            new_contents[i] = new_values[i - size()];
+    static void _relocate(T* source, int64_t n_elems, T* destination, std::false_type) {
+        int64_t i = 0;
+        try {
+            for(; i < n_elems; i++) {
+                new (destination + i) T(std::move_if_noexcept(source[i]));
+            }
         }
+        catch(...) {
+            _destroy(destination, i);
+            throw;
+        }
+        _destroy(source, n_elems);
+    }
+
 
-        //Switch pointers
-        delete[] contents;
-        contents = new_contents;
 
-        //Update remainder and elem. counts
-        n_segments = n_segments + ((n_remainder_elems + new_values.length()) / n_elems_per_segment);
-        n_remainder_elems = (n_remainder_elems + new_values.length()) % n_elems_per_segment;
-        //Update contents size
-        n_contents_elems = size();
+    /**
+     * Destroys `n_elems` elements starting at `first`. Does nothing for trivially copyable elements.
+     * 
+     * Private helper method.
+     * 
+     * @param first first element to destroy
+     * @param n_elems number of elements to destroy
+     */
+    static void _destroy(T* first, int64_t n_elems) noexcept {
+        _destroy(first, n_elems, trivial_elements());
+    }
+
+    static void _destroy(T* first, int64_t n_elems, std::true_type) noexcept {
+        (void)first;
+        (void)n_elems;
+    }
+
+    static void _destroy(T* first, int64_t n_elems, std::false_type) noexcept {
+        for(int64_t i = 0; i < n_elems; i++) {
+            first[i].~T();
+        }
     }
 
 
 
     /**
-     * Removes `n_elems_to_remove` elements from the final segments.
+     * Frees the memory holding `contents`, unmapping it if it is a mapped file. The elements must have already been destroyed.
      * 
-     * The removal process will convert the removed elements into unused space.
+     * Private helper method.
+     */
+    void _free_contents() noexcept {
+        if(mapping != nullptr) {
+            unmap_file(mapping, n_mapping_bytes);
+            mapping = nullptr;
+            n_mapping_bytes = 0;
+        }
+        else {
+            _deallocate(contents);
+        }
+    }
+
+
+
+    /**
+     * Moves the array's elements to new memory with room for `new_capacity` elements, then frees the old memory.
      * 
-     * The method is private to prevent the public method `pop_back` from being too cluttered.
+     * If an element cannot be moved, the array is left unchanged.
      * 
-     * @param n_elems_to_remove number of elements to remove. Cannot be negative, or greater than the total number of elements in the array.
+     * Private helper method.
+     * 
+     * @param new_capacity number of elements the new memory can hold. Must be at least the size of the array
      */
-    void _pop_back_n(int32_t n_elems_to_remove) {
-        //No need to enforce preconditions- the calling method does enforcing
+    void _reallocate(int64_t new_capacity) {
+        assert((new_capacity >= size() && "INTERNAL ERROR- New capacity cannot be less than the size of the array"));
 
-        //Update remainder elements
-        n_remainder_elems = (n_remainder_elems - n_elems_to_remove) % n_elems_per_segment;
-        if(n_remainder_elems < 0) {
-            n_remainder_elems += n_elems_per_segment;
-        } 
+        T* new_contents = _allocate(new_capacity);
+        try {
+            _relocate(contents, size(), new_contents);
+        }
+        catch(...) {
+            _deallocate(new_contents);
+            throw;
+        }
 
-        //Update segments
-        n_segments = n_segments - ((n_remainder_elems + n_elems_to_remove) / n_elems_per_segment);
+        _free_contents();
+        contents = new_contents;
+        n_contents_elems = new_capacity;
     }
-    
-    
+
+
 
     /**
-     * Removes `n_elems_to_remove` elements from the final segment(s), along with any unused space.
+     * Copies `n_new_elems` elements from `source` to the end of the array.
+     * If `new_capacity` differs from the current capacity, the existing elements are first moved to memory with room for `new_capacity` elements.
      * 
-     * The method is private to prevent the public method `pop_back` from being too cluttered.
+     * `source` may point to elements of this array. Does not update the segment and remainder counts.
      * 
-     * @param n_elems_to_remove number of elements to remove. Cannot be negative or greater than the total number of elements in the array.
+     * Private helper method.
+     * 
+     * @param source elements to append
+     * @param n_new_elems number of elements to append
+     * @param new_capacity capacity of the array after the operation. Must be at least the new size of the array
      */
-    void _pop_back_n_and_resize(int32_t n_elems_to_remove) {
-        //No need to enforce preconditions- the calling method does enforcing
-        
-        //Make new array
-        T* new_contents = new T[size() - n_elems_to_remove];
-        //Populate array with current contents
-        std::copy(contents, contents + size() - n_elems_to_remove, new_contents);
+    void _append(const T* source, int64_t n_new_elems, int64_t new_capacity) {
+        int64_t old_size = size();
 
-        //Switch pointers
-        delete[] contents;
-        contents = new_contents;
+        if(new_capacity != capacity()) {
+            //Find the source again after moving, if it is inside this array
+            std::less<const T*> before;
+            bool source_in_array = !before(source, contents) && before(source, contents + old_size);
+            int64_t source_offset = source_in_array ? source - contents : 0;
 
-        //Update contents size
-        n_contents_elems = size() - n_elems_to_remove;
+            _reallocate(new_capacity);
 
-        //Update remainder elements
-        n_remainder_elems = (n_remainder_elems - n_elems_to_remove) % n_elems_per_segment;
-        if(n_remainder_elems < 0) {
-            n_remainder_elems += n_elems_per_segment;
-        } 
+            if(source_in_array) {
+                source = contents + source_offset;
+            }
+        }
 
-        //Update segments
-        n_segments = n_segments - ((n_remainder_elems + n_elems_to_remove) / n_elems_per_segment);
+        _construct_copy(source, n_new_elems, contents + old_size);
     }
 
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////   
-//////////////////////////////////////////////////////////////////////////////////////////////////////
-//////////////////////////////////////////////////////////////////////////////////////////////////////   
-//////////////////////////////////////////////////////////////////////////////////////////////////////
-
-//////////////////////////////////////////////////////////////////////////////////////////////////////   
-//////////////////////////////////////////////////////////////////////////////////////////////////////
-//////////////////////////////////////////////////////////////////////////////////////////////////////   
-//////////////////////////////////////////////////////////////////////////////////////////////////////
-
-public:
 
     /**
-     * Creates a new Segmented Array with `segments` segments and `elements_per_segment` elements per segment, with an initial remainder size of `remainder_size`.
-     * All elements are uninitialized.
+     * Returns the position of the first of the `n_elems` elements starting at `first` that equals `value`.
      * 
-     * @param segments number of segments in the array. Must be non-negative
-     * @param elements_per_segment number of elements per segment in the array. Must be positive
-     * @param remainder_size number of elements in the remainder. Must be non-negative and less than `elements_per_segment`. Default: 0
+     * Private helper method.
+     * 
+     * @param first first element to search
+     * @param n_elems number of elements to search
+     * @param value element to search for
+     * @return position of the first match, or -1 if there is none
      */
-    segmented_array(int32_t segments, int32_t elements_per_segment, int32_t remainder_size = 0) {
-        using namespace std;
-        static_assert(is_same<T, char>::value || is_same<T, wchar_t>::value, "The array is for types `char` and `wchar_t` only");
-        assert((segments >= 0 && "Segments must be non-negative"));
-        assert((elements_per_segment > 0 && "Elems. per segment must be positive"));
-        assert((remainder_size >= 0 && "Remainder size cannot be negative"));
-        assert((remainder_size < elements_per_segment && "Remainder size must be less than the number of elements per segment"));
-        
-        //Allocate the contents, or not
-        if(segments == 0 && remainder_size == 0) {
-            contents = nullptr;
-        }
-        else {
-            contents = new T[segments * elements_per_segment + remainder_size];
+    static int64_t _find_in(const T* first, int64_t n_elems, const T& value, std::true_type) noexcept {
+        return simd::find<sizeof(T)>(first, n_elems, &value);
+    }
+
+    static int64_t _find_in(const T* first, int64_t n_elems, const T& value, std::false_type) {
+        for(int64_t i = 0; i < n_elems; i++) {
+            if(first[i] == value) {
+                return i;
+            }
         }
+        return -1;
+    }
 
-        //Set sizes
-        n_segments = segments;
-        n_elems_per_segment = elements_per_segment;
-        n_remainder_elems = remainder_size;
 
-        n_contents_elems = (int64_t)segments * (int64_t)elements_per_segment + (int64_t)remainder_size;
+
+    /**
+     * Returns the number of elements equal to `value` among the `n_elems` elements starting at `first`.
+     * 
+     * Private helper method.
+     * 
+     * @param first first element to search
+     * @param n_elems number of elements to search
+     * @param value element to count
+     * @return number of matches
+     */
+    static int64_t _count_in(const T* first, int64_t n_elems, const T& value, std::true_type) noexcept {
+        return simd::count<sizeof(T)>(first, n_elems, &value);
+    }
+
+    static int64_t _count_in(const T* first, int64_t n_elems, const T& value, std::false_type) {
+        int64_t total = 0;
+        for(int64_t i = 0; i < n_elems; i++) {
+            if(first[i] == value) {
+                total++;
+            }
+        }
+        return total;
     }
 
 
 
     /**
-     * Creates a new Segmented Array containing the elements of `initial_contents` split into pieces of size `elements_per_segment`.
-     * If `initial_contents.length()` is not evenly divisible by `elements_per_segment`, the resulting array will have a remainder.
+     * Returns whether the `n_elems` elements starting at `a` equal the `n_elems` elements starting at `b`.
      * 
-     * @param initial_contents contents to be placed in the new array
-     * @param elements_per_segment number of elements per segment in the array. Must be positive
+     * Private helper method.
+     * 
+     * @param a first elements to compare
+     * @param b second elements to compare
+     * @param n_elems number of elements to compare
+     * @return true if all corresponding elements are equal, false otherwise
      */
-    segmented_array(const std::basic_string<T>& initial_contents, int32_t elements_per_segment) {
-        using namespace std;
-        static_assert(is_same<T, char>::value || is_same<T, wchar_t>::value, "The array is for types `char` and `wchar_t` only");
-        assert(elements_per_segment > 0 && "Number of elements per segment must be positive");
-
-        //Allocate contents. If an error occurs, throw a runtime error
-        contents = new T[initial_contents.length()];
+    static bool _equal_range(const T* a, const T* b, int64_t n_elems, std::true_type) noexcept {
+        return simd::equal(a, b, n_elems * (int64_t)sizeof(T));
+    }
 
-        //Set contents to what is given
-        for(int64_t i = 0; i < (int64_t)initial_contents.length(); i++) {
-            contents[i] = initial_contents[i];
+    static bool _equal_range(const T* a, const T* b, int64_t n_elems, std::false_type) {
+        for(int64_t i = 0; i < n_elems; i++) {
+            if(!(a[i] == b[i])) {
+                return false;
+            }
         }
+        return true;
+    }
 
-        //Set quantities
-        n_segments = (int32_t)initial_contents.length() / elements_per_segment;
-        n_elems_per_segment = elements_per_segment;
-        n_remainder_elems = initial_contents.length() % elements_per_segment;
 
-        n_contents_elems = (int64_t)initial_contents.length();
+
+    /**
+     * Adds `n_new_elems` to the element count, creating new segments as the remainder fills.
+     * 
+     * Private helper method.
+     * 
+     * @param n_new_elems number of elements added to the end of the array
+     */
+    void _add_to_counts(int64_t n_new_elems) noexcept {
+        int64_t n_remainder_and_new = (int64_t)n_remainder_elems + n_new_elems;
+        n_segments = n_segments + _segment_of(n_remainder_and_new);
+        n_remainder_elems = _element_of(n_remainder_and_new);
     }
 
 
 
     /**
-     * Creates a deep copy of `copy_array`, including its unused space (although unused space in the copy is uninitialized).
+     * Writes the `n_elems` elements starting at `first` to `output_stream`.
+     * Elements of the stream's character type are written with a single `write`. Other elements are written one at a time with `<<`.
      * 
-     * @param copy_array Segmented Array to copy
+     * Private helper method.
+     * 
+     * @param output_stream output stream to write to
+     * @param first first element to write
+     * @param n_elems number of elements to write
      */
-    segmented_array(const segmented_array& copy_array) {
-        n_segments = copy_array.n_segments;
-        n_elems_per_segment = copy_array.n_elems_per_segment;
-        n_remainder_elems = copy_array.n_remainder_elems;
-        n_contents_elems = copy_array.n_contents_elems;
+    template<typename CharT, typename Traits>
+    static void _write_elements(std::basic_ostream<CharT, Traits>& output_stream, const T* first, int64_t n_elems) {
+        _write_elements(output_stream, first, n_elems, std::integral_constant<bool, std::is_same<T, CharT>::value>());
+    }
 
-        contents = new T[n_contents_elems];
-        std::copy(copy_array.contents, copy_array.contents + copy_array.size(), contents);
+    template<typename CharT, typename Traits>
+    static void _write_elements(std::basic_ostream<CharT, Traits>& output_stream, const T* first, int64_t n_elems, std::true_type) {
+        if(n_elems > 0) {
+            output_stream.write(first, (std::streamsize)n_elems);
+        }
     }
 
-    ///////////////////////////////////////////////////////
-    ///////////////////////////////////////////////////////
+    template<typename CharT, typename Traits>
+    static void _write_elements(std::basic_ostream<CharT, Traits>& output_stream, const T* first, int64_t n_elems, std::false_type) {
+        for(int64_t i = 0; i < n_elems; i++) {
+            output_stream << first[i];
+        }
+    }
+
+
+
+    /**
+     * Returns the binary header describing this array, for `save`.
+     * 
+     * Private helper method.
+     * 
+     * @return header with this array's sizes and the checksum of its elements
+     */
+    binary_header _make_header() const noexcept {
+        binary_header header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "SEGARRAY", 8);
+        header.version = 1;
+        header.byte_order = 0x01020304;
+        header.header_bytes = (uint32_t)sizeof(binary_header);
+        header.element_bytes = (uint32_t)sizeof(T);
+        header.elements_per_segment = n_elems_per_segment;
+        header.n_segments = n_segments;
+        header.n_remainder_elems = n_remainder_elems;
+        header.n_elements = size();
+        header.checksum = checksum64(contents, size() * (int64_t)sizeof(T));
+        return header;
+    }
+
+
+
+    /**
+     * Checks that `header` describes an array of `T` saved by `save` on a machine with the same byte order.
+     * 
+     * Private helper method.
+     * 
+     * @param header header to check
+     * @param n_file_bytes size of the whole saved array in bytes, counting the header, or -1 if unknown
+     * @throws `std::invalid_argument` if the header is not valid for this type, or if `n_file_bytes` bytes are too few to hold the header and elements
+     */
+    static void _check_header(const binary_header& header, int64_t n_file_bytes) {
+        if(std::memcmp(header.magic, "SEGARRAY", 8) != 0) {
+            throw std::invalid_argument("The data is not a saved segmented array");
+        }
+        if(header.version != 1) {
+            throw std::invalid_argument("The saved segmented array has an unknown version");
+        }
+        if(header.byte_order != 0x01020304) {
+            throw std::invalid_argument("The segmented array was saved on a machine with a different byte order");
+        }
+        if(header.element_bytes != sizeof(T)) {
+            throw std::invalid_argument("The saved elements are not the size of this array's element type");
+        }
+        if(header.header_bytes < sizeof(binary_header) || header.header_bytes % alignof(T) != 0) {
+            throw std::invalid_argument("The saved segmented array has an invalid header size");
+        }
+
+        //The sizes must agree with each other. Counts too large to multiply without overflowing are rejected first
+        if(header.elements_per_segment <= 0 || header.n_segments < 0 || header.n_remainder_elems < 0
+            || header.n_remainder_elems >= header.elements_per_segment
+            || header.n_segments > (INT64_MAX - header.n_remainder_elems) / header.elements_per_segment
+            || header.n_elements != header.n_segments * header.elements_per_segment + header.n_remainder_elems
+            || header.n_elements > INT64_MAX / (int64_t)sizeof(T)) {
+            throw std::invalid_argument("The saved segmented array has inconsistent sizes");
+        }
+        if(fixed_length && header.elements_per_segment != SegmentLength) {
+            throw std::invalid_argument("The saved segment length differs from this array's fixed segment length");
+        }
+        if(n_file_bytes != -1 && (n_file_bytes < (int64_t)header.header_bytes
+            || n_file_bytes - (int64_t)header.header_bytes < header.n_elements * (int64_t)sizeof(T))) {
+            throw std::invalid_argument("The saved segmented array is truncated");
+        }
+    }
+
+
+
+    /**
+     * Returns the number of bytes between the current position of `input` and its end, leaving the position unchanged.
+     * 
+     * Private helper method.
+     * 
+     * @param input stream to measure
+     * @return number of bytes left, or -1 if `input` cannot seek
+     */
+    static int64_t _stream_bytes_left(std::istream& input) {
+        std::istream::pos_type start = input.tellg();
+        if(start == std::istream::pos_type(-1)) {
+            return -1;
+        }
+        input.seekg(0, std::ios::end);
+        std::istream::pos_type end = input.tellg();
+        input.clear();
+        input.seekg(start);
+        if(end == std::istream::pos_type(-1)) {
+            return -1;
+        }
+        return (int64_t)(end - start);
+    }
+
+
+
+    /**
+     * Calls `segment_task(i)` for every segment number `i`, counting a non-empty remainder as the final segment.
+     * Neighbouring segments are grouped, and the groups run in parallel on `pool` if it is given. Otherwise, every segment runs on the calling thread, in order.
+     * 
+     * Private helper method.
+     * 
+     * @param segment_task function to call with each segment number
+     * @param pool threads to run the groups on, or `nullptr` to run serially
+     */
+    template<typename SegmentTask>
+    void _run_on_segments(SegmentTask segment_task, thread_pool* pool) const {
+        int64_t n_views = (int64_t)n_segments + (n_remainder_elems > 0 ? 1 : 0);
+        if(pool == nullptr || pool->size() == 1 || n_views <= 1) {
+            for(int64_t i = 0; i < n_views; i++) {
+                segment_task(i);
+            }
+            return;
+        }
+
+        //Several groups per thread even out segments that take longer, while keeping the cost of claiming groups small
+        int64_t n_groups = std::min(n_views, (int64_t)pool->size() * 8);
+        pool->run(n_groups, [n_views, n_groups, &segment_task](int64_t group) {
+            int64_t last = n_views * (group + 1) / n_groups;
+            for(int64_t i = n_views * group / n_groups; i < last; i++) {
+                segment_task(i);
+            }
+        });
+    }
+
+
+
+    /**
+     * Returns the capacity the array needs before `n_new_elems` elements are appended.
+     * This is the current capacity if the new elements fit, or the capacity chosen by `GrowthPolicy` if they do not.
+     * 
+     * Private helper method.
+     * 
+     * @param n_new_elems number of elements to append
+     * @return capacity to append with
+     */
+    int64_t _capacity_for(int64_t n_new_elems) const noexcept {
+        if(size() + n_new_elems <= capacity()) {
+            return capacity();
+        }
+        return GrowthPolicy::new_capacity(size(), size() + n_new_elems, capacity(), n_elems_per_segment);
+    }
+
+
+
+    /**
+     * Appends the elements from `first` to `last`. Pointers to the element type are copied all at once by `append`.
+     * 
+     * Private helper method.
+     * 
+     * @param first iterator to the first element to append
+     * @param last iterator one past the final element to append
+     */
+    template<typename Iterator>
+    void _append_range(Iterator first, Iterator last, std::true_type) {
+        append(first, (int64_t)(last - first));
+    }
+
+    template<typename Iterator>
+    void _append_range(Iterator first, Iterator last, std::false_type) {
+        _append_range(first, last, typename std::iterator_traits<Iterator>::iterator_category());
+    }
+
+    /**
+     * Appends the elements from `first` to `last` one at a time, since the number of elements is not known in advance.
+     * 
+     * Private helper method.
+     */
+    template<typename Iterator>
+    void _append_range(Iterator first, Iterator last, std::input_iterator_tag) {
+        for(; first != last; ++first) {
+            push_back(T(*first));
+        }
+    }
+
+    /**
+     * Makes room for every element from `first` to `last`, then constructs them directly in the unused space.
+     * If an element cannot be constructed, the elements constructed so far are destroyed and the size is unchanged.
+     * 
+     * Private helper method.
+     */
+    template<typename Iterator>
+    void _append_range(Iterator first, Iterator last, std::forward_iterator_tag) {
+        int64_t n_new_elems = (int64_t)std::distance(first, last);
+        if(n_new_elems == 0) {
+            return;
+        }
+
+        int64_t new_capacity = _capacity_for(n_new_elems);
+        if(new_capacity != capacity()) {
+            _reallocate(new_capacity);
+        }
+
+        T* destination = contents + size();
+        int64_t n_constructed = 0;
+        try {
+            for(; first != last; ++first, n_constructed++) {
+                ::new (static_cast<void*>(destination + n_constructed)) T(*first);
+            }
+        }
+        catch(...) {
+            _destroy(destination, n_constructed);
+            throw;
+        }
+        _add_to_counts(n_new_elems);
+    }
+
+
+
+    /**
+     * Appends `new_value` to the remainder. If the remainder is filled, a new segment is created and `new_value` becomes the first value in the segment.
+     * 
+     * If the array is too small to hold the new elements, the array increases its size to hold the new elements,
+     * plus unused elements chosen by `GrowthPolicy`.
+     * 
+     * The method is private to prevent the public method `push_back` from becoming too cluttered.
+     * 
+     * @param new_value value to append to the array
+     */
+    void _push_back_char(const T& new_value) {
+
+        //Idiot check
+        assert(size() <= capacity() && "INTERNAL ERROR- Total element count cannot exceed total size");
+
+        //If there is not enough room, extend the array, then add the new element
+        _append(&new_value, 1, _capacity_for(1));
+        _add_to_counts(1);
+    }
+
+
+
+    /**
+     * Adds `new_value` to the end of the final segment, then removes any unused space. 
+     * Faster than `push_back_string` and `shrink_to_fit` called separately.
+     * 
+     * The method is private to prevent the public method `push_back` from becoming too cluttered.
+     * 
+     * @param new_value new elements to add to the last segment
+     */
+    void _push_back_char_and_resize(const T& new_value) {
+        _append(&new_value, 1, size() + 1);
+        _add_to_counts(1);
+    }
+
+
+
+    /**
+     * Adds the elements of `new_values` to the end of the array.
+     * Creates enough new segments and elements to hold the new values.
+     * 
+     * If the array is too small to hold the new elements, the array increases its size to hold the new elements,
+     * plus unused elements chosen by `GrowthPolicy`.
+     * 
+     * The method is private to prevent the public method `push_back` from becoming too cluttered.
+     * 
+     * @param new_values new elements to add to the last segment(s)
+     */
+    void _push_back_string(const std::basic_string<T>& new_values) {
+        append(new_values.data(), (int64_t)new_values.length());
+    }
+
+
+
+    /**
+     * Adds the elements of `new_values` to the end of the array.
+     * Creates enough new segments and elements to hold the new values.
+     * 
+     * This function also removes unused space.
+     * Faster than `push_back_string` and `shrink_to_fit` called separately.
+     * 
+     * The method is private to prevent the public method `push_back` from becoming too cluttered.
+     * 
+     * @param new_values value to append to the array
+     */
+    void _push_back_string_and_resize(const std::basic_string<T>& new_values) {
+        int64_t n_new_elems = (int64_t)new_values.length();
+
+        _append(new_values.data(), n_new_elems, size() + n_new_elems);
+        _add_to_counts(n_new_elems);
+    }
+
+
+
+    /**
+     * Removes `n_elems_to_remove` elements from the final segments.
+     * 
+     * The removal process will convert the removed elements into unused space.
+     * 
+     * The method is private to prevent the public method `pop_back` from being too cluttered.
+     * 
+     * @param n_elems_to_remove number of elements to remove. Cannot be negative, or greater than the total number of elements in the array.
+     */
+    void _pop_back_n(int64_t n_elems_to_remove) {
+        //No need to enforce preconditions- the calling method does enforcing
+        _destroy(contents + size() - n_elems_to_remove, n_elems_to_remove);
+
+        //Recount segments and remainder elements from the new size
+        int64_t new_size = size() - n_elems_to_remove;
+        n_segments = _segment_of(new_size);
+        n_remainder_elems = _element_of(new_size);
+    }
+    
+    
+
+    /**
+     * Removes `n_elems_to_remove` elements from the final segment(s), along with any unused space.
+     * 
+     * The method is private to prevent the public method `pop_back` from being too cluttered.
+     * 
+     * @param n_elems_to_remove number of elements to remove. Cannot be negative or greater than the total number of elements in the array.
+     */
+    void _pop_back_n_and_resize(int64_t n_elems_to_remove) {
+        //No need to enforce preconditions- the calling method does enforcing
+        _pop_back_n(n_elems_to_remove);
+        _reallocate(size());
+    }
+
+
+
+    /**
+     * Inserts `n_new_elems` elements from `source` before flat position `position`, shifting the elements after it towards the end.
+     * 
+     * Trivially copyable elements are shifted with a single `memmove` if they fit in the current capacity.
+     * Otherwise, they are copied once, around the new elements, into memory chosen by `GrowthPolicy`.
+     * `source` must not point to elements of this array.
+     * 
+     * Private helper method.
+     * 
+     * @param position flat position to insert before. Must be between 0 and the size of the array
+     * @param source elements to insert
+     * @param n_new_elems number of elements to insert. Must be positive
+     */
+    void _insert(int64_t position, const T* source, int64_t n_new_elems, std::true_type) {
+        int64_t old_size = size();
+        int64_t new_capacity = _capacity_for(n_new_elems);
+
+        if(new_capacity == capacity()) {
+            std::memmove(contents + position + n_new_elems, contents + position, (size_t)(old_size - position) * sizeof(T));
+            std::memcpy(contents + position, source, (size_t)n_new_elems * sizeof(T));
+        }
+        else {
+            T* new_contents = _allocate(new_capacity);
+            _construct_copy(contents, position, new_contents);
+            _construct_copy(source, n_new_elems, new_contents + position);
+            _construct_copy(contents + position, old_size - position, new_contents + position + n_new_elems);
+
+            _free_contents();
+            contents = new_contents;
+            n_contents_elems = new_capacity;
+        }
+        _add_to_counts(n_new_elems);
+    }
+
+    /**
+     * Inserts `n_new_elems` elements from `source` before flat position `position` by appending them, then rotating them into place.
+     * 
+     * Used for elements that are not trivially copyable, and when `source` points to elements of this array.
+     * 
+     * Private helper method.
+     */
+    void _insert(int64_t position, const T* source, int64_t n_new_elems, std::false_type) {
+        int64_t old_size = size();
+        append(source, n_new_elems);
+        std::rotate(contents + position, contents + old_size, contents + size());
+    }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////   
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////////   
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////   
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////////   
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+
+public:
+
+    /**
+     * Creates a new Segmented Array with `segments` segments and `elements_per_segment` elements per segment, with an initial remainder size of `remainder_size`.
+     * Trivially copyable elements are uninitialized. Other elements are default-constructed.
+     * 
+     * @param segments number of segments in the array. Must be non-negative
+     * @param elements_per_segment number of elements per segment in the array. Must be positive, and equal to `SegmentLength` if it is fixed
+     * @throws `std::invalid_argument` if `SegmentLength` is fixed and differs from `elements_per_segment`
+     * @param remainder_size number of elements in the remainder. Must be non-negative and less than `elements_per_segment`. Default: 0
+     */
+    segmented_array(int64_t segments, int32_t elements_per_segment, int32_t remainder_size = 0) {
+        assert((segments >= 0 && "Segments must be non-negative"));
+        assert((elements_per_segment > 0 && "Elems. per segment must be positive"));
+        _check_segment_length(elements_per_segment);
+        assert((remainder_size >= 0 && "Remainder size cannot be negative"));
+        assert((remainder_size < elements_per_segment && "Remainder size must be less than the number of elements per segment"));
+        
+        n_contents_elems = (int64_t)segments * (int64_t)elements_per_segment + (int64_t)remainder_size;
+        mapping = nullptr;
+        n_mapping_bytes = 0;
+
+        //Allocate the contents, or not
+        contents = _allocate(n_contents_elems);
+        try {
+            _construct_default(contents, n_contents_elems);
+        }
+        catch(...) {
+            _deallocate(contents);
+            throw;
+        }
+
+        //Set sizes
+        n_segments = segments;
+        n_elems_per_segment = elements_per_segment;
+        n_remainder_elems = remainder_size;
+    }
+
+
+
+    /**
+     * Creates a new Segmented Array containing the elements of `initial_contents` split into pieces of size `elements_per_segment`.
+     * If `initial_contents.length()` is not evenly divisible by `elements_per_segment`, the resulting array will have a remainder.
+     * 
+     * @param initial_contents contents to be placed in the new array
+     * @param elements_per_segment number of elements per segment in the array. Must be positive, and equal to `SegmentLength` if it is fixed
+     * @throws `std::invalid_argument` if `SegmentLength` is fixed and differs from `elements_per_segment`
+     */
+    segmented_array(const std::basic_string<T>& initial_contents, int32_t elements_per_segment) {
+        assert(elements_per_segment > 0 && "Number of elements per segment must be positive");
+        _check_segment_length(elements_per_segment);
+
+        //Allocate contents and set them to what is given. If an error occurs, throw a runtime error
+        contents = _allocate((int64_t)initial_contents.length());
+        _construct_copy(initial_contents.data(), (int64_t)initial_contents.length(), contents);
+
+        //Set quantities
+        n_segments = (int64_t)initial_contents.length() / elements_per_segment;
+        n_elems_per_segment = elements_per_segment;
+        n_remainder_elems = initial_contents.length() % elements_per_segment;
+
+        n_contents_elems = (int64_t)initial_contents.length();
+        mapping = nullptr;
+        n_mapping_bytes = 0;
+    }
+
+
+
+    /**
+     * Creates a new Segmented Array whose contents are the file at `file_path`, split into pieces of size `elements_per_segment`.
+     * The file is mapped into memory instead of being read, so pages of the file are only read when they are first accessed.
+     * 
+     * Anything that moves the contents (such as appending past the capacity, which is exactly the file's size) copies them into normal memory and unmaps the file.
+     * Only trivially copyable types can be stored in a mapped file.
+     * 
+     * A mapped file never changes size. With `map_mode::READ_WRITE`, only in-place changes to existing elements (such as `set` or writing through `at`) reach the file.
+     * `erase`, `pop_back`, and `insert` shift the elements inside the mapping but leave the file at its old length, so the file keeps stale elements at its end.
+     * Appends past the capacity unmap the file, and later changes stay in memory.
+     * 
+     * @param file_path path of the file to map. Its size must be a multiple of the size of `T`
+     * @param elements_per_segment number of elements per segment in the array. Must be positive, and equal to `SegmentLength` if it is fixed
+     * @throws `std::invalid_argument` if `SegmentLength` is fixed and differs from `elements_per_segment`
+     * @param mode `map_mode::READ_ONLY` if the array will not be changed, `map_mode::COPY_ON_WRITE` to change only this process's copy,
+     * or `map_mode::READ_WRITE` to write in-place changes back to the file
+     * @throws `std::system_error` if the file cannot be opened or mapped
+     * @throws `std::invalid_argument` if the file's size is not a multiple of the size of `T`
+     */
+    segmented_array(const std::string& file_path, int32_t elements_per_segment, map_mode mode) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be stored in a mapped file");
+        assert(elements_per_segment > 0 && "Number of elements per segment must be positive");
+        _check_segment_length(elements_per_segment);
+
+        mapping = map_file(file_path, mode, n_mapping_bytes);
+        if(n_mapping_bytes % (int64_t)sizeof(T) != 0) {
+            unmap_file(mapping, n_mapping_bytes);
+            throw std::invalid_argument("The size of " + file_path + " is not a multiple of the element size");
+        }
+        contents = static_cast<T*>(mapping);
+
+        //Set quantities
+        n_contents_elems = n_mapping_bytes / (int64_t)sizeof(T);
+        n_elems_per_segment = elements_per_segment;
+        n_segments = n_contents_elems / elements_per_segment;
+        n_remainder_elems = (int32_t)(n_contents_elems % elements_per_segment);
+    }
+
+
+
+    /**
+     * Creates a new fixed-length Segmented Array containing the elements of `initial_contents` split into pieces of `SegmentLength` elements.
+     * Only available when the segment length is fixed.
+     * 
+     * @param initial_contents contents to be placed in the new array
+     */
+    template<int32_t Length = SegmentLength, typename = typename std::enable_if<(Length > 0)>::type>
+    explicit segmented_array(const std::basic_string<T>& initial_contents)
+        : segmented_array(initial_contents, SegmentLength) {}
+
+    /**
+     * Creates a new fixed-length Segmented Array whose contents are the mapped file at `file_path`, split into pieces of `SegmentLength` elements.
+     * Only available when the segment length is fixed.
+     * 
+     * @param file_path path of the file to map. Its size must be a multiple of the size of `T`
+     * @param mode how the file is mapped, as in the constructor that takes a segment length
+     * @throws `std::system_error` if the file cannot be opened or mapped
+     * @throws `std::invalid_argument` if the file's size is not a multiple of the size of `T`
+     */
+    template<int32_t Length = SegmentLength, typename = typename std::enable_if<(Length > 0)>::type>
+    segmented_array(const std::string& file_path, map_mode mode)
+        : segmented_array(file_path, SegmentLength, mode) {}
+
+
+
+    /**
+     * Creates a deep copy of `copy_array`. Only the elements are copied, so the copy has no unused space.
+     * 
+     * @param copy_array Segmented Array to copy
+     */
+    segmented_array(const segmented_array& copy_array) {
+        n_segments = copy_array.n_segments;
+        n_elems_per_segment = copy_array.n_elems_per_segment;
+        n_remainder_elems = copy_array.n_remainder_elems;
+        n_contents_elems = copy_array.size();
+        mapping = nullptr;
+        n_mapping_bytes = 0;
+
+        contents = _allocate(n_contents_elems);
+        try {
+            _construct_copy(copy_array.contents, copy_array.size(), contents);
+        }
+        catch(...) {
+            _deallocate(contents);
+            throw;
+        }
+    }
+
+
+
+    /**
+     * Moves the contents of `move_array` into a new array without copying any elements, including a mapped file.
+     * `move_array` is left empty, with the same number of elements per segment.
+     * 
+     * @param move_array Segmented Array to move
+     */
+    segmented_array(segmented_array&& move_array) noexcept {
+        n_segments = move_array.n_segments;
+        n_elems_per_segment = move_array.n_elems_per_segment;
+        n_remainder_elems = move_array.n_remainder_elems;
+        contents = move_array.contents;
+        n_contents_elems = move_array.n_contents_elems;
+        mapping = move_array.mapping;
+        n_mapping_bytes = move_array.n_mapping_bytes;
+
+        move_array.n_segments = 0;
+        move_array.n_remainder_elems = 0;
+        move_array.contents = nullptr;
+        move_array.n_contents_elems = 0;
+        move_array.mapping = nullptr;
+        move_array.n_mapping_bytes = 0;
+    }
+
+    /**
+     * Loads an array written by `save` from `input`.
+     * The array has the same segment length, segments, and remainder as the saved array, and no unused space.
+     * Only available for trivially copyable types. Open `input` in binary mode.
+     * 
+     * If `input` can seek (such as a file or string stream), its size is checked against the header first, then all elements are read with a single call.
+     * Otherwise, elements are read in blocks that start at 1 MiB and double, so a damaged header cannot make the array allocate more than twice the data that arrives.
+     * 
+     * @param input stream positioned at the start of a saved array
+     * @return the loaded array
+     * @throws `std::invalid_argument` if the data is not a saved array of this type, is truncated, or fails its checksum
+     */
+    static segmented_array load(std::istream& input) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be loaded as raw bytes");
+
+        int64_t n_stream_bytes = _stream_bytes_left(input);
+        binary_header header;
+        input.read(reinterpret_cast<char*>(&header), (std::streamsize)sizeof(header));
+        if(input.gcount() != (std::streamsize)sizeof(header)) {
+            throw std::invalid_argument("The data is too short to be a saved segmented array");
+        }
+        _check_header(header, n_stream_bytes);
+        input.ignore((std::streamsize)(header.header_bytes - sizeof(header)));
+
+        //Read everything at once if the size was checked, or else in doubling blocks
+        segmented_array loaded = segmented_array(0, header.elements_per_segment);
+        int64_t n_first_block = (n_stream_bytes == -1) ? std::max((int64_t)1, (int64_t)(1 << 20) / (int64_t)sizeof(T)) : header.n_elements;
+        while(loaded.size() < header.n_elements) {
+            int64_t n_block = std::min(header.n_elements - loaded.size(), std::max(n_first_block, loaded.size()));
+            loaded.reserve(loaded.size() + n_block);
+
+            int64_t n_block_bytes = n_block * (int64_t)sizeof(T);
+            input.read(reinterpret_cast<char*>(loaded.contents + loaded.size()), (std::streamsize)n_block_bytes);
+            if(input.gcount() != (std::streamsize)n_block_bytes) {
+                throw std::invalid_argument("The saved segmented array is truncated");
+            }
+            loaded._add_to_counts(n_block);
+        }
+        if(checksum64(loaded.contents, header.n_elements * (int64_t)sizeof(T)) != header.checksum) {
+            throw std::invalid_argument("The saved segmented array failed its checksum");
+        }
+        return loaded;
+    }
+
+    /**
+     * Loads an array written by `save` from the file at `file_path`, checking the file's size against the header, then reading all elements with a single call.
+     * Only available for trivially copyable types.
+     * 
+     * @param file_path path of the saved array
+     * @return the loaded array
+     * @throws `std::runtime_error` if the file cannot be opened
+     * @throws `std::invalid_argument` if the file is not a saved array of this type, is truncated, or fails its checksum
+     */
+    static segmented_array load(const std::string& file_path) {
+        std::ifstream file(file_path, std::ios::binary);
+        if(!file) {
+            throw std::runtime_error("Cannot open " + file_path);
+        }
+        return load(file);
+    }
+
+    /**
+     * Loads an array written by `save` by mapping the file at `file_path` into memory, like the memory-mapped constructor.
+     * The elements are not copied: pages are read from the file the first time they are accessed.
+     * The file is mapped with `map_mode::COPY_ON_WRITE`, so the array can be changed without changing the file.
+     * Only available for trivially copyable types.
+     * 
+     * @param file_path path of the saved array
+     * @param verify_checksum whether to check the elements against the saved checksum. This reads the whole file. Default: true
+     * @return the loaded array
+     * @throws `std::system_error` if the file cannot be opened or mapped
+     * @throws `std::invalid_argument` if the file is not a saved array of this type, is truncated, or fails its checksum
+     */
+    static segmented_array load_mapped(const std::string& file_path, bool verify_checksum = true) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be stored in a mapped file");
+
+        int64_t n_file_bytes = 0;
+        void* file_mapping = map_file(file_path, map_mode::COPY_ON_WRITE, n_file_bytes);
+        binary_header header;
+        try {
+            if(n_file_bytes < (int64_t)sizeof(header)) {
+                throw std::invalid_argument("The file is too short to be a saved segmented array");
+            }
+            std::memcpy(&header, file_mapping, sizeof(header));
+            _check_header(header, n_file_bytes);
+
+            const char* first_byte = static_cast<const char*>(file_mapping) + header.header_bytes;
+            if(verify_checksum && checksum64(first_byte, header.n_elements * (int64_t)sizeof(T)) != header.checksum) {
+                throw std::invalid_argument("The saved segmented array failed its checksum");
+            }
+        }
+        catch(...) {
+            unmap_file(file_mapping, n_file_bytes);
+            throw;
+        }
+
+        segmented_array loaded = segmented_array(0, header.elements_per_segment);
+        loaded.mapping = file_mapping;
+        loaded.n_mapping_bytes = n_file_bytes;
+        loaded.contents = reinterpret_cast<T*>(static_cast<char*>(file_mapping) + header.header_bytes);
+        loaded.n_contents_elems = header.n_elements;
+        loaded.n_segments = header.n_segments;
+        loaded.n_remainder_elems = header.n_remainder_elems;
+        return loaded;
+    }
+
+    ///////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////
     //GETTERS
 
-    
+    
+    /**
+     * @return number of elements used by the array, including unused space
+     */
+    int64_t capacity() const noexcept {
+        return n_contents_elems;
+    }
+
+
+
+    /**
+     * @return true if the contents are still in a memory-mapped file, false otherwise
+     */
+    bool is_mapped() const noexcept {
+        return mapping != nullptr;
+    }
+
+
+
+    /**
+     * @return number of full-length segments in the array
+     * 
+     * The remainder does not count as a full-length segment.
+     */
+    int64_t filled_segment_count() const noexcept {
+        return n_segments;
+    }
+
+
+
+    /**
+     * @return length of each full-sized segment in the array
+     */
+    int32_t filled_segment_length() const noexcept {
+        return _segment_length();
+    }
+
+
+
+    /**
+     * @return number of elements in the remainder. Returns 0 if no remainder exists.
+     */
+    int32_t remainder_length() const noexcept {
+        return n_remainder_elems;
+    }
+
+
+
+    /**
+     * @return number of elements in the array (excluding unused space)
+     * 
+     * Total elements = number of segments * number of elements per segment + number of remainder elements
+     */
+    int64_t size() const noexcept {
+        return _flat_index(n_segments, n_remainder_elems);
+    }
+
+
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number` in the array as a character value.
+     * 
+     * Segment and element indexing starts at 0. The first element of the first segment is at `{arrayName}.value_at(0,0)`.
+     * 
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     * 
+     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
+     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
+     * @return character value at segment `segment_number` and position `element_number`
+     */
+    const T& char_at(int64_t segment_number, int32_t element_number) const noexcept {
+        _assert_valid_index(segment_number, element_number);
+        return contents[_flat_index(segment_number, element_number)];
+    }
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number` in the array as a character value.
+     * 
+     * Segment and element indexing starts at 0. The first element of the first segment is at `{arrayName}.value_at(0,0)`.
+     * 
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     * 
+     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
+     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
+     * @return character value at segment `segment_number` and position `element_number`
+     */
+    T& char_at(int64_t segment_number, int32_t element_number) noexcept {
+        _assert_valid_index(segment_number, element_number);
+        return contents[_flat_index(segment_number, element_number)];
+    }
+
+
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number` in the array as an integer value.
+     * 
+     * Segment and element indexing starts at 0. The first element of the first segment is at `{arrayName}.value_at(0,0)`.
+     * 
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     * 
+     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
+     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
+     * @return value at segment `segment_number` and position `element_number`, as an integer
+     */
+    int32_t int_value_at(int64_t segment_number, int32_t element_number) const noexcept {
+        _assert_valid_index(segment_number, element_number);
+        return (int32_t)contents[_flat_index(segment_number, element_number)];
+    }
+
+
+
+    /**
+     * Returns the element at flat position `flat_index`, after checking that the position is in the array.
+     * The flat position of the element at segment `s` and position `e` is `s * {arrayName}.filled_segment_length() + e`.
+     * 
+     * @param flat_index position of the element, counting from the first element of segment 0
+     * @return reference to the element
+     * @throws `std::out_of_range` if `flat_index` is negative or not less than `size()`
+     */
+    T& at(int64_t flat_index) {
+        if(flat_index < 0 || flat_index >= size()) {
+            throw std::out_of_range("Flat index " + std::to_string(flat_index) + " is outside an array of size " + std::to_string(size()));
+        }
+        return contents[flat_index];
+    }
+
+    /**
+     * Returns the element at flat position `flat_index`, after checking that the position is in the array.
+     * 
+     * @param flat_index position of the element, counting from the first element of segment 0
+     * @return reference to the element
+     * @throws `std::out_of_range` if `flat_index` is negative or not less than `size()`
+     */
+    const T& at(int64_t flat_index) const {
+        if(flat_index < 0 || flat_index >= size()) {
+            throw std::out_of_range("Flat index " + std::to_string(flat_index) + " is outside an array of size " + std::to_string(size()));
+        }
+        return contents[flat_index];
+    }
+
+
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number`, after checking that it exists.
+     * The check runs whether or not `NDEBUG` is defined, so it is suited to indices from outside the program.
+     * 
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     * 
+     * @param segment_number segment to access (0-based indexing)
+     * @param element_number element to access in segment `segment_number` (0-based indexing)
+     * @return reference to the element
+     * @throws `std::out_of_range` if the element does not exist
+     */
+    T& checked_at(int64_t segment_number, int32_t element_number) {
+        _check_index(segment_number, element_number);
+        return contents[_flat_index(segment_number, element_number)];
+    }
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number`, after checking that it exists.
+     * The check runs whether or not `NDEBUG` is defined.
+     * 
+     * @param segment_number segment to access (0-based indexing)
+     * @param element_number element to access in segment `segment_number` (0-based indexing)
+     * @return reference to the element
+     * @throws `std::out_of_range` if the element does not exist
+     */
+    const T& checked_at(int64_t segment_number, int32_t element_number) const {
+        _check_index(segment_number, element_number);
+        return contents[_flat_index(segment_number, element_number)];
+    }
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number` without any checks, even when assertions are enabled.
+     * For hot loops whose indices are already known to be valid.
+     * 
+     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
+     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
+     * @return reference to the element
+     */
+    T& unchecked_at(int64_t segment_number, int32_t element_number) noexcept {
+        return contents[_flat_index(segment_number, element_number)];
+    }
+
+    /**
+     * Returns the element at segment `segment_number` and position `element_number` without any checks, even when assertions are enabled.
+     * 
+     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
+     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
+     * @return reference to the element
+     */
+    const T& unchecked_at(int64_t segment_number, int32_t element_number) const noexcept {
+        return contents[_flat_index(segment_number, element_number)];
+    }
+
+    /**
+     * Returns the element at flat position `flat_index` without any checks, even when assertions are enabled.
+     * 
+     * @param flat_index position of the element, counting from the first element of segment 0. Must be non-negative and less than `size()`
+     * @return reference to the element
+     */
+    T& unchecked_at(int64_t flat_index) noexcept {
+        return contents[flat_index];
+    }
+
+    /**
+     * Returns the element at flat position `flat_index` without any checks, even when assertions are enabled.
+     * 
+     * @param flat_index position of the element, counting from the first element of segment 0. Must be non-negative and less than `size()`
+     * @return reference to the element
+     */
+    const T& unchecked_at(int64_t flat_index) const noexcept {
+        return contents[flat_index];
+    }
+
+
+
+    /**
+     * Returns the flat position of the element at segment `segment_number` and position `element_number`.
+     * 
+     * @param segment_number segment number. Must be non-negative
+     * @param element_number position in the segment. Must be non-negative and less than `filled_segment_length()`
+     * @return `segment_number * filled_segment_length() + element_number`
+     */
+    int64_t to_flat(int64_t segment_number, int32_t element_number) const noexcept {
+        return _flat_index(segment_number, element_number);
+    }
+
+    /**
+     * Converts `n_indices` pairs of segment and element numbers to flat positions.
+     * 
+     * @param segment_numbers segment numbers to convert. Each must be non-negative
+     * @param element_numbers element numbers to convert. Each must be non-negative and less than `filled_segment_length()`
+     * @param n_indices number of pairs to convert. Must be non-negative
+     * @param flat_indices set to the flat positions. Must have room for `n_indices` positions
+     */
+    void to_flat(const int64_t* segment_numbers, const int32_t* element_numbers, int64_t n_indices, int64_t* flat_indices) const noexcept {
+        for(int64_t i = 0; i < n_indices; i++) {
+            flat_indices[i] = _flat_index(segment_numbers[i], element_numbers[i]);
+        }
+    }
+
+    /**
+     * Returns the segment and element numbers of the element at flat position `flat_index`.
+     * 
+     * @param flat_index flat position. Must be non-negative
+     * @return segment number, then position in the segment
+     */
+    std::pair<int64_t, int32_t> to_coords(int64_t flat_index) const noexcept {
+        return std::pair<int64_t, int32_t>(_segment_of(flat_index), _element_of(flat_index));
+    }
+
+    /**
+     * Converts `n_indices` flat positions to segment and element numbers.
+     * The loop has no branches, so the compiler can vectorize it, and a fixed power-of-two segment length makes it shifts and masks.
+     * 
+     * @param flat_indices flat positions to convert. Each must be non-negative
+     * @param n_indices number of positions to convert. Must be non-negative
+     * @param segment_numbers set to the segment numbers. Must have room for `n_indices` numbers
+     * @param element_numbers set to the element numbers. Must have room for `n_indices` numbers
+     */
+    void to_coords(const int64_t* flat_indices, int64_t n_indices, int64_t* segment_numbers, int32_t* element_numbers) const noexcept {
+        for(int64_t i = 0; i < n_indices; i++) {
+            segment_numbers[i] = _segment_of(flat_indices[i]);
+            element_numbers[i] = _element_of(flat_indices[i]);
+        }
+    }
+    
+    
+
+    /**
+     * Returns a pointer to the array's elements. Segment `s` starts at `{arrayName}.data() + s * {arrayName}.filled_segment_length()`.
+     * 
+     * The pointer is invalidated by any operation that moves the contents, such as appending past the capacity or `shrink_to_fit`.
+     * 
+     * @return pointer to the first element, or `nullptr` if the array has no memory allocated
+     */
+    T* data() noexcept {
+        return contents;
+    }
+
+    /**
+     * Returns a pointer to the array's elements. Segment `s` starts at `{arrayName}.data() + s * {arrayName}.filled_segment_length()`.
+     * 
+     * The pointer is invalidated by any operation that moves the contents, such as appending past the capacity or `shrink_to_fit`.
+     * 
+     * @return pointer to the first element, or `nullptr` if the array has no memory allocated
+     */
+    const T* data() const noexcept {
+        return contents;
+    }
+
+
+
+    /**
+     * Returns a view of segment `segment_number`, without copying it.
+     * 
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     * 
+     * @param segment_number segment to view. Must be a valid segment number in the array, or `{arrayName}.filled_segment_count()`
+     * @return view of the segment
+     */
+    segment_view<T> segment(int64_t segment_number) noexcept {
+        assert((segment_number >= 0 && segment_number <= filled_segment_count() && "Segment number must be a valid segment or the remainder"));
+        int32_t segment_length = (segment_number == filled_segment_count()) ? remainder_length() : filled_segment_length();
+        return segment_view<T>(contents + _flat_index(segment_number, 0), segment_length);
+    }
+
+    /**
+     * Returns a read-only view of segment `segment_number`, without copying it.
+     * 
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     * 
+     * @param segment_number segment to view. Must be a valid segment number in the array, or `{arrayName}.filled_segment_count()`
+     * @return view of the segment
+     */
+    segment_view<const T> segment(int64_t segment_number) const noexcept {
+        assert((segment_number >= 0 && segment_number <= filled_segment_count() && "Segment number must be a valid segment or the remainder"));
+        int32_t segment_length = (segment_number == filled_segment_count()) ? remainder_length() : filled_segment_length();
+        return segment_view<const T>(contents + _flat_index(segment_number, 0), segment_length);
+    }
+
+
+
     /**
-     * @return number of elements used by the array, including unused space
+     * @return view of the remainder, without copying it. Empty if no remainder exists.
      */
-    int64_t capacity() const noexcept {
-        return n_contents_elems;
+    segment_view<T> remainder() noexcept {
+        return segment(filled_segment_count());
+    }
+
+    /**
+     * @return read-only view of the remainder, without copying it. Empty if no remainder exists.
+     */
+    segment_view<const T> remainder() const noexcept {
+        return segment(filled_segment_count());
     }
 
 
 
     /**
-     * @return number of full-length segments in the array
+     * Returns a range of views of every segment, for use in range-based `for` loops. The remainder is the final segment, if it is not empty.
      * 
-     * The remainder does not count as a full-length segment.
+     * @return range of segment views
      */
-    int32_t filled_segment_count() const noexcept {
-        return n_segments;
+    segment_range<segmented_array, segment_view<T> > segments() noexcept {
+        return segment_range<segmented_array, segment_view<T> >(this);
     }
 
-
-
     /**
-     * @return length of each full-sized segment in the array
+     * Returns a range of read-only views of every segment, for use in range-based `for` loops. The remainder is the final segment, if it is not empty.
+     * 
+     * @return range of segment views
      */
-    int32_t filled_segment_length() const noexcept {
-        return n_elems_per_segment;
+    segment_range<const segmented_array, segment_view<const T> > segments() const noexcept {
+        return segment_range<const segmented_array, segment_view<const T> >(this);
     }
 
 
 
     /**
-     * @return number of elements in the remainder. Returns 0 if no remainder exists.
+     * Returns the flat position of the first element equal to `value`.
+     * The flat position of the element at segment `s` and position `e` is `s * {arrayName}.filled_segment_length() + e`.
+     * 
+     * Integer, enum, and pointer elements are compared with SSE2 or AVX2 instructions when the processor supports them.
+     * 
+     * @param value element to search for
+     * @return flat position of the first match, or -1 if there is none
      */
-    int32_t remainder_length() const noexcept {
-        return n_remainder_elems;
+    int64_t find(const T& value) const {
+        return _find_in(contents, size(), value, vector_comparable());
     }
 
 
 
     /**
-     * @return number of elements in the array (excluding unused space)
+     * Returns the position of the first element in segment `segment_number` equal to `value`.
      * 
-     * Total elements = number of segments * number of elements per segment + number of remainder elements
+     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     * 
+     * Integer, enum, and pointer elements are compared with SSE2 or AVX2 instructions when the processor supports them.
+     * 
+     * @param segment_number segment to search. Must be a valid segment number in the array, or `{arrayName}.filled_segment_count()`
+     * @param value element to search for
+     * @return element number of the first match in the segment, or -1 if there is none
      */
-    int64_t size() const noexcept {
-        return (int64_t)n_segments * (int64_t)n_elems_per_segment + (int64_t)n_remainder_elems;
+    int32_t find_in_segment(int64_t segment_number, const T& value) const {
+        assert((segment_number >= 0 && segment_number <= filled_segment_count() && "Segment number must be a valid segment or the remainder"));
+
+        int32_t segment_length = (segment_number == filled_segment_count()) ? remainder_length() : filled_segment_length();
+        return (int32_t)_find_in(contents + _flat_index(segment_number, 0), segment_length, value, vector_comparable());
     }
 
 
 
     /**
-     * Returns the element at segment `segment_number` and position `element_number` in the array as a character value.
-     * 
-     * Segment and element indexing starts at 0. The first element of the first segment is at `{arrayName}.value_at(0,0)`.
+     * Returns the number of elements equal to `value`.
      * 
-     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     * Integer, enum, and pointer elements are compared with SSE2 or AVX2 instructions when the processor supports them.
      * 
-     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
-     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
-     * @return character value at segment `segment_number` and position `element_number`
+     * @param value element to count
+     * @return number of matches
      */
-    const T& char_at(int32_t segment_number, int32_t element_number) const noexcept {
-        _assert_valid_index(segment_number, element_number);
-        return contents[n_elems_per_segment*segment_number + element_number];
+    int64_t count(const T& value) const {
+        return _count_in(contents, size(), value, vector_comparable());
     }
 
+
+
     /**
-     * Returns the element at segment `segment_number` and position `element_number` in the array as a character value.
+     * Writes the array to `output` in binary: a 64-byte header (segment length, segment count, remainder length, element size, and a checksum),
+     * then the raw elements with a single call. Unused space is not written. Load the result with `load` or `load_mapped`.
+     * Only available for trivially copyable types. Open `output` in binary mode.
      * 
-     * Segment and element indexing starts at 0. The first element of the first segment is at `{arrayName}.value_at(0,0)`.
+     * The saved array can only be loaded on machines with the same byte order.
      * 
-     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     * @param output stream to write to
+     * @throws `std::runtime_error` if writing fails
+     */
+    void save(std::ostream& output) const {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be saved as raw bytes");
+
+        binary_header header = _make_header();
+        output.write(reinterpret_cast<const char*>(&header), (std::streamsize)sizeof(header));
+        output.write(reinterpret_cast<const char*>(contents), (std::streamsize)(size() * (int64_t)sizeof(T)));
+        if(!output) {
+            throw std::runtime_error("Cannot write the segmented array");
+        }
+    }
+
+    /**
+     * Writes the array in binary to the file at `file_path`, replacing the file if it exists. See `save(std::ostream&)` for the format.
      * 
-     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
-     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
-     * @return character value at segment `segment_number` and position `element_number`
+     * @param file_path path of the file to write
+     * @throws `std::runtime_error` if the file cannot be opened or written
      */
-    T& char_at(int32_t segment_number, int32_t element_number) noexcept {
-        _assert_valid_index(segment_number, element_number);
-        return contents[n_elems_per_segment*segment_number + element_number];
+    void save(const std::string& file_path) const {
+        std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+        if(!file) {
+            throw std::runtime_error("Cannot open " + file_path);
+        }
+        save(file);
+        file.close();
+        if(!file) {
+            throw std::runtime_error("Cannot write " + file_path);
+        }
     }
 
 
 
     /**
-     * Returns the element at segment `segment_number` and position `element_number` in the array as an integer value.
-     * 
-     * Segment and element indexing starts at 0. The first element of the first segment is at `{arrayName}.value_at(0,0)`.
+     * Calls `function` with a read-only `segment_view` of every segment, including a non-empty remainder.
      * 
-     * The remainder's segment number, if a remainder exists, is `{arrayName}.filled_segment_count()`.
+     * If `pool` is given, segments are processed in parallel on its threads, in no particular order, and `function` must be safe to call from several threads at once.
+     * Otherwise, segments are processed in order on the calling thread.
      * 
-     * @param segment_number segment to access (0-based indexing). Must be a valid segment number in the array
-     * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
-     * @return value at segment `segment_number` and position `element_number`, as an integer
+     * @param function function to call with each segment's view
+     * @param pool threads to run on, or `nullptr` to run serially. Default: `nullptr`
+     * @throws the first exception thrown by `function`
      */
-    int32_t int_value_at(int32_t segment_number, int32_t element_number) const noexcept {
-        _assert_valid_index(segment_number, element_number);
-        return (int32_t)contents[n_elems_per_segment*segment_number + element_number];
+    template<typename Function>
+    void for_each_segment(Function function, thread_pool* pool = nullptr) const {
+        _run_on_segments([this, &function](int64_t segment_number) { function(segment(segment_number)); }, pool);
+    }
+
+    /**
+     * Computes `segment_result` for every segment, including a non-empty remainder, then combines the results in segment order:
+     * `combine(...combine(combine(initial, result_0), result_1)..., result_n)`.
+     * 
+     * If `pool` is given, the segment results are computed in parallel on its threads, and `segment_result` must be safe to call from several threads at once.
+     * The results are always combined on the calling thread, in order, so `combine` does not have to be commutative.
+     * 
+     * @param initial value to start combining from. Also returned if the array is empty
+     * @param segment_result function returning a `Result` for a read-only `segment_view` of one segment
+     * @param combine function returning the combination of a running `Result` and the next segment's `Result`
+     * @param pool threads to run on, or `nullptr` to run serially. Default: `nullptr`
+     * @return combination of every segment's result
+     * @throws the first exception thrown by `segment_result` or `combine`
+     */
+    template<typename Result, typename Function, typename Combine>
+    Result reduce_segments(Result initial, Function segment_result, Combine combine, thread_pool* pool = nullptr) const {
+        //One object per result, so threads never share storage (`std::vector<bool>` would pack results into shared words)
+        struct result_slot {
+            Result value;
+        };
+        std::vector<result_slot> results((size_t)n_segments + (n_remainder_elems > 0 ? 1 : 0), result_slot{initial});
+        _run_on_segments([this, &segment_result, &results](int64_t segment_number) {
+            results[segment_number].value = segment_result(segment(segment_number));
+        }, pool);
+
+        for(size_t i = 0; i < results.size(); i++) {
+            initial = combine(initial, results[i].value);
+        }
+        return initial;
     }
-    
-    
+
+
 
     /**
      * Returns the current contents of the array, in order, as a string of `char` or `wchar_t` (depending on the template's type).
@@ -547,19 +1860,61 @@ public:
      * 
      * @return in-order string representation of contents
      */
-    std::basic_string<T> to_string() const noexcept {
-        //Initialize empty output
-        std::basic_string<T> output;
+    std::basic_string<T> to_string() const {
+        //Copy all contents at once, allocating exactly `size()` elements
+        if(size() == 0) {
+            return std::basic_string<T>();
+        }
+        return std::basic_string<T>(contents, (size_t)size());
+    }
 
-        //Append all contents to the output string in order
-        for(int64_t i = 0; i < size(); i++) {
-            output.push_back(contents[i]);
+    /**
+     * Returns the current contents of the array as a string, with `separator` between each segment (and before a non-empty remainder).
+     * The string is allocated once, at its final length.
+     * 
+     * @param separator string to put between segments
+     * @return in-order string representation of contents, split into segments
+     */
+    std::basic_string<T> to_string(const std::basic_string<T>& separator) const {
+        int64_t n_views = (int64_t)n_segments + (n_remainder_elems > 0 ? 1 : 0);
+        std::basic_string<T> output;
+        if(n_views == 0) {
+            return output;
         }
+        output.reserve((size_t)(size() + (n_views - 1) * (int64_t)separator.length()));
 
-        //Resize to remove any extra space
-        output.resize(size()); 
+        for(int64_t i = 0; i < n_views; i++) {
+            if(i > 0) {
+                output.append(separator);
+            }
+            segment_view<const T> view = segment(i);
+            output.append(view.data(), (size_t)view.size());
+        }
         return output;
     }
+
+
+
+    /**
+     * Writes the array's contents to `output_stream`, with `separator` between each segment (and before a non-empty remainder).
+     * Each segment of the stream's character type is written with a single `write`.
+     * 
+     * @param output_stream output stream to write to
+     * @param separator string to write between segments
+     * @return `output_stream`
+     */
+    template<typename CharT, typename Traits>
+    std::basic_ostream<CharT, Traits>& write_segments(std::basic_ostream<CharT, Traits>& output_stream, const std::basic_string<CharT, Traits>& separator) const {
+        int64_t n_views = (int64_t)n_segments + (n_remainder_elems > 0 ? 1 : 0);
+        for(int64_t i = 0; i < n_views; i++) {
+            if(i > 0) {
+                output_stream.write(separator.data(), (std::streamsize)separator.length());
+            }
+            segment_view<const T> view = segment(i);
+            _write_elements(output_stream, view.data(), view.size());
+        }
+        return output_stream;
+    }
     
 
 
@@ -572,8 +1927,9 @@ public:
     /**
      * Removes all elements and unused space from the array.
      */
-    void clear() {
-        delete[] contents;
+    void clear() noexcept {
+        _destroy(contents, size());
+        _free_contents();
         contents = nullptr;
 
         n_segments = 0;
@@ -583,6 +1939,89 @@ public:
 
 
 
+    /**
+     * Exchanges the contents, sizes, and number of elements per segment of this array and `other_array`. No elements are copied, and nothing is allocated.
+     * 
+     * @param other_array array to swap with
+     */
+    void swap(segmented_array& other_array) noexcept {
+        std::swap(n_segments, other_array.n_segments);
+        std::swap(n_elems_per_segment, other_array.n_elems_per_segment);
+        std::swap(n_remainder_elems, other_array.n_remainder_elems);
+        std::swap(contents, other_array.contents);
+        std::swap(n_contents_elems, other_array.n_contents_elems);
+        std::swap(mapping, other_array.mapping);
+        std::swap(n_mapping_bytes, other_array.n_mapping_bytes);
+    }
+
+
+
+    /**
+     * Writes every change to an array mapped with `map_mode::READ_WRITE` back to its file, and waits until the writes finish.
+     * 
+     * Does nothing if the array is not in a mapped file, or was mapped in another mode.
+     * The file keeps its old length, so after `erase`, `pop_back`, or `insert` it holds the shifted elements followed by stale ones.
+     * 
+     * @throws `std::system_error` if the changes cannot be written
+     */
+    void flush() {
+        flush_mapping(mapping, n_mapping_bytes);
+    }
+
+
+
+    /**
+     * Calls `function` with a writable `segment_view` of every segment, including a non-empty remainder. `function` may change the segment's elements.
+     * 
+     * If `pool` is given, segments are processed in parallel on its threads, in no particular order, and `function` must be safe to call from several threads at once.
+     * Otherwise, segments are processed in order on the calling thread.
+     * 
+     * @param function function to call with each segment's view
+     * @param pool threads to run on, or `nullptr` to run serially. Default: `nullptr`
+     * @throws the first exception thrown by `function`. Segments may be partly processed
+     */
+    template<typename Function>
+    void for_each_segment(Function function, thread_pool* pool = nullptr) {
+        _run_on_segments([this, &function](int64_t segment_number) { function(segment(segment_number)); }, pool);
+    }
+
+    /**
+     * Replaces every element `e` with `function(e)`, one segment at a time.
+     * 
+     * If `pool` is given, segments are processed in parallel on its threads, and `function` must be safe to call from several threads at once.
+     * 
+     * @param function function returning the new value of an element
+     * @param pool threads to run on, or `nullptr` to run serially. Default: `nullptr`
+     * @throws the first exception thrown by `function`. Segments may be partly processed
+     */
+    template<typename Function>
+    void transform_segments(Function function, thread_pool* pool = nullptr) {
+        for_each_segment([&function](segment_view<T> view) {
+            for(T* element = view.begin(); element != view.end(); element++) {
+                *element = function(*element);
+            }
+        }, pool);
+    }
+
+
+
+    /**
+     * Makes the capacity at least `n_elements`, so that many elements can be held without reallocating.
+     * Does nothing if the capacity is already large enough. The capacity is never reduced.
+     * 
+     * Useful before a known number of appends. The growth policy is not used.
+     * 
+     * @param n_elements number of elements the array must be able to hold. Must be non-negative
+     */
+    void reserve(int64_t n_elements) {
+        assert((n_elements >= 0 && "Number of elements cannot be negative"));
+        if(n_elements > capacity()) {
+            _reallocate(n_elements);
+        }
+    }
+
+
+
     /**
      * Extends the array's unused space by `extension_length` elements.
      * 
@@ -590,22 +2029,14 @@ public:
      * 
      * @param extension_length number of elements to add to the array's unused space. Must be non-negative
      */
-    void extend_capacity(int32_t extension_length) {
+    void extend_capacity(int64_t extension_length) {
         assert((extension_length >= 0 && "Extension length cannot be negative"));
         if(extension_length == 0) {
             return;
         }
         
-        //Make new contents and load it
-        T* new_contents = new T[size() + (int64_t)extension_length];
-        std::copy(contents, contents + size(), new_contents);
-        
-        //Switch pointers
-        delete[] contents;
-        contents = new_contents;
-        
-        //Update contents size
-        n_contents_elems += extension_length;
+        //Move the contents to larger memory
+        _reallocate(capacity() + (int64_t)extension_length);
     }
 
 
@@ -614,13 +2045,13 @@ public:
      * Adds `new_value` to the end of the remainder.
      * If the remainder is filled, a new segment is created and `new_value` becomes the first value in the segment.
      * 
-     * If `shrink_to_fit` is false and the array has too little space to hold the new elements, the array adds twice its new length in unused elements.
+     * If `shrink_to_fit` is false and the array has too little space to hold the new elements, the array grows as chosen by `GrowthPolicy`.
      * If `shrink_to_fit` is true, the array adds the new element, then unconditionally removes all unused space.
      * 
      * @param new_value new element to add to the array
      * @param shrink_to_fit whether to remove unused space after the operation. Default: false.
      */
-    void push_back(T new_value, bool shrink_to_fit = false) {
+    void push_back(const T& new_value, bool shrink_to_fit = false) {
         if(shrink_to_fit) {
             _push_back_char_and_resize(new_value);
         }
@@ -633,7 +2064,7 @@ public:
      * Adds `new_values` to the end of the last segment, creating enough space to fit the new elements.
      * If the remainder is filled, a new segment is created and `new_values` becomes the first value in the segment.
      * 
-     * If `shrink_to_fit` is false and the array has too little space to hold the new elements, the array adds twice its new length in unused elements.
+     * If `shrink_to_fit` is false and the array has too little space to hold the new elements, the array grows as chosen by `GrowthPolicy`.
      * If `shrink_to_fit` is true, the array adds the new elements, then removes all unused space.
      * 
      * @param new_values new elements to add to the array
@@ -658,6 +2089,103 @@ public:
     
 
 
+    /**
+     * Adds the `n_values` elements starting at `values` to the end of the array, without building a temporary string.
+     * Trivially copyable elements are copied with a single `memcpy`.
+     * 
+     * If the array has too little space to hold the new elements, the array grows as chosen by `GrowthPolicy`.
+     * `values` may point to elements of this array.
+     * 
+     * @param values first element to append
+     * @param n_values number of elements to append. Must be non-negative
+     */
+    void append(const T* values, int64_t n_values) {
+        assert((n_values >= 0 && "Number of elements cannot be negative"));
+        if(n_values == 0) {
+            return;
+        }
+
+        _append(values, n_values, _capacity_for(n_values));
+        _add_to_counts(n_values);
+    }
+
+    /**
+     * Adds the elements from `first` to `last` to the end of the array. Each element is converted to `T`.
+     * 
+     * Pointers to `T` are copied like `append(first, last - first)`.
+     * Other forward iterators make room for every element once, then construct them in place.
+     * Input iterators (such as `std::istream_iterator`) append one element at a time.
+     * 
+     * Iterators other than pointers must not refer to elements of this array.
+     * 
+     * @param first iterator to the first element to append
+     * @param last iterator one past the final element to append
+     */
+    template<typename Iterator>
+    void append(Iterator first, Iterator last) {
+        typedef typename std::remove_cv<typename std::remove_pointer<Iterator>::type>::type pointed_type;
+        _append_range(first, last, std::integral_constant<bool, std::is_pointer<Iterator>::value && std::is_same<pointed_type, T>::value>());
+    }
+
+
+
+    /**
+     * Reads up to `n_values` elements of raw binary data from `input` straight into the unused space at the end of the array,
+     * without a temporary buffer. Stops early at the end of the input.
+     * Only available for trivially copyable types. Open `input` in binary mode.
+     * 
+     * Room for all `n_values` elements is made first, as chosen by `GrowthPolicy`. If fewer arrive, the extra room is left as unused space.
+     * If the input ends partway through an element, that element's bytes are discarded.
+     * 
+     * @param input stream to read from
+     * @param n_values largest number of elements to read. Must be non-negative
+     * @return number of elements appended
+     */
+    int64_t append_from(std::istream& input, int64_t n_values) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read as raw bytes");
+        assert((n_values >= 0 && "Number of elements cannot be negative"));
+        if(n_values == 0) {
+            return 0;
+        }
+
+        reserve(_capacity_for(n_values));
+        input.read(reinterpret_cast<char*>(contents + size()), (std::streamsize)(n_values * (int64_t)sizeof(T)));
+
+        int64_t n_new_elems = (int64_t)input.gcount() / (int64_t)sizeof(T);
+        _add_to_counts(n_new_elems);
+        return n_new_elems;
+    }
+
+    /**
+     * Reads up to `n_values` elements of raw binary data from the file descriptor `fd` straight into the unused space at the end of the array,
+     * without a temporary buffer. Stops early at the end of the input. Works for files, pipes, and sockets.
+     * Only available for trivially copyable types on POSIX systems.
+     * 
+     * Room for all `n_values` elements is made first, as chosen by `GrowthPolicy`. If fewer arrive, the extra room is left as unused space.
+     * If the input ends partway through an element, that element's bytes are discarded.
+     * 
+     * @param fd open file descriptor to read from
+     * @param n_values largest number of elements to read. Must be non-negative
+     * @return number of elements appended
+     * @throws `std::system_error` if reading fails. Elements read before the failure are not appended
+     */
+    int64_t append_from(int fd, int64_t n_values) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read as raw bytes");
+        assert((n_values >= 0 && "Number of elements cannot be negative"));
+        if(n_values == 0) {
+            return 0;
+        }
+
+        reserve(_capacity_for(n_values));
+        int64_t n_bytes = read_fd(fd, contents + size(), n_values * (int64_t)sizeof(T));
+
+        int64_t n_new_elems = n_bytes / (int64_t)sizeof(T);
+        _add_to_counts(n_new_elems);
+        return n_new_elems;
+    }
+
+
+
     /**
      * Removes `n_elements_to_remove` elements from the final segment(s) of the array.
      * 
@@ -667,7 +2195,7 @@ public:
      * @param n_elements_to_remove number of elements to remove. Must be non-negative and no greater than the amount of elements in the array. Default 1.
      * @param shrink_to_fit whether to remove unused space after the operation. Default: false.
      */
-    void pop_back(int32_t n_elements_to_remove = 1, bool shrink_to_fit = false) {
+    void pop_back(int64_t n_elements_to_remove = 1, bool shrink_to_fit = false) {
         //Idiot check
         assert((size() <= capacity() && "INTERNAL ERROR- Total element count cannot exceed total size"));
 
@@ -689,6 +2217,96 @@ public:
 
 
 
+    /**
+     * Inserts the `n_values` elements starting at `values` before the element at segment `segment_number` and position `element_number`.
+     * The elements after the position move towards the end of the array, crossing into later segments as needed.
+     * 
+     * Only the elements after the position are moved. Trivially copyable elements are moved with a single `memmove`.
+     * If the array has too little space to hold the new elements, the array grows as chosen by `GrowthPolicy`.
+     * `values` may point to elements of this array.
+     * 
+     * The end of the array, `({arrayName}.filled_segment_count(), {arrayName}.remainder_length())`, is a valid position, and inserts like `append`.
+     * 
+     * @param segment_number segment to insert into (0-based indexing). Must be non-negative
+     * @param element_number element to insert before (0-based indexing). Must be non-negative and less than `filled_segment_length()`,
+     * and no further into the array than its end
+     * @param values first element to insert
+     * @param n_values number of elements to insert. Must be non-negative
+     */
+    void insert(int64_t segment_number, int32_t element_number, const T* values, int64_t n_values) {
+        assert((segment_number >= 0 && element_number >= 0 && "Segment and element numbers must be non-negative"));
+        assert((element_number < _segment_length() && "Element number must be less than the number of elements per segment"));
+        assert((_flat_index(segment_number, element_number) <= size() && "Insert position cannot be past the end of the array"));
+        assert((n_values >= 0 && "Number of elements cannot be negative"));
+        if(n_values == 0) {
+            return;
+        }
+
+        //Elements of this array move during the shift, so they are inserted by rotating instead
+        std::less<const T*> before;
+        bool values_in_array = !before(values, contents) && before(values, contents + size());
+
+        int64_t position = _flat_index(segment_number, element_number);
+        if(values_in_array) {
+            _insert(position, values, n_values, std::false_type());
+        }
+        else {
+            _insert(position, values, n_values, trivial_elements());
+        }
+    }
+
+    /**
+     * Inserts `new_value` before the element at segment `segment_number` and position `element_number`.
+     * 
+     * @param segment_number segment to insert into (0-based indexing)
+     * @param element_number element to insert before (0-based indexing). Must be a valid element number in the array, or the end of the array
+     * @param new_value element to insert
+     */
+    void insert(int64_t segment_number, int32_t element_number, const T& new_value) {
+        insert(segment_number, element_number, &new_value, 1);
+    }
+
+    /**
+     * Inserts the elements of `new_values` before the element at segment `segment_number` and position `element_number`.
+     * 
+     * @param segment_number segment to insert into (0-based indexing)
+     * @param element_number element to insert before (0-based indexing). Must be a valid element number in the array, or the end of the array
+     * @param new_values elements to insert
+     */
+    void insert(int64_t segment_number, int32_t element_number, const std::basic_string<T>& new_values) {
+        insert(segment_number, element_number, new_values.data(), (int64_t)new_values.length());
+    }
+
+
+
+    /**
+     * Removes `n_elements_to_remove` elements, starting with the element at segment `segment_number` and position `element_number`.
+     * The elements after them move towards the start of the array to fill the gap, crossing into earlier segments as needed.
+     * 
+     * Only the elements after the removed ones are moved. Trivially copyable elements are moved with a single `memmove`.
+     * The removed elements are converted to unused space, like `pop_back`.
+     * 
+     * @param segment_number segment of the first element to remove (0-based indexing)
+     * @param element_number first element to remove (0-based indexing). Must be a valid element number in the array unless nothing is removed
+     * @param n_elements_to_remove number of elements to remove. Must be non-negative, and cannot reach past the end of the array. Default: 1
+     */
+    void erase(int64_t segment_number, int32_t element_number, int64_t n_elements_to_remove = 1) {
+        assert((n_elements_to_remove >= 0 && "Number of elements to remove cannot be negative"));
+        if(n_elements_to_remove == 0) {
+            return;
+        }
+        _assert_valid_index(segment_number, element_number);
+
+        int64_t position = _flat_index(segment_number, element_number);
+        assert((n_elements_to_remove <= size() - position && "Elements to remove cannot reach past the end of the array"));
+
+        //Close the gap, then drop the leftover elements at the end
+        std::move(contents + position + n_elements_to_remove, contents + size(), contents + position);
+        _pop_back_n(n_elements_to_remove);
+    }
+
+
+
     /**
      * Sets the element at segment `segment_number` and position `element_number` in the array to `new_value`.
      * 
@@ -698,9 +2316,9 @@ public:
      * @param element_number element number to change. Must be a valid element number in the array
      * @param new_value new value to set at segment `segment_number` and element `element_number`
      */
-    void set_char_at(int32_t segment_number, int32_t element_number, T new_value) {
+    void set_char_at(int64_t segment_number, int32_t element_number, const T& new_value) {
         _assert_valid_index(segment_number, element_number);
-        contents[n_elems_per_segment*segment_number + element_number] = new_value;
+        contents[_flat_index(segment_number, element_number)] = new_value;
     }
 
 
@@ -714,9 +2332,9 @@ public:
      * @param element_number element number to change. Must be a valid element number in the array
      * @param new_value value to set at segment `segment_number` and element `element_number`
      */
-    void set_int_value_at(int32_t segment_number, int32_t element_number, int32_t new_value) {
+    void set_int_value_at(int64_t segment_number, int32_t element_number, int32_t new_value) {
         _assert_valid_index(segment_number, element_number);
-        contents[n_elems_per_segment*segment_number + element_number] = (T)new_value;
+        contents[_flat_index(segment_number, element_number)] = (T)new_value;
     }
 
 
@@ -729,18 +2347,8 @@ public:
         //Idiot check
         assert((size() <= capacity() && "INTERNAL ERROR- Total element count cannot exceed total size"));
 
-        //Create new array pointer with barely enough elements to hold the contents
-        T* new_contents = new T[size()];
-
-        //Copy current contents to new array
-        std::copy(contents, contents + size(), new_contents);
-
-        //Make the current contents point to the newly allocated memory
-        delete[] contents;
-        contents = new_contents;
-
-        //Update size of contents
-        n_contents_elems = size();
+        //Move the contents to memory with barely enough elements to hold them
+        _reallocate(size());
     }
 
 
@@ -753,6 +2361,7 @@ public:
     
     /**
      * Copies the contents of `other_array` into this array, returning a reference to this array.
+     * Only the elements are copied, so this array is left with no unused space.
      *
      * @param other_array other array to copy
      * @return reference to the newly copied array
@@ -763,18 +2372,48 @@ public:
             return *this;
         }
         
+        //copy the other array's elements first, so this array is unchanged if copying fails
+        T* new_contents = _allocate(other_array.size());
+        try {
+            _construct_copy(other_array.contents, other_array.size(), new_contents);
+        }
+        catch(...) {
+            _deallocate(new_contents);
+            throw;
+        }
+
         //remove current contents
-        delete[] contents;
+        _destroy(contents, size());
+        _free_contents();
+        contents = new_contents;
         
-        //copy all data from the other array into this array
+        //copy all sizes from the other array into this array
         n_segments = other_array.n_segments;
         n_elems_per_segment = other_array.n_elems_per_segment;
         n_remainder_elems = other_array.n_remainder_elems;
-        n_contents_elems = other_array.n_contents_elems;
+        n_contents_elems = other_array.size();
+        return *this;
+    }
+
 
-        contents = new T[other_array.n_contents_elems];
 
-        std::copy(other_array.contents, other_array.contents + other_array.n_contents_elems, contents);
+    /**
+     * Moves the contents of `other_array` into this array without copying any elements, returning a reference to this array.
+     * This array's old contents are removed. `other_array` is left empty, with the same number of elements per segment.
+     *
+     * @param other_array other array to move
+     * @return reference to this array
+     */
+    segmented_array& operator=(segmented_array&& other_array) noexcept {
+        //self assignment check
+        if (this == &other_array) {
+            return *this;
+        }
+
+        //remove current contents, then take the other array's contents
+        clear();
+        swap(other_array);
+        other_array.n_elems_per_segment = n_elems_per_segment;
         return *this;
     }
     
@@ -799,13 +2438,7 @@ public:
         }
 
         //Check corresponding elements
-        for (int64_t i = 0; i < size(); i++) {
-            if(other_array.contents[i] != contents[i]) {
-                return false;
-            }
-        }
-        
-        return true;
+        return _equal_range(contents, other_array.contents, size(), vector_comparable());
     }
 
 
@@ -817,7 +2450,7 @@ public:
      * 
      * @param new_char character to add to the end of the array
      */
-    void operator+=(T new_char) {
+    void operator+=(const T& new_char) {
         this->_push_back_char(new_char);
     }
 
@@ -847,9 +2480,9 @@ public:
      * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
      * @return character value at segment `segment_number` and position `element_number`
      */
-    T& operator() (int32_t segment_number, int32_t element_number) {
+    T& operator() (int64_t segment_number, int32_t element_number) {
         _assert_valid_index(segment_number, element_number);
-        return contents[n_elems_per_segment*segment_number + element_number];
+        return contents[_flat_index(segment_number, element_number)];
     }
 
     /**
@@ -865,9 +2498,32 @@ public:
      * @param element_number element to access in segment `segment_number` (0-based indexing). Must be a valid element number in the array
      * @return character value at segment `segment_number` and position `element_number`
      */
-    const T& operator() (int32_t segment_number, int32_t element_number) const {
+    const T& operator() (int64_t segment_number, int32_t element_number) const {
         _assert_valid_index(segment_number, element_number);
-        return contents[n_elems_per_segment*segment_number + element_number];
+        return contents[_flat_index(segment_number, element_number)];
+    }
+
+    /**
+     * Returns the element at flat position `flat_index`, without dividing it into segment and element numbers.
+     * The flat position of the element at segment `s` and position `e` is `s * {arrayName}.filled_segment_length() + e`.
+     * 
+     * @param flat_index position of the element, counting from the first element of segment 0. Must be non-negative and less than `size()`
+     * @return reference to the element
+     */
+    T& operator[](int64_t flat_index) noexcept {
+        assert((flat_index >= 0 && flat_index < size() && "Flat index must be in the array"));
+        return contents[flat_index];
+    }
+
+    /**
+     * Returns the element at flat position `flat_index`, without dividing it into segment and element numbers.
+     * 
+     * @param flat_index position of the element, counting from the first element of segment 0. Must be non-negative and less than `size()`
+     * @return reference to the element
+     */
+    const T& operator[](int64_t flat_index) const noexcept {
+        assert((flat_index >= 0 && flat_index < size() && "Flat index must be in the array"));
+        return contents[flat_index];
     }
     
 
@@ -875,14 +2531,15 @@ public:
     /**
      * Exports the in-order contents of `arr` to the output stream `output_stream`, returning a reference to `output_stream` with `arr` added.
      * 
-     * Equivalent to `output_stream << arr.to_string()`.
+     * Elements of the stream's character type are written with a single `write`, without a temporary string and without padding to the stream's width.
+     * Other elements are written one at a time with `<<`.
      * 
      * @param output_stream output stream to export to
      * @param arr Segmented Array to export
      * @return `output_stream` containing the array's information inside
      */
-    template<typename CharT, typename Traits, typename Tp>
-    friend std::basic_ostream<Tp>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const segmented_array<Tp>& arr);
+    template<typename CharT, typename Traits, typename Tp, typename Gp, int32_t Lp>
+    friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const segmented_array<Tp, Gp, Lp>& arr);
 
 
     //////////////////////////////////////////////////////////
@@ -895,18 +2552,42 @@ public:
      * Properly destroys a Segmented Array.
      */
     ~segmented_array() {
-        delete[] contents;
+        _destroy(contents, size());
+        _free_contents();
         contents = nullptr;
     }
 };
 
 
 
-template<typename CharT, typename Traits, typename T>
-std::basic_ostream<T>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const segmented_array<T>& arr) {
-    for(int64_t i = 0; i < arr.size(); i++) {
-        output_stream << arr.contents[i];
-    }
+/**
+ * A Segmented Array whose segment length is fixed at compile time. See `segmented_array`.
+ * 
+ * @param T datatype stored in the array
+ * @param SegmentLength number of elements per segment. Must be positive. Powers of two are fastest
+ * @param GrowthPolicy decides how much unused space to add when an append needs more room. Default: `default_growth`
+ */
+template<typename T, int32_t SegmentLength, typename GrowthPolicy = default_growth>
+using fixed_segmented_array = segmented_array<T, GrowthPolicy, SegmentLength>;
+
+
+
+/**
+ * Exchanges the contents of `a` and `b` without copying any elements.
+ *
+ * @param a first array to swap
+ * @param b second array to swap
+ */
+template<typename T, typename GrowthPolicy, int32_t SegmentLength>
+void swap(segmented_array<T, GrowthPolicy, SegmentLength>& a, segmented_array<T, GrowthPolicy, SegmentLength>& b) noexcept {
+    a.swap(b);
+}
+
+
+
+template<typename CharT, typename Traits, typename T, typename GrowthPolicy, int32_t SegmentLength>
+std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& output_stream, const segmented_array<T, GrowthPolicy, SegmentLength>& arr) {
+    segmented_array<T, GrowthPolicy, SegmentLength>::_write_elements(output_stream, arr.contents, arr.size());
     return output_stream;
 }
 
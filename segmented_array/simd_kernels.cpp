@@ -0,0 +1,474 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+//Vector kernels are only built for x86 compilers that support per-function target attributes
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    #define UTILS_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+namespace utils {
+namespace simd {
+
+
+
+
+/**
+ * Instruction set used by the kernels. Higher levels are faster.
+ */
+enum level {
+    SCALAR = 0,
+    SSE2 = 1,
+    AVX2 = 2
+};
+
+
+
+/**
+ * Returns the best instruction set supported by the processor.
+ *
+ * @return best supported level
+ */
+inline level detected_level() noexcept {
+    #ifdef UTILS_SIMD_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2")) {
+            return AVX2;
+        }
+        if(__builtin_cpu_supports("sse2")) {
+            return SSE2;
+        }
+    #endif
+    return SCALAR;
+}
+
+
+
+/**
+ * Returns a reference to the level used by the kernels. Starts as `detected_level()`.
+ *
+ * Private helper method.
+ *
+ * @return reference to the level in use
+ */
+inline level& _current_level() noexcept {
+    static level current = detected_level();
+    return current;
+}
+
+/**
+ * @return instruction set currently used by the kernels
+ */
+inline level active_level() noexcept {
+    return _current_level();
+}
+
+/**
+ * Makes the kernels use at most `max_level`. Useful for benchmarks and for testing the fallback kernels.
+ *
+ * Not thread-safe: call before any thread uses the kernels.
+ *
+ * @param max_level highest level to use. Levels the processor does not support are never used
+ */
+inline void limit_level(level max_level) noexcept {
+    _current_level() = (max_level < detected_level()) ? max_level : detected_level();
+}
+
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////
+//SCALAR KERNELS
+
+
+/**
+ * Unsigned integer type `Width` bytes wide
+ */
+template<int Width> struct lane {};
+template<> struct lane<1> { typedef uint8_t type; };
+template<> struct lane<2> { typedef uint16_t type; };
+template<> struct lane<4> { typedef uint32_t type; };
+template<> struct lane<8> { typedef uint64_t type; };
+
+
+
+/**
+ * Returns the position of the first element in `data[first]` through `data[n_elems-1]` with the same bytes as `value`, one element at a time.
+ *
+ * @param Width size of each element, in bytes
+ * @param data elements to search
+ * @param first position to start at
+ * @param n_elems number of elements in `data`
+ * @param value pointer to the element to search for
+ * @return position of the first match, or -1 if there is none
+ */
+template<int Width>
+int64_t _find_scalar(const void* data, int64_t first, int64_t n_elems, const void* value) noexcept {
+    typedef typename lane<Width>::type word;
+    word needle;
+    std::memcpy(&needle, value, Width);
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for(int64_t i = first; i < n_elems; i++) {
+        word element;
+        std::memcpy(&element, bytes + i * Width, Width);
+        if(element == needle) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+
+/**
+ * Returns the number of elements in `data[first]` through `data[n_elems-1]` with the same bytes as `value`, one element at a time.
+ *
+ * @param Width size of each element, in bytes
+ * @param data elements to search
+ * @param first position to start at
+ * @param n_elems number of elements in `data`
+ * @param value pointer to the element to count
+ * @return number of matches
+ */
+template<int Width>
+int64_t _count_scalar(const void* data, int64_t first, int64_t n_elems, const void* value) noexcept {
+    typedef typename lane<Width>::type word;
+    word needle;
+    std::memcpy(&needle, value, Width);
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    int64_t total = 0;
+    for(int64_t i = first; i < n_elems; i++) {
+        word element;
+        std::memcpy(&element, bytes + i * Width, Width);
+        total += (element == needle);
+    }
+    return total;
+}
+
+
+
+/**
+ * Returns whether bytes `first` through `n_bytes-1` of `a` and `b` are equal, one byte at a time.
+ *
+ * @param a first byte range
+ * @param b second byte range
+ * @param first position to start at
+ * @param n_bytes number of bytes in each range
+ * @return true if the ranges are equal, false otherwise
+ */
+inline bool _equal_scalar(const void* a, const void* b, int64_t first, int64_t n_bytes) noexcept {
+    const unsigned char* a_bytes = static_cast<const unsigned char*>(a);
+    const unsigned char* b_bytes = static_cast<const unsigned char*>(b);
+    for(int64_t i = first; i < n_bytes; i++) {
+        if(a_bytes[i] != b_bytes[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+
+#ifdef UTILS_SIMD_X86
+//////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////
+//SSE2 KERNELS
+
+/*
+Every kernel compares one 16-byte (SSE2) or 32-byte (AVX2) block at a time.
+Blocks always start on an element boundary, since the block size is a multiple of every element width.
+A comparison leaves all bytes of a matching element set, so the byte mask from `movemask` holds `Width` bits per match.
+The final partial block is handled by the scalar kernels.
+*/
+
+
+/**
+ * Returns `value` copied into every `Width`-byte lane of a 16-byte vector.
+ *
+ * @param Width size of each element, in bytes
+ * @param value pointer to the element to copy
+ * @return vector of copies
+ */
+template<int Width>
+__attribute__((target("sse2"))) __m128i _broadcast_sse2(const void* value) noexcept {
+    typename lane<Width>::type word;
+    std::memcpy(&word, value, Width);
+
+    if(Width == 1) return _mm_set1_epi8((char)word);
+    if(Width == 2) return _mm_set1_epi16((short)word);
+    if(Width == 4) return _mm_set1_epi32((int)word);
+    return _mm_set1_epi64x((long long)word);
+}
+
+/**
+ * Compares every `Width`-byte lane of `a` and `b`. Equal lanes become all ones, and other lanes become all zeros.
+ *
+ * @param Width size of each element, in bytes
+ * @param a first vector
+ * @param b second vector
+ * @return comparison result
+ */
+template<int Width>
+__attribute__((target("sse2"))) __m128i _compare_sse2(__m128i a, __m128i b) noexcept {
+    if(Width == 1) return _mm_cmpeq_epi8(a, b);
+    if(Width == 2) return _mm_cmpeq_epi16(a, b);
+    if(Width == 4) return _mm_cmpeq_epi32(a, b);
+
+    //SSE2 has no 64-bit comparison: both 32-bit halves must match
+    __m128i halves = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+
+
+/**
+ * SSE2 version of `_find_scalar`, starting at the first element.
+ */
+template<int Width>
+__attribute__((target("sse2"))) int64_t _find_sse2(const void* data, int64_t n_elems, const void* value) noexcept {
+    const char* bytes = static_cast<const char*>(data);
+    int64_t n_bytes = n_elems * Width;
+    __m128i needle = _broadcast_sse2<Width>(value);
+
+    int64_t i = 0;
+    for(; i + 16 <= n_bytes; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_compare_sse2<Width>(block, needle));
+        if(mask != 0) {
+            return (i + __builtin_ctz(mask)) / Width;
+        }
+    }
+    return _find_scalar<Width>(data, i / Width, n_elems, value);
+}
+
+/**
+ * SSE2 version of `_count_scalar`, starting at the first element.
+ */
+template<int Width>
+__attribute__((target("sse2"))) int64_t _count_sse2(const void* data, int64_t n_elems, const void* value) noexcept {
+    const char* bytes = static_cast<const char*>(data);
+    int64_t n_bytes = n_elems * Width;
+    __m128i needle = _broadcast_sse2<Width>(value);
+
+    int64_t matched_bytes = 0;
+    int64_t i = 0;
+    for(; i + 16 <= n_bytes; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+        matched_bytes += __builtin_popcount((uint32_t)_mm_movemask_epi8(_compare_sse2<Width>(block, needle)));
+    }
+    return matched_bytes / Width + _count_scalar<Width>(data, i / Width, n_elems, value);
+}
+
+/**
+ * SSE2 version of `_equal_scalar`, starting at the first byte.
+ */
+__attribute__((target("sse2"))) inline bool _equal_sse2(const void* a, const void* b, int64_t n_bytes) noexcept {
+    const char* a_bytes = static_cast<const char*>(a);
+    const char* b_bytes = static_cast<const char*>(b);
+
+    int64_t i = 0;
+    for(; i + 16 <= n_bytes; i += 16) {
+        __m128i a_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a_bytes + i));
+        __m128i b_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b_bytes + i));
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(a_block, b_block)) != 0xFFFF) {
+            return false;
+        }
+    }
+    return _equal_scalar(a, b, i, n_bytes);
+}
+
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////
+//AVX2 KERNELS
+
+
+/**
+ * Returns `value` copied into every `Width`-byte lane of a 32-byte vector.
+ *
+ * @param Width size of each element, in bytes
+ * @param value pointer to the element to copy
+ * @return vector of copies
+ */
+template<int Width>
+__attribute__((target("avx2"))) __m256i _broadcast_avx2(const void* value) noexcept {
+    typename lane<Width>::type word;
+    std::memcpy(&word, value, Width);
+
+    if(Width == 1) return _mm256_set1_epi8((char)word);
+    if(Width == 2) return _mm256_set1_epi16((short)word);
+    if(Width == 4) return _mm256_set1_epi32((int)word);
+    return _mm256_set1_epi64x((long long)word);
+}
+
+/**
+ * Compares every `Width`-byte lane of `a` and `b`. Equal lanes become all ones, and other lanes become all zeros.
+ *
+ * @param Width size of each element, in bytes
+ * @param a first vector
+ * @param b second vector
+ * @return comparison result
+ */
+template<int Width>
+__attribute__((target("avx2"))) __m256i _compare_avx2(__m256i a, __m256i b) noexcept {
+    if(Width == 1) return _mm256_cmpeq_epi8(a, b);
+    if(Width == 2) return _mm256_cmpeq_epi16(a, b);
+    if(Width == 4) return _mm256_cmpeq_epi32(a, b);
+    return _mm256_cmpeq_epi64(a, b);
+}
+
+
+
+/**
+ * AVX2 version of `_find_scalar`, starting at the first element.
+ */
+template<int Width>
+__attribute__((target("avx2"))) int64_t _find_avx2(const void* data, int64_t n_elems, const void* value) noexcept {
+    const char* bytes = static_cast<const char*>(data);
+    int64_t n_bytes = n_elems * Width;
+    __m256i needle = _broadcast_avx2<Width>(value);
+
+    int64_t i = 0;
+    for(; i + 32 <= n_bytes; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_compare_avx2<Width>(block, needle));
+        if(mask != 0) {
+            return (i + __builtin_ctz(mask)) / Width;
+        }
+    }
+    return _find_scalar<Width>(data, i / Width, n_elems, value);
+}
+
+/**
+ * AVX2 version of `_count_scalar`, starting at the first element.
+ */
+template<int Width>
+__attribute__((target("avx2,popcnt"))) int64_t _count_avx2(const void* data, int64_t n_elems, const void* value) noexcept {
+    const char* bytes = static_cast<const char*>(data);
+    int64_t n_bytes = n_elems * Width;
+    __m256i needle = _broadcast_avx2<Width>(value);
+
+    int64_t matched_bytes = 0;
+    int64_t i = 0;
+    for(; i + 32 <= n_bytes; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i));
+        matched_bytes += __builtin_popcount((uint32_t)_mm256_movemask_epi8(_compare_avx2<Width>(block, needle)));
+    }
+    return matched_bytes / Width + _count_scalar<Width>(data, i / Width, n_elems, value);
+}
+
+/**
+ * AVX2 version of `_equal_scalar`, starting at the first byte.
+ */
+__attribute__((target("avx2"))) inline bool _equal_avx2(const void* a, const void* b, int64_t n_bytes) noexcept {
+    const char* a_bytes = static_cast<const char*>(a);
+    const char* b_bytes = static_cast<const char*>(b);
+
+    int64_t i = 0;
+    for(; i + 32 <= n_bytes; i += 32) {
+        __m256i a_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_bytes + i));
+        __m256i b_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b_bytes + i));
+        if((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a_block, b_block)) != 0xFFFFFFFFu) {
+            return false;
+        }
+    }
+    return _equal_scalar(a, b, i, n_bytes);
+}
+#endif
+
+
+
+//////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////
+//DISPATCHERS
+
+
+/**
+ * Returns the position of the first of `n_elems` elements in `data` whose bytes equal those of `value`.
+ * Uses the best kernel allowed by `active_level()`.
+ *
+ * @param Width size of each element, in bytes. Must be 1, 2, 4, or 8
+ * @param data elements to search
+ * @param n_elems number of elements in `data`. Must be non-negative
+ * @param value pointer to the element to search for
+ * @return position of the first match, or -1 if there is none
+ */
+template<int Width>
+int64_t find(const void* data, int64_t n_elems, const void* value) noexcept {
+    #ifdef UTILS_SIMD_X86
+        if(active_level() == AVX2) {
+            return _find_avx2<Width>(data, n_elems, value);
+        }
+        if(active_level() == SSE2) {
+            return _find_sse2<Width>(data, n_elems, value);
+        }
+    #endif
+    return _find_scalar<Width>(data, 0, n_elems, value);
+}
+
+
+
+/**
+ * Returns the number of the `n_elems` elements in `data` whose bytes equal those of `value`.
+ * Uses the best kernel allowed by `active_level()`.
+ *
+ * @param Width size of each element, in bytes. Must be 1, 2, 4, or 8
+ * @param data elements to search
+ * @param n_elems number of elements in `data`. Must be non-negative
+ * @param value pointer to the element to count
+ * @return number of matches
+ */
+template<int Width>
+int64_t count(const void* data, int64_t n_elems, const void* value) noexcept {
+    #ifdef UTILS_SIMD_X86
+        if(active_level() == AVX2) {
+            return _count_avx2<Width>(data, n_elems, value);
+        }
+        if(active_level() == SSE2) {
+            return _count_sse2<Width>(data, n_elems, value);
+        }
+    #endif
+    return _count_scalar<Width>(data, 0, n_elems, value);
+}
+
+
+
+/**
+ * Returns whether the first `n_bytes` bytes of `a` and `b` are equal.
+ * Uses the best kernel allowed by `active_level()`.
+ *
+ * @param a first byte range
+ * @param b second byte range
+ * @param n_bytes number of bytes in each range. Must be non-negative
+ * @return true if the ranges are equal, false otherwise
+ */
+inline bool equal(const void* a, const void* b, int64_t n_bytes) noexcept {
+    #ifdef UTILS_SIMD_X86
+        if(active_level() == AVX2) {
+            return _equal_avx2(a, b, n_bytes);
+        }
+        if(active_level() == SSE2) {
+            return _equal_sse2(a, b, n_bytes);
+        }
+    #endif
+    return _equal_scalar(a, b, 0, n_bytes);
+}
+
+
+
+
+}
+}
@@ -0,0 +1,55 @@
+//Checked and unchecked accessors do not depend on assertions, so disabling them must not change this test's output
+#define NDEBUG
+
+#include "chunked_segmented_array.cpp"
+#include "segmented_array.cpp"
+#include <iostream>
+#include <stdexcept>
+
+
+/**
+ * Tests `checked_at`, which always checks indices, and `unchecked_at`, which never does, with assertions disabled
+ */
+void test_access() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<char> arr = segmented_array<char>("abcdefghij", 4);
+    arr.checked_at(1, 0) = 'E';
+    arr.unchecked_at(2, 1) = 'J';
+    cout << "Expected: E J a E J" << endl;
+    cout << arr.checked_at(1, 0) << " " << arr.checked_at(2, 1) << " " << arr.unchecked_at(0, 0) << " " << arr.unchecked_at(4) << " " << arr.unchecked_at(9) << endl;
+
+    //Past the remainder, past the last segment, and negative indices all throw
+    int64_t bad_segments[4] = {2, 3, -1, 0};
+    int32_t bad_elements[4] = {2, 0, 0, 4};
+    for(int32_t i = 0; i < 4; i++) {
+        try {
+            arr.checked_at(bad_segments[i], bad_elements[i]);
+            cout << "No exception" << endl;
+        }
+        catch(const out_of_range& e) {
+            cout << "Expected: Segment " << bad_segments[i] << ", element " << bad_elements[i] << " is outside the array" << endl;
+            cout << e.what() << endl;
+        }
+    }
+
+    const chunked_segmented_array<char> chunked = chunked_segmented_array<char>("chunked", 2, 1);
+    cout << "Expected: c k d u" << endl;
+    cout << chunked.checked_at(0, 0) << " " << chunked.checked_at(2, 0) << " " << chunked.unchecked_at(3, 0) << " " << chunked.unchecked_at(2) << endl;
+    try {
+        chunked.checked_at(3, 1);
+        cout << "No exception" << endl;
+    }
+    catch(const out_of_range& e) {
+        cout << "Expected: Segment 3, element 1 is outside the array" << endl;
+        cout << e.what() << endl;
+    }
+}
+
+
+
+int main() {
+    test_access();
+    return 0;
+}
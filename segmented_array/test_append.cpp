@@ -0,0 +1,103 @@
+#include "segmented_array.cpp"
+#include <cstdio>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+
+/**
+ * Tests appending from pointers and iterators
+ */
+void test_append() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<char> arr = segmented_array<char>("abc", 2);
+    const char* letters = "defgh";
+    arr.append(letters, 5);
+    cout << "Expected: abcdefgh, 4 segments" << endl;
+    cout << arr.to_string() << ", " << arr.filled_segment_count() << " segments" << endl;
+
+    //The array may append its own elements, even when it has to grow
+    arr.shrink_to_fit();
+    arr.append(arr.data(), arr.size());
+    cout << "Expected: abcdefghabcdefgh" << endl;
+    cout << arr.to_string() << endl;
+
+    list<char> chars = {'x', 'y', 'z'};
+    arr.append(chars.begin(), chars.end());
+    arr.append(letters, letters + 2);
+    cout << "Expected: abcdefghabcdefghxyzde" << endl;
+    cout << arr.to_string() << endl;
+
+    istringstream words("1 2 3 4 5");
+    segmented_array<int32_t> numbers = segmented_array<int32_t>(0, 2);
+    numbers.append(istream_iterator<int32_t>(words), istream_iterator<int32_t>());
+    vector<int32_t> more = {6, 7};
+    numbers.append(more.begin(), more.end());
+    cout << "Expected: 1 2 3 4 5 6 7 (3 segments, remainder 1)" << endl;
+    for(int32_t i = 0; i < numbers.size(); i++) {
+        cout << numbers(i / 2, i % 2) << " ";
+    }
+    cout << "(" << numbers.filled_segment_count() << " segments, remainder " << numbers.remainder_length() << ")" << endl;
+
+    vector<string> names = {"ann", "bob"};
+    segmented_array<string> strings = segmented_array<string>(0, 3);
+    strings.append(names.begin(), names.end());
+    strings.append(names.data(), 1);
+    cout << "Expected: ann bob ann" << endl;
+    cout << strings(0, 0) << " " << strings(0, 1) << " " << strings(0, 2) << endl;
+}
+
+
+
+/**
+ * Tests reading straight into an array from a stream and a file descriptor
+ */
+void test_append_from() {
+    using namespace std;
+    using namespace utils;
+
+    istringstream input("streamed data");
+    segmented_array<char> arr = segmented_array<char>("", 4);
+    int64_t n_read = arr.append_from(input, 8);
+    n_read += arr.append_from(input, 100);
+    cout << "Expected: streamed data, 13 read" << endl;
+    cout << arr.to_string() << ", " << n_read << " read" << endl;
+
+    //Reads stop at the end of the input, discarding a partial element
+    istringstream bytes(string("\x01\x00\x00\x00\x02\x00\x00\x00\x03", 9));
+    segmented_array<int32_t> numbers = segmented_array<int32_t>(0, 4);
+    cout << "Expected: 2 read, 1 2" << endl;
+    cout << numbers.append_from(bytes, 5) << " read, " << numbers(0, 0) << " " << numbers(0, 1) << endl;
+
+    int pipe_ends[2];
+    if(pipe(pipe_ends) != 0) {
+        cout << "Cannot create pipe" << endl;
+        return;
+    }
+    string message = "through a pipe";
+    if(write(pipe_ends[1], message.data(), message.size()) != (ssize_t)message.size()) {
+        cout << "Cannot write to pipe" << endl;
+    }
+    close(pipe_ends[1]);
+
+    segmented_array<char> piped = segmented_array<char>(">", 4);
+    n_read = piped.append_from(pipe_ends[0], 1000);
+    close(pipe_ends[0]);
+    cout << "Expected: >through a pipe, 14 read" << endl;
+    cout << piped.to_string() << ", " << n_read << " read" << endl;
+}
+
+
+
+int main() {
+    test_append();
+    test_append_from();
+    return 0;
+}
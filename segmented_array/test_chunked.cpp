@@ -0,0 +1,88 @@
+#include "chunked_segmented_array.cpp"
+#include <iostream>
+
+
+/**
+ * Tests appending across chunk boundaries, and that appending never moves existing chunks
+ */
+void test_append() {
+    using namespace std;
+    using namespace utils;
+
+    //2 segments of 3 elements per chunk
+    chunked_segmented_array<char> arr = chunked_segmented_array<char>("abcd", 3, 2);
+    const char* first_element = &arr.char_at(0, 0);
+
+    arr.push_back("efghijklm");
+    arr.push_back('n');
+    cout << "Expected: abcdefghijklmn" << endl;
+    cout << arr.to_string() << endl;
+    cout << "Expected: 4, 3, 2" << endl;
+    cout << arr.filled_segment_count() << ", " << arr.filled_segment_length() << ", " << arr.remainder_length() << endl;
+    cout << "Expected capacity: 18" << endl;
+    cout << arr.capacity() << endl;
+
+    cout << "Expected: 1 (first chunk did not move)" << endl;
+    cout << (first_element == &arr.char_at(0, 0)) << endl;
+
+    cout << "Expected: j m n" << endl;
+    cout << arr(3, 0) << " " << arr(4, 0) << " " << arr(4, 1) << endl;
+}
+
+
+
+/**
+ * Tests removing elements, and freeing chunks with `shrink_to_fit`
+ */
+void test_remove() {
+    using namespace std;
+    using namespace utils;
+
+    chunked_segmented_array<char> arr = chunked_segmented_array<char>("abcdefghijklmn", 3, 2);
+
+    arr.pop_back(8);
+    cout << "Expected: abcdef, capacity 18" << endl;
+    cout << arr.to_string() << ", capacity " << arr.capacity() << endl;
+
+    arr.shrink_to_fit();
+    cout << "Expected: abcdef, capacity 6" << endl;
+    cout << arr.to_string() << ", capacity " << arr.capacity() << endl;
+
+    arr.pop_back(6, true);
+    cout << "Expected: (empty), capacity 0" << endl;
+    cout << arr.to_string() << "(empty), capacity " << arr.capacity() << endl;
+}
+
+
+
+/**
+ * Tests Rule of Three methods and the equality operator
+ */
+void test_copying() {
+    using namespace std;
+    using namespace utils;
+
+    chunked_segmented_array<char> a1 = chunked_segmented_array<char>("hello world", 3, 1);
+    chunked_segmented_array<char> a2 = a1;
+    a2.set_char_at(0, 0, 'j');
+    cout << "Expected: hello world, jello world" << endl;
+    cout << a1.to_string() << ", " << a2.to_string() << endl;
+
+    //Different chunk sizes do not affect equality
+    chunked_segmented_array<char> a3 = chunked_segmented_array<char>("hello world", 3, 4);
+    cout << "Expected: 1 0" << endl;
+    cout << (a1 == a3) << " " << (a1 == a2) << endl;
+
+    a2 = a3;
+    cout << "Expected: hello world" << endl;
+    cout << a2 << endl;
+}
+
+
+
+int main() {
+    test_append();
+    test_remove();
+    test_copying();
+    return 0;
+}
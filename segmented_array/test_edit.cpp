@@ -0,0 +1,64 @@
+#include "segmented_array.cpp"
+#include <iostream>
+#include <string>
+
+
+/**
+ * Tests inserting and erasing elements in the middle of an array
+ */
+void test_edit() {
+    using namespace std;
+    using namespace utils;
+
+    //Inserts shift later elements across segment boundaries
+    segmented_array<char> arr = segmented_array<char>("abcdefghij", 4);
+    arr.insert(1, 1, string("XY"));
+    cout << "Expected: abcdeXYfghij, 3 segments, remainder 0" << endl;
+    cout << arr.to_string() << ", " << arr.filled_segment_count() << " segments, remainder " << arr.remainder_length() << endl;
+
+    arr.insert(0, 0, '<');
+    arr.insert(arr.filled_segment_count(), arr.remainder_length(), '>');
+    cout << "Expected: <abcdeXYfghij>, 14" << endl;
+    cout << arr.to_string() << ", " << arr.size() << endl;
+
+    //Inserting part of the array into itself
+    arr.insert(2, 0, arr.data() + 1, 3);
+    cout << "Expected: <abcdeXYabcfghij>" << endl;
+    cout << arr.to_string() << endl;
+
+    arr.erase(1, 2, 5);
+    cout << "Expected: <abcdefghij>, 12" << endl;
+    cout << arr.to_string() << ", " << arr.size() << endl;
+
+    arr.erase(0, 0);
+    arr.erase(2, 2);
+    arr.erase(1, 0, 0);
+    cout << "Expected: abcdefghij, 2 segments, remainder 2" << endl;
+    cout << arr.to_string() << ", " << arr.filled_segment_count() << " segments, remainder " << arr.remainder_length() << endl;
+
+    //Inserts that outgrow the capacity, then erasing everything
+    segmented_array<char> small = segmented_array<char>("ad", 2);
+    small.shrink_to_fit();
+    small.insert(0, 1, string("bc"));
+    cout << "Expected: abcd" << endl;
+    cout << small.to_string() << endl;
+    small.erase(0, 0, small.size());
+    cout << "Expected: 0, ''" << endl;
+    cout << small.size() << ", '" << small.to_string() << "'" << endl;
+
+    //Elements that are not trivially copyable
+    segmented_array<string> words = segmented_array<string>(0, 2);
+    string initial[3] = {"one", "three", "four"};
+    words.append(initial, 3);
+    words.insert(0, 1, string("two"));
+    words.erase(1, 1);
+    cout << "Expected: one two three, size 3" << endl;
+    cout << words[0] << " " << words[1] << " " << words[2] << ", size " << words.size() << endl;
+}
+
+
+
+int main() {
+    test_edit();
+    return 0;
+}
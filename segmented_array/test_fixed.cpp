@@ -0,0 +1,72 @@
+#include "segmented_array.cpp"
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+
+/**
+ * Tests arrays whose segment length is fixed at compile time
+ */
+void test_fixed_length() {
+    using namespace std;
+    using namespace utils;
+
+    //Power of two: addressing uses shifts and masks
+    fixed_segmented_array<char, 4> pow2 = fixed_segmented_array<char, 4>("abcdefghij", 4);
+    cout << "Expected: 2 segments of 4, remainder 2, g i" << endl;
+    cout << pow2.filled_segment_count() << " segments of " << pow2.filled_segment_length() << ", remainder " << pow2.remainder_length()
+        << ", " << pow2(1, 2) << " " << pow2(2, 0) << endl;
+
+    pow2.push_back("klmnop");
+    pow2.set_char_at(3, 3, '!');
+    pow2.pop_back(3);
+    cout << "Expected: abcdefghijklm, 3 segments, remainder 1" << endl;
+    cout << pow2.to_string() << ", " << pow2.filled_segment_count() << " segments, remainder " << pow2.remainder_length() << endl;
+
+    //Other lengths are also fixed at compile time
+    fixed_segmented_array<int32_t, 3> three = fixed_segmented_array<int32_t, 3>(2, 3, 1);
+    for(int32_t i = 0; i < 7; i++) {
+        three(i / 3, i % 3) = i * 10;
+    }
+    cout << "Expected: 60 in the remainder, 7 elements" << endl;
+    cout << three.remainder()[0] << " in the remainder, " << three.size() << " elements" << endl;
+
+    //The segment length can be left out, and a different one is rejected even without assertions
+    fixed_segmented_array<char, 4> implied = fixed_segmented_array<char, 4>(string("abcdefghijklmnopqrst"));
+    cout << "Expected: 5 segments of 4, 20 elements" << endl;
+    cout << implied.filled_segment_count() << " segments of " << implied.filled_segment_length() << ", " << implied.size() << " elements" << endl;
+    try {
+        fixed_segmented_array<char, 4>("abcdefghijklmnopqrst", 5);
+        cout << "No exception" << endl;
+    }
+    catch(const invalid_argument& e) {
+        cout << "Expected: Number of elements per segment must equal the fixed segment length of 4" << endl;
+        cout << e.what() << endl;
+    }
+
+    //Saved arrays only load into arrays with the same fixed length
+    stringstream buffer;
+    pow2.save(buffer);
+    fixed_segmented_array<char, 4> reloaded = fixed_segmented_array<char, 4>::load(buffer);
+    cout << "Expected: abcdefghijklm" << endl;
+    cout << reloaded << endl;
+
+    buffer.clear();
+    buffer.seekg(0);
+    try {
+        fixed_segmented_array<char, 8>::load(buffer);
+        cout << "No exception" << endl;
+    }
+    catch(const invalid_argument& e) {
+        cout << "Expected: fixed length error" << endl;
+        cout << e.what() << endl;
+    }
+}
+
+
+
+int main() {
+    test_fixed_length();
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "segmented_array.cpp"
+#include <iostream>
+
+
+/**
+ * Appends `n_elems` characters one at a time to an empty array with 4 elements per segment,
+ * printing the capacity after every reallocation.
+ *
+ * @param GrowthPolicy growth policy to test
+ * @param n_elems number of characters to append
+ */
+template<typename GrowthPolicy>
+void print_capacities(int32_t n_elems) {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<char, GrowthPolicy> arr = segmented_array<char, GrowthPolicy>(0, 4);
+    int64_t last_capacity = arr.capacity();
+    for(int32_t i = 0; i < n_elems; i++) {
+        arr.push_back('x');
+        if(arr.capacity() != last_capacity) {
+            last_capacity = arr.capacity();
+            cout << last_capacity << " ";
+        }
+    }
+    cout << endl;
+}
+
+
+
+/**
+ * Tests the capacities chosen by each growth policy
+ */
+void test_policies() {
+    using namespace std;
+    using namespace utils;
+
+    cout << "Expected: 1 4 10 22 46 " << endl;
+    print_capacities<default_growth>(40);
+    cout << "Expected: 1 2 3 4 6 9 13 19 28 42 " << endl;
+    print_capacities<geometric_growth<3, 2> >(40);
+    cout << "Expected: 4 8 12 20 32 48 " << endl;
+    print_capacities<segment_aligned_growth<geometric_growth<3, 2> > >(40);
+    cout << "Expected: 1 4 8 12 16 20 24 28 32 36 40 " << endl;
+    print_capacities<capped_growth<3> >(40);
+}
+
+
+
+/**
+ * Tests `reserve`
+ */
+void test_reserve() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<char> arr = segmented_array<char>("abc", 2);
+    arr.reserve(100);
+    cout << "Expected: 100 abc" << endl;
+    cout << arr.capacity() << " " << arr << endl;
+
+    //Never shrinks
+    arr.reserve(10);
+    cout << "Expected: 100" << endl;
+    cout << arr.capacity() << endl;
+}
+
+
+
+int main() {
+    test_policies();
+    test_reserve();
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "chunked_segmented_array.cpp"
+#include "segmented_array.cpp"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+/**
+ * Tests flat indexing and conversion between flat positions and segment and element numbers
+ */
+void test_indexing() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<char> arr = segmented_array<char>("abcdefghij", 4);
+    arr[4] = 'E';
+    cout << "Expected: a E j, E" << endl;
+    cout << arr[0] << " " << arr[4] << " " << arr.at(9) << ", " << arr(1, 0) << endl;
+
+    try {
+        arr.at(10);
+        cout << "No exception" << endl;
+    }
+    catch(const out_of_range& e) {
+        cout << "Expected: Flat index 10 is outside an array of size 10" << endl;
+        cout << e.what() << endl;
+    }
+
+    pair<int64_t, int32_t> coords = arr.to_coords(9);
+    cout << "Expected: (2, 1), 9" << endl;
+    cout << "(" << coords.first << ", " << coords.second << "), " << arr.to_flat(coords.first, coords.second) << endl;
+
+    int64_t flat[4] = {0, 3, 4, 9};
+    int64_t segment_numbers[4];
+    int32_t element_numbers[4];
+    int64_t back[4];
+    arr.to_coords(flat, 4, segment_numbers, element_numbers);
+    arr.to_flat(segment_numbers, element_numbers, 4, back);
+    cout << "Expected: (0,0) (0,3) (1,0) (2,1), 0 3 4 9" << endl;
+    for(int32_t i = 0; i < 4; i++) {
+        cout << (i > 0 ? " " : "") << "(" << segment_numbers[i] << "," << element_numbers[i] << ")";
+    }
+    cout << ", " << back[0] << " " << back[1] << " " << back[2] << " " << back[3] << endl;
+
+    //Power-of-two fixed segment lengths convert with shifts and masks
+    fixed_segmented_array<char, 8> fixed = fixed_segmented_array<char, 8>("0123456789ABCDEFGHIJ", 8);
+    cout << "Expected: (2, 3), J" << endl;
+    cout << "(" << fixed.to_coords(19).first << ", " << fixed.to_coords(19).second << "), " << fixed[19] << endl;
+
+    const chunked_segmented_array<char> chunked = chunked_segmented_array<char>("chunked", 2, 1);
+    cout << "Expected: c k d" << endl;
+    cout << chunked[0] << " " << chunked[4] << " " << chunked.at(6) << endl;
+}
+
+
+
+int main() {
+    test_indexing();
+    return 0;
+}
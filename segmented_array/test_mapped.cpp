@@ -0,0 +1,113 @@
+#include "segmented_array.cpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+
+/**
+ * Returns the contents of the file at `path`.
+ *
+ * @param path path of the file to read
+ * @return contents of the file
+ */
+std::string read_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+
+
+/**
+ * Tests each mapping mode on a small file
+ */
+void test_mapping_modes() {
+    using namespace std;
+    using namespace utils;
+
+    const string path = "test_mapped.tmp";
+    ofstream(path, ios::binary) << "abcdefghijklmnopqrstuvwxyz";
+
+    //Read-only
+    {
+        segmented_array<char> arr = segmented_array<char>(path, 4, map_mode::READ_ONLY);
+        cout << "Expected: 6, 4, 2, mapped 1" << endl;
+        cout << arr.filled_segment_count() << ", " << arr.filled_segment_length() << ", " << arr.remainder_length() << ", mapped " << arr.is_mapped() << endl;
+        cout << "Expected: abcdefghijklmnopqrstuvwxyz" << endl;
+        cout << arr.to_string() << endl;
+    }
+
+    //Copy-on-write: the file does not change
+    {
+        segmented_array<char> arr = segmented_array<char>(path, 4, map_mode::COPY_ON_WRITE);
+        arr.set_char_at(0, 0, 'A');
+        cout << "Expected: Abcd, file abcd" << endl;
+        cout << arr.segment(0).to_string() << ", file " << read_file(path).substr(0, 4) << endl;
+    }
+
+    //Read-write: flushed changes reach the file
+    {
+        segmented_array<char> arr = segmented_array<char>(path, 4, map_mode::READ_WRITE);
+        arr.set_char_at(6, 1, 'Z');
+        arr.flush();
+        cout << "Expected: file ends with yZ" << endl;
+        cout << "file ends with " << read_file(path).substr(24) << endl;
+
+        //Appending past the capacity moves the contents off the file
+        arr.push_back('!');
+        cout << "Expected: mapped 0, yZ!, file ends with yZ" << endl;
+        cout << "mapped " << arr.is_mapped() << ", " << arr.remainder().to_string() << ", file ends with " << read_file(path).substr(24) << endl;
+    }
+
+    //Read-write: erasing shifts the elements, but the file keeps its length and stale bytes at its end
+    {
+        ofstream(path, ios::binary) << "abcdefg";
+        segmented_array<char> arr = segmented_array<char>(path, 4, map_mode::READ_WRITE);
+        arr.set_char_at(0, 0, 'Z');
+        arr.erase(0, 1, 2);
+        arr.flush();
+        cout << "Expected: Zdefg, file Zdefgfg" << endl;
+        cout << arr.to_string() << ", file " << read_file(path) << endl;
+    }
+
+    remove(path.c_str());
+}
+
+
+
+/**
+ * Tests mapping errors
+ */
+void test_mapping_errors() {
+    using namespace std;
+    using namespace utils;
+
+    cout << "Expected: system_error" << endl;
+    try {
+        segmented_array<char> arr = segmented_array<char>("no_such_file.tmp", 4, map_mode::READ_ONLY);
+        cout << "no error" << endl;
+    }
+    catch(system_error& e) {
+        cout << "system_error" << endl;
+    }
+
+    const string path = "test_mapped.tmp";
+    ofstream(path, ios::binary) << "abcdefg";
+    cout << "Expected: invalid_argument" << endl;
+    try {
+        segmented_array<int32_t> arr = segmented_array<int32_t>(path, 4, map_mode::READ_ONLY);
+        cout << "no error" << endl;
+    }
+    catch(invalid_argument& e) {
+        cout << "invalid_argument" << endl;
+    }
+    remove(path.c_str());
+}
+
+
+
+int main() {
+    test_mapping_modes();
+    test_mapping_errors();
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "chunked_segmented_array.cpp"
+#include "segmented_array.cpp"
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/**
+ * Returns a new array, which is moved out of the function instead of copied.
+ *
+ * @param text contents of the new array
+ * @return array containing `text`, 3 elements per segment
+ */
+utils::segmented_array<char> make_array(const std::string& text) {
+    utils::segmented_array<char> arr = utils::segmented_array<char>(text, 3);
+    return arr;
+}
+
+
+
+/**
+ * Tests the move constructor, move assignment, and swap
+ */
+void test_moves() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<char> a1 = make_array("abcdefg");
+    const char* a1_data = a1.data();
+    segmented_array<char> a2 = std::move(a1);
+    cout << "Expected: abcdefg, 1 (not copied), a1 size 0" << endl;
+    cout << a2.to_string() << ", " << (a2.data() == a1_data) << ", a1 size " << a1.size() << endl;
+
+    //Moved-from arrays can be reused
+    a1.push_back("xyz");
+    cout << "Expected: xyz" << endl;
+    cout << a1.to_string() << endl;
+
+    a1 = std::move(a2);
+    cout << "Expected: abcdefg, a2 size 0" << endl;
+    cout << a1.to_string() << ", a2 size " << a2.size() << endl;
+
+    segmented_array<char> a3 = segmented_array<char>("12345", 2);
+    swap(a1, a3);
+    cout << "Expected: 12345 (2 per segment), abcdefg (3 per segment)" << endl;
+    cout << a1.to_string() << " (" << a1.filled_segment_length() << " per segment), "
+        << a3.to_string() << " (" << a3.filled_segment_length() << " per segment)" << endl;
+
+    chunked_segmented_array<char> c1 = chunked_segmented_array<char>("chunked", 2, 1);
+    chunked_segmented_array<char> c2 = std::move(c1);
+    c1 = chunked_segmented_array<char>("other", 2);
+    swap(c1, c2);
+    cout << "Expected: chunked other" << endl;
+    cout << c1.to_string() << " " << c2.to_string() << endl;
+}
+
+
+
+/**
+ * Tests that copies leave out unused space
+ */
+void test_copy_capacity() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<char> a1 = segmented_array<char>("abc", 2);
+    a1.reserve(1000);
+    segmented_array<char> a2 = a1;
+    segmented_array<char> a3 = segmented_array<char>("", 2);
+    a3 = a1;
+    cout << "Expected: 1000 3 3" << endl;
+    cout << a1.capacity() << " " << a2.capacity() << " " << a3.capacity() << endl;
+}
+
+
+
+/**
+ * Tests a vector of arrays, which moves its arrays when it grows
+ */
+void test_vector_of_arrays() {
+    using namespace std;
+    using namespace utils;
+
+    vector<segmented_array<char> > arrays;
+    vector<const char*> data_pointers;
+    for(int32_t i = 0; i < 100; i++) {
+        arrays.push_back(segmented_array<char>(string(100, (char)('a' + i % 26)), 10));
+        data_pointers.push_back(arrays.back().data());
+    }
+
+    bool all_moved = true;
+    for(int32_t i = 0; i < 100; i++) {
+        all_moved = all_moved && (arrays[i].data() == data_pointers[i]);
+    }
+    cout << "Expected: 1 (no array was copied)" << endl;
+    cout << all_moved << endl;
+}
+
+
+
+int main() {
+    test_moves();
+    test_copy_capacity();
+    test_vector_of_arrays();
+    return 0;
+}
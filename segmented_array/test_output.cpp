@@ -0,0 +1,63 @@
+#include "chunked_segmented_array.cpp"
+#include "segmented_array.cpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+
+/**
+ * Tests `to_string`, `write_segments`, and `<<`
+ */
+void test_output() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<char> arr = segmented_array<char>("abcdefgh", 3);
+    cout << "Expected: abcdefgh" << endl;
+    cout << arr << endl;
+    cout << "Expected: abc | def | gh" << endl;
+    cout << arr.to_string(" | ") << endl;
+
+    ostringstream lines;
+    arr.write_segments(lines, string("\n"));
+    cout << "Expected: abc/def/gh" << endl;
+    string written = lines.str();
+    for(char& c : written) {
+        c = (c == '\n') ? '/' : c;
+    }
+    cout << written << endl;
+
+    segmented_array<char> full = segmented_array<char>("abcdef", 3);
+    segmented_array<char> empty = segmented_array<char>("", 3);
+    cout << "Expected: [abc-def] []" << endl;
+    cout << "[" << full.to_string("-") << "] [" << empty.to_string("-") << empty << "]" << endl;
+
+    segmented_array<wchar_t> wide = segmented_array<wchar_t>(L"wide text", 4);
+    wostringstream wide_output;
+    wide_output << wide;
+    wide.write_segments(wide_output, wstring(L"_"));
+    cout << "Expected: 1 (wide text, then wide_ tex_t)" << endl;
+    cout << (wide_output.str() == L"wide textwide_ tex_t") << endl;
+
+    //Other element types are written one element at a time
+    segmented_array<int32_t> numbers = segmented_array<int32_t>(0, 2);
+    numbers.push_back(1);
+    numbers.push_back(2);
+    numbers.push_back(3);
+    ostringstream number_output;
+    number_output << numbers;
+    numbers.write_segments(number_output, string(","));
+    cout << "Expected: 12312,3" << endl;
+    cout << number_output.str() << endl;
+
+    chunked_segmented_array<char> chunked = chunked_segmented_array<char>("chunked output", 2, 2);
+    cout << "Expected: chunked output" << endl;
+    cout << chunked << endl;
+}
+
+
+
+int main() {
+    test_output();
+    return 0;
+}
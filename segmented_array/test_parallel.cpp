@@ -0,0 +1,97 @@
+#include "segmented_array.cpp"
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+
+/**
+ * Converts English letters to their position in the alphabet, as the old `mut_array::lettersToNumValue` did.
+ * Other characters are unchanged.
+ *
+ * @param c character to convert
+ * @return 0 for 'a' or 'A', 1 for 'b' or 'B'... 25 for 'z' or 'Z', or `c`
+ */
+char letter_to_number(char c) {
+    if(c >= 'A' && c <= 'Z') {
+        return (char)(c - 'A');
+    }
+    if(c >= 'a' && c <= 'z') {
+        return (char)(c - 'a');
+    }
+    return c;
+}
+
+
+
+/**
+ * Tests the segment operations serially and on a pool
+ */
+void test_segment_operations(utils::thread_pool* pool) {
+    using namespace std;
+    using namespace utils;
+
+    string text;
+    for(int32_t i = 0; i < 10000; i++) {
+        text += (char)('a' + i % 26);
+    }
+    text += "XYZ!";
+    segmented_array<char> arr = segmented_array<char>(text, 7);
+
+    arr.transform_segments(letter_to_number, pool);
+    int64_t total = arr.reduce_segments((int64_t)0, [](segment_view<const char> view) {
+        int64_t sum = 0;
+        for(char c : view) {
+            sum += c;
+        }
+        return sum;
+    }, [](int64_t a, int64_t b) { return a + b; }, pool);
+    cout << "Expected: 125025" << endl;
+    cout << total << endl;
+
+    //Results are combined in segment order, even when computed in parallel
+    string firsts = arr.reduce_segments(string(), [](segment_view<const char> view) {
+        return string(1, (char)('a' + view[0]));
+    }, [](const string& a, const string& b) { return a + b; }, pool);
+    cout << "Expected: ahovcjq, 1430 segments" << endl;
+    cout << firsts.substr(0, 7) << ", " << firsts.size() << " segments" << endl;
+
+    //Boolean results are kept apart, so threads never write to the same word
+    bool all_full = arr.reduce_segments(true, [](segment_view<const char> view) {
+        return view.size() == 7;
+    }, [](bool a, bool b) { return a && b; }, pool);
+    bool all_non_empty = arr.reduce_segments(true, [](segment_view<const char> view) {
+        return view.size() > 0;
+    }, [](bool a, bool b) { return a && b; }, pool);
+    cout << "Expected: 0 1" << endl;
+    cout << all_full << " " << all_non_empty << endl;
+
+    arr.for_each_segment([](segment_view<char> view) { view[0] = '#'; }, pool);
+    cout << "Expected: 1430 first elements changed" << endl;
+    cout << arr.count('#') << " first elements changed" << endl;
+
+    try {
+        arr.for_each_segment([](segment_view<char> view) {
+            if(view.size() < 7) {
+                throw runtime_error("short segment");
+            }
+        }, pool);
+        cout << "No exception" << endl;
+    }
+    catch(const runtime_error& e) {
+        cout << "Expected: short segment" << endl;
+        cout << e.what() << endl;
+    }
+}
+
+
+
+int main() {
+    std::cout << "Serial" << std::endl;
+    test_segment_operations(nullptr);
+
+    utils::thread_pool pool(4);
+    std::cout << "On " << pool.size() << " threads" << std::endl;
+    test_segment_operations(&pool);
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include "segmented_array.cpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <stdexcept>
+#include <string>
+
+
+/**
+ * Tests saving and loading through streams and files
+ */
+void test_save_load() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<char> arr = segmented_array<char>("abcdefghij", 4);
+    stringstream buffer;
+    arr.save(buffer);
+    segmented_array<char> loaded = segmented_array<char>::load(buffer);
+    cout << "Expected: abcdefghij, 2 segments of 4, remainder 2, capacity 10" << endl;
+    cout << loaded.to_string() << ", " << loaded.filled_segment_count() << " segments of " << loaded.filled_segment_length()
+        << ", remainder " << loaded.remainder_length() << ", capacity " << loaded.capacity() << endl;
+
+    const char* path = "test_save.tmp";
+    segmented_array<int32_t> numbers = segmented_array<int32_t>(0, 3);
+    for(int32_t i = 1; i <= 7; i++) {
+        numbers.push_back(i * 100);
+    }
+    numbers.save(path);
+
+    segmented_array<int32_t> from_file = segmented_array<int32_t>::load(path);
+    cout << "Expected: 100 700 (7 elements)" << endl;
+    cout << from_file(0, 0) << " " << from_file(2, 0) << " (" << from_file.size() << " elements)" << endl;
+
+    //Changes to a mapped array do not reach the file
+    segmented_array<int32_t> mapped = segmented_array<int32_t>::load_mapped(path);
+    mapped.set_char_at(1, 1, -1);
+    mapped.push_back(800);
+    cout << "Expected: -1 800 8, not mapped" << endl;
+    cout << mapped(1, 1) << " " << mapped(2, 1) << " " << mapped.size() << ", " << (mapped.is_mapped() ? "mapped" : "not mapped") << endl;
+    cout << "Expected: 500" << endl;
+    cout << segmented_array<int32_t>::load_mapped(path)(1, 1) << endl;
+
+    segmented_array<char> empty = segmented_array<char>("", 5);
+    empty.save(path);
+    segmented_array<char> empty_mapped = segmented_array<char>::load_mapped(path);
+    empty_mapped.push_back("xyz");
+    cout << "Expected: xyz, 5 per segment" << endl;
+    cout << empty_mapped.to_string() << ", " << empty_mapped.filled_segment_length() << " per segment" << endl;
+
+    remove(path);
+}
+
+
+
+/**
+ * Stream buffer over a string that cannot seek, like a pipe
+ */
+class unseekable_buffer : public std::streambuf {
+private:
+    std::string data;
+
+public:
+    explicit unseekable_buffer(const std::string& contents) : data(contents) {
+        setg(&data[0], &data[0], &data[0] + data.size());
+    }
+};
+
+
+
+/**
+ * Tests that damaged or mismatched data is rejected
+ */
+void test_invalid_data() {
+    using namespace std;
+    using namespace utils;
+
+    const char* path = "test_save.tmp";
+    segmented_array<int32_t> numbers = segmented_array<int32_t>(2, 3);
+    numbers.save(path);
+
+    try {
+        segmented_array<char>::load(path);
+        cout << "No exception" << endl;
+    }
+    catch(const invalid_argument& e) {
+        cout << "Expected: element size error" << endl;
+        cout << e.what() << endl;
+    }
+
+    //Change one element's byte
+    {
+        fstream file(path, ios::in | ios::out | ios::binary);
+        file.seekp(64 + 5);
+        file.put('!');
+    }
+    try {
+        segmented_array<int32_t>::load_mapped(path);
+        cout << "No exception" << endl;
+    }
+    catch(const invalid_argument& e) {
+        cout << "Expected: checksum error" << endl;
+        cout << e.what() << endl;
+    }
+    cout << "Expected: 6 elements loaded without checking" << endl;
+    cout << segmented_array<int32_t>::load_mapped(path, false).size() << " elements loaded without checking" << endl;
+
+    //A header larger than the file, and sizes that overflow when multiplied
+    segmented_array<char> letters = segmented_array<char>("abcdefghij", 4);
+    letters.save(path);
+    binary_header header;
+    {
+        fstream file(path, ios::in | ios::out | ios::binary);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        header.header_bytes = 1 << 20;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    try {
+        segmented_array<char>::load_mapped(path, false);
+        cout << "No exception" << endl;
+    }
+    catch(const invalid_argument& e) {
+        cout << "Expected: The saved segmented array is truncated" << endl;
+        cout << e.what() << endl;
+    }
+
+    header.header_bytes = sizeof(header);
+    header.n_segments = INT64_MAX / 2;
+    header.n_elements = 10;
+    stringstream overflowing(string(reinterpret_cast<const char*>(&header), sizeof(header)) + "abcdefghij");
+    try {
+        segmented_array<char>::load(overflowing);
+        cout << "No exception" << endl;
+    }
+    catch(const invalid_argument& e) {
+        cout << "Expected: The saved segmented array has inconsistent sizes" << endl;
+        cout << e.what() << endl;
+    }
+
+    //A header claiming far more elements than follow is rejected before the elements are allocated, whether or not the stream can seek
+    header.n_segments = (int64_t)1 << 40;
+    header.n_elements = header.n_segments * header.elements_per_segment + header.n_remainder_elems;
+    string huge_claim = string(reinterpret_cast<const char*>(&header), sizeof(header)) + "abcdefghij";
+    stringstream seekable(huge_claim);
+    unseekable_buffer unseekable_data(huge_claim);
+    istream unseekable(&unseekable_data);
+    istream* huge_streams[2] = {&seekable, &unseekable};
+    for(int32_t i = 0; i < 2; i++) {
+        try {
+            segmented_array<char>::load(*huge_streams[i]);
+            cout << "No exception" << endl;
+        }
+        catch(const invalid_argument& e) {
+            cout << "Expected: The saved segmented array is truncated" << endl;
+            cout << e.what() << endl;
+        }
+    }
+
+    stringstream truncated(string("SEGARRAY", 8));
+    try {
+        segmented_array<char>::load(truncated);
+        cout << "No exception" << endl;
+    }
+    catch(const invalid_argument& e) {
+        cout << "Expected: too short error" << endl;
+        cout << e.what() << endl;
+    }
+
+    remove(path);
+}
+
+
+
+int main() {
+    test_save_load();
+    test_invalid_data();
+    return 0;
+}
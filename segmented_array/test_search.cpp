@@ -0,0 +1,60 @@
+#include "segmented_array.cpp"
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+
+/**
+ * Tests `find`, `count`, and `find_in_segment` with every instruction set the processor supports
+ */
+void test_search() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<char> arr = segmented_array<char>("the quick brown fox jumps over the lazy dog, then naps in the sun", 10);
+    segmented_array<uint32_t> numbers = segmented_array<uint32_t>(0, 8);
+    for(uint32_t i = 0; i < 100; i++) {
+        numbers.push_back(i % 7);
+    }
+
+    for(int32_t level = simd::AVX2; level >= simd::SCALAR; level--) {
+        simd::limit_level((simd::level)level);
+        cout << "Level " << simd::active_level() << endl;
+
+        cout << "Expected: 16 -1 5" << endl;
+        cout << arr.find('f') << " " << arr.find('!') << " " << arr.count('n') << endl;
+
+        cout << "Expected: 7 -1 2" << endl;
+        cout << arr.find_in_segment(0, 'c') << " " << arr.find_in_segment(2, 'q') << " " << arr.find_in_segment(6, 's') << endl;
+
+        cout << "Expected: 6 14 2 -1" << endl;
+        cout << numbers.find(6) << " " << numbers.count(3) << " " << numbers.find_in_segment(12, 0) << " " << numbers.find(7) << endl;
+    }
+}
+
+
+
+/**
+ * Tests the equality operator with long arrays, which are compared in blocks
+ */
+void test_long_equality() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<wchar_t> a1 = segmented_array<wchar_t>(wstring(1000, L'x'), 64);
+    segmented_array<wchar_t> a2 = a1;
+    cout << "Expected: 1" << endl;
+    cout << (a1 == a2) << endl;
+
+    a2.set_char_at(15, 39, L'y');
+    cout << "Expected: 0" << endl;
+    cout << (a1 == a2) << endl;
+}
+
+
+
+int main() {
+    test_search();
+    test_long_equality();
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "segmented_array.cpp"
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+
+/**
+ * A plain record, trivially copyable
+ */
+struct sample {
+    uint32_t id;
+    float value;
+};
+
+
+
+/**
+ * Tests arrays of numbers and plain structs
+ */
+void test_trivial_types() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<uint32_t> ids = segmented_array<uint32_t>(0, 4);
+    for(uint32_t i = 0; i < 10; i++) {
+        ids.push_back(i * 100);
+    }
+    cout << "Expected: 2, 4, 2" << endl;
+    cout << ids.filled_segment_count() << ", " << ids.filled_segment_length() << ", " << ids.remainder_length() << endl;
+    cout << "Expected: 500 900" << endl;
+    cout << ids(1, 1) << " " << ids(2, 1) << endl;
+
+    segmented_array<sample> samples = segmented_array<sample>(2, 3);
+    samples.set_char_at(1, 2, sample{7, 0.5f});
+    samples.push_back(samples(1, 2));
+    cout << "Expected: 7 0.5" << endl;
+    cout << samples(2, 0).id << " " << samples(2, 0).value << endl;
+}
+
+
+
+/**
+ * Tests an array of non-trivial elements, which must be constructed and destroyed
+ */
+void test_non_trivial_types() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<string> words = segmented_array<string>(1, 2);
+    cout << "Expected: 2 empty strings" << endl;
+    cout << "'" << words(0, 0) << "' '" << words(0, 1) << "'" << endl;
+
+    words.set_char_at(0, 0, "segmented");
+    words.push_back("array");
+    words.push_back(words(0, 0), true);
+    cout << "Expected: segmented  array segmented, capacity 4" << endl;
+    cout << words(0, 0) << " " << words(0, 1) << " " << words(1, 0) << " " << words(1, 1) << ", capacity " << words.capacity() << endl;
+
+    segmented_array<string> copy = words;
+    words.pop_back(3);
+    cout << "Expected: 1 4" << endl;
+    cout << words.size() << " " << copy.size() << endl;
+    cout << "Expected: 0 1" << endl;
+    cout << (words == copy) << " " << (copy == copy) << endl;
+}
+
+
+
+int main() {
+    test_trivial_types();
+    test_non_trivial_types();
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "chunked_segmented_array.cpp"
+#include "segmented_array.cpp"
+#include <iostream>
+#include <string>
+
+
+/**
+ * Tests viewing single segments, the remainder, and the contents
+ */
+void test_segment_views() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<char> arr = segmented_array<char>("abcdefghijklmnopqrstuvwxyz", 4);
+
+    cout << "Expected: efgh 4" << endl;
+    cout << arr.segment(1).to_string() << " " << arr.segment(1).size() << endl;
+    cout << "Expected: yz 2" << endl;
+    cout << arr.remainder().to_string() << " " << arr.remainder().size() << endl;
+
+    //Views write through to the array
+    segment_view<char> view = arr.segment(2);
+    view[0] = 'I';
+    cout << "Expected: I I" << endl;
+    cout << arr(2, 0) << " " << arr.data()[8] << endl;
+
+    const segmented_array<char>& const_arr = arr;
+    segment_view<const char> const_view = const_arr.segment(6);
+    cout << "Expected: yz" << endl;
+    cout << const_view.to_string() << endl;
+}
+
+
+
+/**
+ * Tests iterating over every segment with a range-based for loop
+ */
+void test_segment_range() {
+    using namespace std;
+    using namespace utils;
+
+    segmented_array<char> arr = segmented_array<char>("abcdefghij", 3);
+    cout << "Expected: abc|def|ghi|j|" << endl;
+    for(segment_view<const char> view : static_cast<const segmented_array<char>&>(arr).segments()) {
+        cout << view.to_string() << "|";
+    }
+    cout << endl;
+
+    //Without a remainder
+    chunked_segmented_array<char> chunked = chunked_segmented_array<char>("abcdefghi", 3, 2);
+    cout << "Expected: 3 segments: ABC|DEF|GHI|" << endl;
+    cout << chunked.segments().size() << " segments: ";
+    for(segment_view<char> view : chunked.segments()) {
+        for(char& c : view) {
+            c = (char)(c - 'a' + 'A');
+        }
+        cout << view.to_string() << "|";
+    }
+    cout << endl;
+
+    segmented_array<char> empty = segmented_array<char>("", 3);
+    cout << "Expected: 0 0" << endl;
+    cout << empty.segments().size() << " " << empty.remainder().size() << endl;
+}
+
+
+
+int main() {
+    test_segment_views();
+    test_segment_range();
+    return 0;
+}
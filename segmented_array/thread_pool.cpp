@@ -0,0 +1,224 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+
+
+
+
+/**
+ * A fixed set of worker threads that run numbered tasks in parallel.
+ *
+ * `run` hands out task numbers 0, 1, 2... to the workers and the calling thread, and returns once every task has finished.
+ * Tasks are claimed one at a time, so faster threads take more tasks.
+ * Only one `run` happens at a time. Calls from other threads wait for the current one to finish.
+ *
+ * A pool of 1 thread has no workers, and runs every task on the calling thread.
+ */
+class thread_pool {
+private:
+    /**
+     * Worker threads. The thread calling `run` also runs tasks, so there is one fewer worker than the pool's size.
+     */
+    std::vector<std::thread> workers;
+
+    /**
+     * Guards every member below, except `next_task`.
+     */
+    std::mutex state_mutex;
+
+    /**
+     * Signalled when a new job starts, or when the pool is destroyed
+     */
+    std::condition_variable job_started;
+
+    /**
+     * Signalled when the final busy worker finishes its part of a job
+     */
+    std::condition_variable job_finished;
+
+    /**
+     * Held for the whole of `run`, so jobs do not overlap
+     */
+    std::mutex run_mutex;
+
+    /**
+     * Task of the current job, or `nullptr` between jobs
+     */
+    const std::function<void(int64_t)>* task;
+
+    /**
+     * Number of tasks in the current job
+     */
+    int64_t n_tasks;
+
+    /**
+     * Next unclaimed task number. May pass `n_tasks` once every task is claimed.
+     */
+    std::atomic<int64_t> next_task;
+
+    /**
+     * Number of workers still working on the current job
+     */
+    int32_t n_busy_workers;
+
+    /**
+     * Number of jobs started so far. Workers compare it to the last job they saw to notice a new one.
+     */
+    uint64_t n_jobs;
+
+    /**
+     * Whether the pool is being destroyed
+     */
+    bool stopping;
+
+    /**
+     * First exception thrown by a task of the current job, or empty
+     */
+    std::exception_ptr first_error;
+
+
+    /**
+     * Claims and runs tasks of the current job until none are left.
+     * After a task throws, the remaining tasks are skipped.
+     *
+     * Private helper method.
+     */
+    void _run_tasks() {
+        for(int64_t i = next_task++; i < n_tasks; i = next_task++) {
+            try {
+                (*task)(i);
+            }
+            catch(...) {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                if(!first_error) {
+                    first_error = std::current_exception();
+                }
+                next_task = n_tasks;
+            }
+        }
+    }
+
+
+
+    /**
+     * Loop run by each worker: waits for a job, helps finish it, and repeats until the pool is destroyed.
+     *
+     * Private helper method.
+     */
+    void _work() {
+        uint64_t n_jobs_seen = 0;
+        std::unique_lock<std::mutex> lock(state_mutex);
+        while(true) {
+            job_started.wait(lock, [this, n_jobs_seen]() { return stopping || n_jobs != n_jobs_seen; });
+            if(stopping) {
+                return;
+            }
+            n_jobs_seen = n_jobs;
+
+            lock.unlock();
+            _run_tasks();
+            lock.lock();
+
+            n_busy_workers--;
+            if(n_busy_workers == 0) {
+                job_finished.notify_one();
+            }
+        }
+    }
+
+public:
+
+    /**
+     * Creates a pool that runs tasks on `n_threads` threads, counting the thread that calls `run`.
+     *
+     * @param n_threads number of threads to run tasks on. Values below 1 are treated as 1. Default: the number of hardware threads
+     */
+    explicit thread_pool(int32_t n_threads = (int32_t)std::thread::hardware_concurrency())
+        : task(nullptr), n_tasks(0), next_task(0), n_busy_workers(0), n_jobs(0), stopping(false) {
+        for(int32_t i = 1; i < n_threads; i++) {
+            workers.push_back(std::thread(&thread_pool::_work, this));
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+
+    /**
+     * @return number of threads that run tasks, counting the thread that calls `run`
+     */
+    int32_t size() const noexcept {
+        return (int32_t)workers.size() + 1;
+    }
+
+
+
+    /**
+     * Runs `job(0)`, `job(1)`... `job(n_job_tasks - 1)` across the pool, and returns when all of them have finished.
+     * The calling thread runs tasks too. Tasks may run in any order, and must not call `run` on the same pool.
+     *
+     * @param n_job_tasks number of tasks to run. Must be non-negative
+     * @param job function to call with each task number
+     * @throws the first exception thrown by a task, after the other running tasks finish. Tasks not yet started are skipped
+     */
+    void run(int64_t n_job_tasks, const std::function<void(int64_t)>& job) {
+        std::lock_guard<std::mutex> run_lock(run_mutex);
+
+        //Start the job
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            task = &job;
+            n_tasks = n_job_tasks;
+            next_task = 0;
+            n_busy_workers = (int32_t)workers.size();
+            first_error = nullptr;
+            n_jobs++;
+        }
+        job_started.notify_all();
+
+        _run_tasks();
+
+        //Wait for the workers, then forget the job
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(state_mutex);
+            job_finished.wait(lock, [this]() { return n_busy_workers == 0; });
+            task = nullptr;
+            error = first_error;
+            first_error = nullptr;
+        }
+        if(error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+
+
+    /**
+     * Stops and joins every worker. Must not be called during `run`.
+     */
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            stopping = true;
+        }
+        job_started.notify_all();
+        for(size_t i = 0; i < workers.size(); i++) {
+            workers[i].join();
+        }
+    }
+};
+
+
+
+
+}